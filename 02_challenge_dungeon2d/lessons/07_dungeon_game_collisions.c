@@ -23,6 +23,14 @@
 *       gcc -o $(NAME_PART).exe $(FILE_NAME) -Iexternal -Iexternal/glfw/include \
 *           rglfw.o -lopengl32 -lgdi32 -Wall -std=c99
 *
+*   Compile example with rlgl software rasterizer (no OpenGL, window only used for inputs,
+*   last frame is saved as screenshot.ppm on exit, F12 saves it anytime):
+*       gcc -o $(NAME_PART) $(FILE_NAME) -Iexternal -Iexternal/glfw/include \
+*           rglfw.o -DGRAPHICS_API_SOFTWARE -lpthread -lm -Wall -std=c99
+*
+*   F11 toggles frames recording into recording.rgba (raw frames), convert it using:
+*       ffmpeg -f rawvideo -pixel_format rgba -video_size 800x450 -framerate 60 -i recording.rgba recording.mp4
+*
 *   Copyright (c) 2017-2019 Ramon Santamaria (@raysan5)
 *
 ********************************************************************************************/
@@ -36,6 +44,19 @@
 #include <stdio.h>              // Standard input-output C library
 #include <stdlib.h>             // Memory management functions: malloc(), free()
 #include <string.h>             // String manipulation functions: strrchr(), strcmp()
+#include <math.h>               // Math related functions: sqrtf(), floorf(), ceilf(), sinf(), cosf()
+#include <limits.h>             // Integer types limits: INT_MAX
+
+#if !defined(_WIN32)
+    #include <sys/mman.h>       // Memory-mapped files: mmap(), munmap()
+    #include <sys/stat.h>       // File information: fstat()
+    #include <fcntl.h>          // File descriptors: open()
+    #include <unistd.h>         // File descriptors: close()
+#endif
+
+#if defined(COMMAND_BUFFERS_BENCHMARK)
+    #include <pthread.h>        // POSIX threads: pthread_create(), pthread_join()
+#endif
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -51,10 +72,43 @@ typedef struct Image {
 // LESSON 06: Tile struct
 typedef struct Tile {
     int value;                  // Tile index value (in tileset)
+    int object;                 // Tile object index value (in tileset, -1 -> no object)
+    int overlay;                // Tile overlay index value (in tileset, -1 -> no overlay), drawn over entities
     bool collider;              // Tile collider (0 -> walkable)
     Color color;                // Tile color (could be useful)
 } Tile;
 
+// Tilemap layers, in drawing order
+// NOTE: Ground and objects are drawn under entities, overlay is drawn over entities
+typedef enum {
+    TILEMAP_LAYER_GROUND = 0,   // Tile value layer (floor, walls)
+    TILEMAP_LAYER_OBJECTS,      // Tile object layer
+    TILEMAP_LAYER_OVERLAY       // Tile overlay layer (trees tops, walls tops)
+} TilemapLayer;
+
+// Tile animation frames limit
+#define MAX_TILE_ANIMATION_FRAMES   8
+
+// Tile animation struct
+// NOTE: Animation frames are tileset tile ids, animated tile id is usually the first frame
+typedef struct TileAnimation {
+    int frames[MAX_TILE_ANIMATION_FRAMES];  // Frames tile ids
+    int frameCount;             // Frames counter (0 -> tile not animated)
+    float frameTime;            // Frame duration (seconds)
+} TileAnimation;
+
+// Tileset struct
+// NOTE: Tiles rectangles are derived from tiles ids layout over tileset image grid,
+// texture coordinates are precomputed on loading, tiles drawing requires no divisions
+typedef struct Tileset {
+    Texture2D texture;          // Tileset texture (atlas)
+    int tileCount;              // Tiles counter (ids from 1 to tileCount)
+    Rectangle *recs;            // Tiles rectangles in texture (pixels), by id - 1
+    float *texcoords;           // Tiles texture coordinates: left, top, right, bottom (4 per tile)
+    int *colliders;             // Tiles collider codes (collision shape), by id - 1
+    TileAnimation *animations;  // Tiles animations, by id - 1
+} Tileset;
+
 // LESSON 06: Tilemap struct
 typedef struct Tilemap {
     Tile *tiles;                // Tiles data
@@ -64,6 +118,127 @@ typedef struct Tilemap {
     Vector2 position;           // Tilemap position in screen
 } Tilemap;
 
+// Tilemap binary file header (16 bytes)
+// NOTE: Header fields are stored in little-endian byte order, header is followed by
+// tile values (unsigned short, little-endian) and by colliders data (1 bit per tile, 1 -> walkable)
+typedef struct TilemapFileHeader {
+    char id[4];                 // File identifier: "TMB "
+    unsigned short version;     // File version
+    unsigned short tileSize;    // Tile size (XY)
+    int tileCountX;             // Tiles counter X
+    int tileCountY;             // Tiles counter Y
+} TilemapFileHeader;
+
+// Tilemap render cache struct
+// NOTE: Tiles quads are built once into static vertex buffers, map is split into
+// chunks of tiles (one mesh per chunk), every chunk is drawn with a single draw call,
+// all tilemap layers included (only non-empty tiles get a quad).
+// Only chunks around the visible area are kept loaded, big maps do not fill VRAM
+typedef struct TilemapCache {
+    Mesh *chunks;               // Chunks meshes (tiles quads vertex data, RAM and VRAM)
+    bool *dirty;                // Chunks pending to be updated in VRAM (tiles modified)
+    int *loaded;                // Loaded chunks indices (chunks with vertex data)
+    int loadedCount;            // Loaded chunks counter
+    int chunkCountX;            // Chunks counter X
+    int chunkCountY;            // Chunks counter Y
+    Tileset tileset;            // Tileset used by chunks tiles (texcoords)
+    Material material;          // Material used to draw chunks (tilemap shader + tileset texture)
+    float *tileOffsets;         // Tiles texcoords offsets (animations current frame), by id (two ids per vec4)
+    int tileOffsetsLoc;         // Tiles texcoords offsets shader location
+    int **quadTiles;            // Chunks quads tile index (tilemap tile of every quad), used for visibility
+    int *visibility;            // Chunks indices visibility version (-1 -> not filtered, all quads drawn)
+} TilemapCache;
+
+// Sprite batch struct
+// NOTE: Sprites sharing a texture are written as pre-transformed quads directly into
+// rlgl quads buffer, no matrix stack usage and no divisions per sprite
+typedef struct SpriteBatch {
+    Texture2D texture;          // Sprites texture
+    float texelWidth;           // Texel width in texture coordinates (1/width)
+    float texelHeight;          // Texel height in texture coordinates (1/height)
+} SpriteBatch;
+
+// Camera 2D struct
+// NOTE: Camera transform: world target is placed at screen offset, scaled by zoom
+typedef struct Camera2D {
+    Vector2 offset;             // Camera offset (screen position where target is placed)
+    Vector2 target;             // Camera target (world position the camera looks at)
+    float zoom;                 // Camera zoom (scaling), 1.0f by default
+} Camera2D;
+
+// Flow field struct
+// NOTE: Integration field stores the distance (in tiles) from every tile to the target tile,
+// direction field stores the neighbour tile to move to for getting closer to the target
+typedef struct FlowField {
+    int *distance;              // Integration field: steps to reach target (-1 -> unreachable)
+    char *direction;            // Direction field: neighbour index to move to (-1 -> no direction)
+    int *queue;                 // Tiles queue used on field computation (BFS)
+    int tileCountX;             // Tiles counter X
+    int tileCountY;             // Tiles counter Y
+    int targetX;                // Target tile X (-1 -> no target)
+    int targetY;                // Target tile Y (-1 -> no target)
+} FlowField;
+
+// Field of view struct
+// NOTE: Visible tiles are stored in a bitset (1 bit per tile), computed with symmetric shadowcasting,
+// version is incremented on every computation to let the renderer know visibility changed
+typedef struct FieldOfView {
+    unsigned int *visible;      // Visible tiles bitset (1 -> visible)
+    int tileCountX;             // Tiles counter X
+    int tileCountY;             // Tiles counter Y
+    int originX;                // Origin tile X (-1 -> not computed)
+    int originY;                // Origin tile Y (-1 -> not computed)
+    int radius;                 // View radius (tiles)
+    int version;                // Visibility version (computations counter)
+} FieldOfView;
+
+// Entity flags
+typedef enum {
+    ENTITY_ACTIVE   = 1,        // Entity id in use
+    ENTITY_PLAYER   = 2,        // Player (moved by input, drawn with its own texture)
+    ENTITY_MONSTER  = 4,        // Monster (follows flow field)
+    ENTITY_ITEM     = 8,        // Pickable item (keys, potions...)
+    ENTITY_TILE     = 16        // Tilemap object (drawn and collided by tilemap objects layer)
+} EntityFlags;
+
+// Entities struct (structure of arrays)
+// NOTE: Every component is stored in its own array indexed by entity id, update systems
+// only iterate the components they need. Destroyed ids are reused (free ids stack),
+// entities are never allocated one by one
+typedef struct Entities {
+    float *positionX;           // Entities position X (AABB top-left corner)
+    float *positionY;           // Entities position Y (AABB top-left corner)
+    float *velocityX;           // Entities velocity X (pixels per frame)
+    float *velocityY;           // Entities velocity Y (pixels per frame)
+    float *width;               // Entities AABB width
+    float *height;              // Entities AABB height
+    float *speed;               // Entities max speed (pixels per frame)
+    int *sprite;                // Entities sprite (tileset tile id, -1 -> tinted box)
+    Color *color;               // Entities sprite tint color
+    unsigned int *flags;        // Entities flags (EntityFlags)
+    int *freeIds;               // Free ids stack (destroyed entities)
+    int freeCount;              // Free ids counter
+    int count;                  // Used ids range (ids from 0 to count - 1)
+    int capacity;               // Max entities
+} Entities;
+
+// Spatial hash struct
+// NOTE: Entities are stored in the cell (tile) containing their AABB center, every cell is hashed
+// into a bucket, buckets are doubly-linked lists of entities ids (no allocations on moves)
+typedef struct SpatialHash {
+    int *buckets;               // Buckets first entity id (-1 -> empty bucket)
+    int *next;                  // Entities next id in bucket (-1 -> last)
+    int *prev;                  // Entities previous id in bucket (-1 -> first)
+    int *bucket;                // Entities current bucket (-1 -> not inserted)
+    int *cellX;                 // Entities current cell X
+    int *cellY;                 // Entities current cell Y
+    int bucketCount;            // Buckets counter (power of two)
+    int capacity;               // Max entities
+    float cellSize;             // Cell size (tile size)
+    Vector2 origin;             // Cells origin (tilemap position)
+    float maxExtent;            // Max entity half size inserted (queries range expansion)
+} SpatialHash;
+
 #define WHITE   (Color){ 255, 255, 255, 255 }       // White color definition
 
 //----------------------------------------------------------------------------------
@@ -78,38 +253,101 @@ static double currentTime, previousTime;    // Used to track timmings
 static double frameTime = 0.0;              // Time measure for one frame
 static double targetTime = 0.0;             // Desired time for one frame, if 0 not applied
 
+// Frames recording file (raw RGBA frames, top-down rows), NULL if not recording
+static FILE *recordingFile = NULL;
+
 // LESSON 03: Keyboard input management
 // Register keyboard states (current and previous)
 static char previousKeyState[512] = { 0 };  // Registers previous frame key state
 static char currentKeyState[512] = { 0 };   // Registers current frame key state
 
 // LESSON 06: Tilemap data loading and drawing
-#define TILESET_TILES  32
-
-// NOTE: Tileset rectangles are directly provided in this array but
-// they can also be loaded from a file... usually generated with
-// a tilemap editor software
-static Rectangle tilesetRecs[TILESET_TILES] = {
-    { 0, 0, 32, 32 }, { 32, 0, 32, 32 },        // 1, 2
-    { 64, 0, 32, 32 }, { 0, 32, 32, 32 },       // 3, 4
-    { 32, 32, 32, 32 }, { 64, 32, 32, 32 },     // 5, 6
-    { 0, 64, 32, 32 }, { 32, 64, 32, 32 },      // 7, 8
-    { 64, 64, 32, 32 }, { 96, 0, 32, 32 },      // 9, 10
-    { 128, 0, 32, 32 }, { 96, 32, 32, 32 },     // 11, 12
-    { 128, 32, 32, 32 }, { 96, 64, 32, 32 },    // 13, 14
-    { 128, 64, 32, 32 }, { 128, 96, 32, 32 },   // 15, 16
-    { 0, 96, 32, 32 }, { 32, 96, 32, 32 },      // 17, 18
-    { 64, 96, 32, 32 }, { 96, 96, 32, 32 },     // 19, 20
-    { 160, 96, 32, 32 }, { 160, 0, 32, 32 },    // 21, 22
-    { 160, 32, 32, 32 }, { 160, 64, 32, 32 },   // 23, 24
-    { 192, 0, 32, 32 }, { 224, 0, 32, 32 },     // 25, 26
-    { 192, 32, 32, 32 }, { 224, 32, 32, 32 },   // 27, 28
-    { 192, 64, 32, 32 }, { 224, 64, 32, 32 },   // 29, 30
-    { 192, 96, 32, 32 }, { 224, 96, 32, 32 }    // 31, 32
-};
+// Tilemap binary file format
+#define TILEMAP_FILE_VERSION        100     // Tilemap binary file version
+#define TILEMAP_FILE_HEADER_SIZE     16     // Tilemap binary file header size (bytes)
+#define TILEMAP_EMPTY_VALUE      0xffff     // Tile value stored for empty tiles (value < 0)
+
+// Tilemap text files limits: tiles per line and lines (values allocation is limited to 64 MB)
+#define TILEMAP_TEXT_MAX_SIZE      4096
+
+// Tilemap render cache: tiles per chunk side
+// NOTE: Chunk vertex count (32*32*4 per layer) must fit in 16bit indices
+#define TILEMAP_CHUNK_SIZE          32
+#define TILEMAP_LAYERS               3      // Tilemap layers: ground, objects, overlay
+
+// Tiles animations: tile ids supported by tilemap shader (tile id 0 is never animated)
+// NOTE: Offsets of two ids are packed per vec4, value must match tilemap shader tileOffsets[] array size*2
+#define MAX_ANIMATED_TILE_IDS      256
+
+// Tiles animations sample, chest tile opens and closes (sample tileset has no animated tiles): -DTILE_ANIMATION_SAMPLE
+//#define TILE_ANIMATION_SAMPLE
 
 // LESSON 07: Collision detection
-#define PLAYER_COLLISION_PADDING    12      // Player padding to detect collision with walls
+// Tile collision shapes, by collider code (tileset_colliders.txt)
+// NOTE: Shapes are defined for 32x32 tiles, scaled to tilemap tile size, code 1 is walkable (no shape)
+#define TILE_SHAPES     6
+#define TILE_SHAPE_SIZE 32
+
+static Rectangle tileShapes[TILE_SHAPES] = {
+    { 0, 0, 32, 32 },       // 0: Solid (full tile)
+    { 0, 0, 0, 0 },         // 1: Walkable
+    { 0, 0, 32, 16 },       // 2: Solid top half
+    { 0, 16, 32, 16 },      // 3: Solid bottom half
+    { 0, 0, 16, 32 },       // 4: Solid left half
+    { 16, 0, 16, 32 }       // 5: Solid right half
+};
+
+// Entities storage: max number of entities (player, monsters, items), configurable: -DMAX_ENTITIES=131072
+#if !defined(MAX_ENTITIES)
+    #define MAX_ENTITIES          8192
+#endif
+
+// Monsters navigation using a flow field
+#define MAX_MONSTERS                64      // Number of monsters chasing the player
+
+// Field of view: player view radius (tiles)
+#define FIELD_OF_VIEW_RADIUS         8
+
+// Spatial hash buckets (power of two)
+#define SPATIAL_HASH_BUCKETS      4096
+
+// Items pickup range from player center (pixels)
+#define ITEM_PICKUP_RANGE          8.0f
+
+// Tilemap binary file export at init (text tilemap to resources/tilemap.tmb): -DEXPORT_TILEMAP_BINARY
+//#define EXPORT_TILEMAP_BINARY
+
+// Entities update systems benchmark (100000 monsters, 1 ms budget), logged at init: -DENTITIES_BENCHMARK
+// NOTE: Average frame time over budget is reported as error (program exits with code 1)
+//#define ENTITIES_BENCHMARK
+
+// Spatial hash queries benchmark, logged at init: -DSPATIAL_HASH_BENCHMARK
+//#define SPATIAL_HASH_BENCHMARK
+
+// Textured quads recording benchmark, logged at init: -DQUADS_TRANSFORM_BENCHMARK
+// NOTE: Compare rlgl vertex transformation with and without SIMD building also with -DRLGL_NO_SIMD
+//#define QUADS_TRANSFORM_BENCHMARK
+
+// Interleaved textures sprites drawing benchmark, logged at init: -DDRAW_SORT_BENCHMARK
+// NOTE: Compares rlgl draw calls sorting modes (deferred submission), see rlSetDrawSortMode()
+//#define DRAW_SORT_BENCHMARK
+
+// Rendering statistics (flushes, draw calls, uploads), logged every 60 frames: -DRENDER_STATS
+// NOTE: Statistics are per frame, use them to check batching regressions, see rlGetRenderStats()
+//#define RENDER_STATS
+
+// Sprites recording on worker threads benchmark, logged at init: -DCOMMAND_BUFFERS_BENCHMARK
+// NOTE: Uses rlgl command buffers (one by thread) and POSIX threads (link with -lpthread)
+//#define COMMAND_BUFFERS_BENCHMARK
+
+// OpenGL calls capture into dungeon.gltrace (OpenGL 3.3 only): -DRLGL_CAPTURE
+// NOTE: Trace is replayed offline for benchmarking with 03_challenge_maze3d/tools/glreplay
+#define CAPTURE_FRAMES             300      // Frames to capture (resources loading included on first frame)
+
+// Flow field neighbour directions: right, down, left, up
+// NOTE: Opposite direction of n is (n + 2)%4
+static const int flowDirX[4] = { 1, 0, -1, 0 };
+static const int flowDirY[4] = { 0, 1, 0, -1 };
 
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
@@ -125,6 +363,8 @@ static void InitGraphicsDevice(int width, int height);  // Initialize graphic de
 static void CloseWindow(void);                          // Close window and free resources
 static void SetTargetFPS(int fps);                      // Set target FPS (maximum)
 static void SyncFrame(void);                            // Synchronize to desired framerate
+static void TakeScreenshot(const char *fileName, int width, int height);    // Save current framebuffer as PPM image
+static void RecordFrame(const unsigned char *pixels, int width, int height, int stride, void *userData);  // Append frame pixels to recording file (readback callback)
 
 // LESSON 03: Inputs management (keyboard and mouse)
 //----------------------------------------------------------------------------------
@@ -149,18 +389,96 @@ static Image LoadBMP(const char *fileName);         // Load BMP image file data
 
 static void DrawTexture(Texture2D texture, int posX, int posY, Color tint);   // Draw texture in screen position coordinates
 static void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint);    // Draw a Texture2D with extended parameters
-static void DrawTextureRec(Texture2D texture, Rectangle sourceRec, Vector2 position, Color tint);           // Draw a part of a texture (defined by a rectangle)
 static void DrawTexturePro(Texture2D texture, Rectangle sourceRec, Rectangle destRec, Vector2 origin, float rotation, Color tint); // Draw a part of a texture (defined by a rectangle) with 'pro' parameters
 
+// Sprites batching
+//----------------------------------------------------------------------------------
+static SpriteBatch BeginSpriteBatch(Texture2D texture);   // Begin sprites batch (all sprites use same texture)
+static void DrawSprite(SpriteBatch batch, Rectangle sourceRec, Rectangle destRec, Vector2 origin, float rotation, Color tint);  // Draw sprite into batch (pre-transformed quad)
+static void EndSpriteBatch(void);                         // End sprites batch
+#if defined(QUADS_TRANSFORM_BENCHMARK)
+static void BenchmarkQuadsTransform(Texture2D texture);   // Log textured quads recording time (matrix stack vs sprites batch)
+#endif
+#if defined(DRAW_SORT_BENCHMARK)
+static void BenchmarkDrawSort(Texture2D texture);         // Log interleaved textures sprites drawing time (draw calls sorting modes)
+#endif
+#if defined(COMMAND_BUFFERS_BENCHMARK)
+static void BenchmarkCommandBuffers(Texture2D texture);   // Log sprites recording time (GL thread vs worker threads command buffers)
+#endif
+
 // LESSON 06: Tilemap data loading and drawing
 //----------------------------------------------------------------------------------
 static Tilemap LoadTilemap(const char *valuesMap, const char *collidersMap);// Load tilemap data from file
+static Tilemap LoadTilemapBinary(const char *fileName);   // Load tilemap data from binary file (single read)
+#if defined(EXPORT_TILEMAP_BINARY)
+static void ExportTilemapBinary(Tilemap map, const char *fileName);    // Export tilemap data to binary file
+#endif
+static void LoadTilemapLayer(Tilemap map, const char *fileName, int layer);   // Load tilemap layer values from text file
 static void UnloadTilemap(Tilemap map);                   // Unload tilemap data
-static void DrawTilemap(Tilemap map, Texture2D tileset);  // Draw tilemap using tileset
+static Tileset LoadTileset(const char *fileName, const char *idsMap);  // Load tileset texture and tiles layout (ids grid)
+static void UnloadTileset(Tileset tileset);               // Unload tileset data (RAM and VRAM)
+#if defined(TILE_ANIMATION_SAMPLE)
+static void SetTileAnimation(Tileset tileset, int id, const int *frames, int frameCount, float frameTime);  // Set tile animation (frames ids and duration)
+#endif
+static TilemapCache LoadTilemapCache(Tilemap map, Tileset tileset);    // Load tilemap render cache (static tiles quads)
+static void UnloadTilemapCache(TilemapCache cache);                     // Unload tilemap render cache
+static void SetTilemapTile(Tilemap map, TilemapCache cache, int x, int y, int layer, int value);  // Set tile layer value and mark its chunk for rebuild
+static void DrawTilemap(Tilemap map, TilemapCache *cache, Rectangle view, const FieldOfView *fov);  // Draw tilemap area visible in view (one draw call per chunk, all layers)
+static void UpdateTilemapAnimations(TilemapCache cache, float time);  // Update tiles animations current frame (shader offsets, texcoords only without shader)
+static void UpdateTilemapAnimatedTexcoords(TilemapCache cache);        // Update loaded chunks animated tiles texcoords (no tilemap shader)
+
+// 2D camera: scrolling and zoom
+//----------------------------------------------------------------------------------
+static void BeginMode2D(Camera2D camera);           // Begin 2D mode with camera transform
+static void EndMode2D(void);                        // End 2D mode, reset transform
+static Rectangle GetCameraViewRec(Camera2D camera, int width, int height);  // Get world area visible through camera
 
 // LESSON 07: Collision detection
 //----------------------------------------------------------------------------------
-static bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2); // Check collision between two rectangles
+static void LoadTilesetColliders(Tileset tileset, const char *fileName);   // Load tileset colliders (collision shape code per tile)
+static int GetTileShapes(Tilemap map, Tileset tileset, int tileX, int tileY, Rectangle *shapes);   // Get collision shapes of a tile
+static Rectangle MoveTilemapCollider(Tilemap map, Tileset tileset, Rectangle box, int dx, int dy); // Move box through tilemap resolving collisions
+
+// Monsters navigation (flow field)
+//----------------------------------------------------------------------------------
+static FlowField LoadFlowField(Tilemap map);                // Load flow field data for a tilemap (no target)
+static void UnloadFlowField(FlowField field);               // Unload flow field data
+static void UpdateFlowField(FlowField *field, Tilemap map, int targetX, int targetY);   // Update flow field to reach target tile (only if target changed)
+static Vector2 GetFlowFieldDirection(FlowField field, int tileX, int tileY);            // Get direction to follow from a tile (O(1))
+
+// Field of view (symmetric shadowcasting)
+//----------------------------------------------------------------------------------
+static FieldOfView LoadFieldOfView(Tilemap map, int radius);  // Load field of view data for a tilemap (nothing visible)
+static void UnloadFieldOfView(FieldOfView fov);             // Unload field of view data
+static void UpdateFieldOfView(FieldOfView *fov, Tilemap map, int originX, int originY);  // Update visible tiles from origin tile (only if origin changed)
+static bool IsTileVisible(FieldOfView fov, int tileX, int tileY);                       // Check if a tile is visible (O(1))
+
+// Entities (structure of arrays)
+//----------------------------------------------------------------------------------
+static Entities LoadEntities(int capacity);                 // Load entities storage (components arrays)
+static void UnloadEntities(Entities entities);              // Unload entities storage
+static int CreateEntity(Entities *entities, unsigned int flags, Rectangle box);     // Create entity, returns id (-1 if storage is full)
+static void DestroyEntity(Entities *entities, int id);      // Destroy entity, id is reused by next created entity
+static Rectangle GetEntityRec(Entities entities, int id);   // Get entity AABB
+static void LoadTilemapEntities(Entities *entities, Tilemap map);    // Create entities for tilemap objects layer tiles
+static int SpawnMonster(Entities *entities, Tilemap map);   // Create monster entity at a random walkable tile
+static void UpdateEntitiesMovement(Entities entities);      // Update entities position from velocity
+static void UpdateMonstersVelocity(Entities entities, FlowField field, Tilemap map);    // Update monsters velocity following flow field
+#if defined(ENTITIES_BENCHMARK)
+static void BenchmarkEntities(FlowField *field, Tilemap map, int entitiesCount);        // Log entities update systems time per frame
+#endif
+static void DrawEntities(Entities entities, Tilemap map, Tileset tileset, FieldOfView fov);     // Draw entities in field of view (sprites batches)
+
+// Entities spatial hash (uniform grid, tile cells)
+//----------------------------------------------------------------------------------
+static SpatialHash LoadSpatialHash(int capacity, float cellSize, Vector2 origin, int bucketCount);  // Load spatial hash for entities (empty)
+static void UnloadSpatialHash(SpatialHash hash);            // Unload spatial hash data
+static void UpdateSpatialHash(SpatialHash *hash, Entities entities);    // Update entities cells (only moved entities change bucket)
+static int QuerySpatialHashRec(SpatialHash hash, Entities entities, Rectangle rec, int *results, int maxResults);                   // Get entities overlapping rectangle, returns results counter
+static int QuerySpatialHashRange(SpatialHash hash, Entities entities, Vector2 center, float radius, int *results, int maxResults);  // Get entities in range, returns results counter
+#if defined(SPATIAL_HASH_BENCHMARK)
+static void BenchmarkSpatialHash(int entitiesCount);        // Log spatial hash update and queries throughput
+#endif
 
 //----------------------------------------------------------------------------------
 // Main Entry point
@@ -183,25 +501,96 @@ int main(void)
     UnloadImage(imPlayer);
     
     // LESSON 06: Load tilemap data: tile values (tileset index) and tile colliders
+    // NOTE: Binary tilemap files contain values and colliders: LoadTilemap("resources/tilemap.tmb", NULL)
+    // and image tilemap files contain values, objects and colliders: LoadTilemap("resources/tilemap_layers.bmp", NULL)
     Tilemap tilemap = LoadTilemap("resources/tilemap.txt", "resources/tilemap_colliders.txt");
     
+    // Load tilemap objects layer (drawn over tiles values, same tileset)
+    LoadTilemapLayer(tilemap, "resources/tilemap_objects.txt", TILEMAP_LAYER_OBJECTS);
+    
     tilemap.tileSize = 32;
     tilemap.position = (Vector2){ screenWidth/2 - tilemap.tileCountX*tilemap.tileSize/2, 
                                   screenHeight/2 - tilemap.tileCountY*tilemap.tileSize/2 };
+    
+#if defined(EXPORT_TILEMAP_BINARY)
+    ExportTilemapBinary(tilemap, "resources/tilemap.tmb");
+#endif
 
-    // Load tileset texture
-    Image imTileset = LoadImage("resources/tileset.bmp");
-    Texture2D texTileset = LoadTextureFromImage(imTileset);
-    UnloadImage(imTileset);
+    // Load tileset texture and tiles layout: tiles rectangles and texcoords by id
+    Tileset tileset = LoadTileset("resources/tileset.bmp", "resources/tileset_ids.txt");
+    
+    // Load tileset colliders: collision shape for every tileset tile
+    LoadTilesetColliders(tileset, "resources/tileset_colliders.txt");
+    
+    // Tiles animations: frames (tile ids) and frame duration by tile id
+    // NOTE: Sample tileset has no animated tiles, i.e. a four frames water tile would be:
+    // SetTileAnimation(tileset, 33, (int[]){ 33, 34, 35, 36 }, 4, 0.25f);
+#if defined(TILE_ANIMATION_SAMPLE)
+    SetTileAnimation(tileset, 27, (int[]){ 27, 28 }, 2, 0.5f);    // Chest: closed, open
+#endif
+    
+    // Load tilemap render cache: tiles quads are built once and drawn with a single call
+    TilemapCache tilemapCache = LoadTilemapCache(tilemap, tileset);
+    
+    // Init entities storage: player, monsters and items
+    Entities entities = LoadEntities(MAX_ENTITIES);
+    
+    // Init player entity
+    // NOTE: Player AABB is the collision box, placed at player sprite feet (16x16 sprite)
+    int player = CreateEntity(&entities, ENTITY_PLAYER, (Rectangle){ tilemap.position.x + 1*tilemap.tileSize + 12, tilemap.position.y + 1*tilemap.tileSize + 16, 8, 8 });
+    
+    // Init items entities from tilemap objects (tiles keep drawing and colliding them)
+    LoadTilemapEntities(&entities, tilemap);
+    
+    // Init camera, following player
+    Camera2D camera = { 0 };
+    camera.offset = (Vector2){ screenWidth/2, screenHeight/2 };
+    camera.target = (Vector2){ entities.positionX[player] + entities.width[player]/2, entities.positionY[player] + entities.height[player]/2 };
+    camera.zoom = 1.0f;
     
-    // TODO: Load tileset index rectangles
-    // TODO: Load tileset colliders
+    // Init flow field used by monsters to reach the player
+    FlowField flowField = LoadFlowField(tilemap);
     
-    // Init player position
-    Rectangle player = { tilemap.position.x + 1*tilemap.tileSize + 8, tilemap.position.y + 1*tilemap.tileSize + 8, 8, 8 };
-    Rectangle oldPlayer = player;
+    // Init player field of view: only visible tiles and monsters are drawn
+    FieldOfView fov = LoadFieldOfView(tilemap, FIELD_OF_VIEW_RADIUS);
+    
+    // Init monsters entities at random walkable tiles (8x8 tinted boxes)
+    for (int i = 0; i < MAX_MONSTERS; i++) SpawnMonster(&entities, tilemap);
+    
+    // Init entities spatial hash (tile cells), used for entities overlap queries
+    SpatialHash spatialHash = LoadSpatialHash(MAX_ENTITIES, tilemap.tileSize, tilemap.position, SPATIAL_HASH_BUCKETS);
+    int *hits = (int *)calloc(MAX_ENTITIES, sizeof(int));     // Spatial hash queries results
+    
+    // Init entities drawing command buffer: entities vertex data is recorded without accessing GL state
+    // NOTE: Command buffers are not supported on OpenGL 1.1 (NULL), entities are drawn directly
+    CommandBuffer *entitiesCommands = rlLoadCommandBuffer();
+    
+#if defined(ENTITIES_BENCHMARK)
+    BenchmarkEntities(&flowField, tilemap, 100000);
+#endif
+
+#if defined(SPATIAL_HASH_BENCHMARK)
+    BenchmarkSpatialHash(10000);
+    BenchmarkSpatialHash(100000);
+#endif
+
+#if defined(QUADS_TRANSFORM_BENCHMARK)
+    BenchmarkQuadsTransform(tileset.texture);
+#endif
+
+#if defined(DRAW_SORT_BENCHMARK)
+    BenchmarkDrawSort(tileset.texture);
+#endif
+
+#if defined(COMMAND_BUFFERS_BENCHMARK)
+    BenchmarkCommandBuffers(tileset.texture);
+#endif
 
     SetTargetFPS(60);
+    
+#if defined(RENDER_STATS)
+    int framesCounter = 0;
+#endif
     //--------------------------------------------------------------------------------------    
 
     // Main game loop    
@@ -210,42 +599,133 @@ int main(void)
         // Update
         //----------------------------------------------------------------------------------
         // Player movement logic
-        oldPlayer = player;
+        int playerMoveX = 0;
+        int playerMoveY = 0;
         
-        if (IsKeyDown(GLFW_KEY_DOWN)) player.y += 2;
-        else if (IsKeyDown(GLFW_KEY_UP)) player.y -= 2;
+        if (IsKeyDown(GLFW_KEY_DOWN)) playerMoveY = 2;
+        else if (IsKeyDown(GLFW_KEY_UP)) playerMoveY = -2;
         
-        if (IsKeyDown(GLFW_KEY_RIGHT)) player.x += 2;
-        else if (IsKeyDown(GLFW_KEY_LEFT)) player.x -= 2;
+        if (IsKeyDown(GLFW_KEY_RIGHT)) playerMoveX = 2;
+        else if (IsKeyDown(GLFW_KEY_LEFT)) playerMoveX = -2;
         
         // LESSON 7: Collision detection and resolution
-        for (int y = 0; y < tilemap.tileCountY; y++)
+        // NOTE: Only tiles under player movement are checked, X and Y axis are resolved separately
+        Rectangle playerRec = MoveTilemapCollider(tilemap, tileset, GetEntityRec(entities, player), playerMoveX, playerMoveY);
+        
+        entities.positionX[player] = playerRec.x;
+        entities.positionY[player] = playerRec.y;
+        
+        // Monsters navigation: flow field is only recomputed when player changes tile,
+        // every monster just reads the direction stored in its current tile
+        int playerTileX = (int)(playerRec.x + playerRec.width/2 - tilemap.position.x)/tilemap.tileSize;
+        int playerTileY = (int)(playerRec.y + playerRec.height/2 - tilemap.position.y)/tilemap.tileSize;
+        
+        UpdateFlowField(&flowField, tilemap, playerTileX, playerTileY);
+        
+        // Field of view is also only recomputed when player changes tile
+        UpdateFieldOfView(&fov, tilemap, playerTileX, playerTileY);
+        
+        // Entities systems: monsters velocity from flow field, then all entities move
+        UpdateMonstersVelocity(entities, flowField, tilemap);
+        UpdateEntitiesMovement(entities);
+        UpdateSpatialHash(&spatialHash, entities);
+        
+        // Monsters reaching the player are defeated, a new monster is spawned (defeated monster id is reused)
+        // NOTE: Player box is expanded 1 pixel to get touching entities
+        Rectangle touchRec = { playerRec.x - 1, playerRec.y - 1, playerRec.width + 2, playerRec.height + 2 };
+        int hitsCount = QuerySpatialHashRec(spatialHash, entities, touchRec, hits, MAX_ENTITIES);
+        
+        for (int i = 0; i < hitsCount; i++)
         {
-            for (int x = 0; x < tilemap.tileCountX; x++)
+            if (entities.flags[hits[i]] & ENTITY_MONSTER)
             {
-                // TODO: Review player padding for a better collision with walls
-                if ((tilemap.tiles[y*tilemap.tileCountX + x].collider == 0) &&
-                    CheckCollisionRecs((Rectangle){ player.x + PLAYER_COLLISION_PADDING, player.y + PLAYER_COLLISION_PADDING, player.width, player.height }, 
-                                       (Rectangle){ tilemap.position.x + x*tilemap.tileSize + PLAYER_COLLISION_PADDING, tilemap.position.y + y*tilemap.tileSize + PLAYER_COLLISION_PADDING, tilemap.tileSize, tilemap.tileSize }))
-                {
-                    // Reset player position (undo player position update!)
-                    player = oldPlayer;
-                }
+                DestroyEntity(&entities, hits[i]);
+                SpawnMonster(&entities, tilemap);
             }
         }
+        
+        // Items in range of the player are picked up, item object tile is removed (only its chunk is rebuilt)
+        // NOTE: Items tiles are colliders, range covers touching items (player half size is 4 pixels)
+        Vector2 playerCenter = { playerRec.x + playerRec.width/2, playerRec.y + playerRec.height/2 };
+        hitsCount = QuerySpatialHashRange(spatialHash, entities, playerCenter, ITEM_PICKUP_RANGE, hits, MAX_ENTITIES);
+        
+        for (int i = 0; i < hitsCount; i++)
+        {
+            if (entities.flags[hits[i]] & ENTITY_ITEM)
+            {
+                int itemTileX = (int)(entities.positionX[hits[i]] - tilemap.position.x)/tilemap.tileSize;
+                int itemTileY = (int)(entities.positionY[hits[i]] - tilemap.position.y)/tilemap.tileSize;
+                
+                SetTilemapTile(tilemap, tilemapCache, itemTileX, itemTileY, TILEMAP_LAYER_OBJECTS, -1);
+                DestroyEntity(&entities, hits[i]);
+            }
+        }
+        
+        // Tiles animations: only current frame offsets are updated, cost does not depend on animated tiles drawn
+        UpdateTilemapAnimations(tilemapCache, (float)glfwGetTime());
+        
+        // Camera follows player, zoom is controlled by user
+        camera.target = (Vector2){ playerRec.x + playerRec.width/2, playerRec.y + playerRec.height/2 };
+        
+        if (IsKeyDown(GLFW_KEY_PAGE_UP)) camera.zoom += 0.02f;
+        else if (IsKeyDown(GLFW_KEY_PAGE_DOWN)) camera.zoom -= 0.02f;
+        
+        if (camera.zoom < 0.25f) camera.zoom = 0.25f;
+        else if (camera.zoom > 4.0f) camera.zoom = 4.0f;
         //----------------------------------------------------------------------------------
 
         // Draw
         //----------------------------------------------------------------------------------
+        rlResetRenderStats();               // Reset rendering statistics for current frame
         rlClearScreenBuffers();             // Clear current framebuffer
-
-        DrawTilemap(tilemap, texTileset);   // Draw tilemap using provide tileset
         
-        DrawTexture(texPlayer, player.x, player.y, WHITE); // Draw player texture
+        BeginMode2D(camera);                // Begin drawing world through camera
+
+            // Draw tilemap visible area using render cache, tiles out of player field of view are not drawn
+            // NOTE: Overlay layer is drawn in front, entities drawn later keep behind it
+            DrawTilemap(tilemap, &tilemapCache, GetCameraViewRec(camera, screenWidth, screenHeight), &fov);
+            
+            // Draw entities in field of view (monsters and items)
+            // NOTE: Recording could run on a worker thread, submission keeps drawing order (after tilemap)
+            rlBeginCommandBuffer(entitiesCommands);
+            DrawEntities(entities, tilemap, tileset, fov);
+            rlEndCommandBuffer();
+            rlSubmitCommandBuffer(entitiesCommands);
+            
+            DrawTexture(texPlayer, playerRec.x - 4, playerRec.y - 8, WHITE);   // Draw player texture (over collision box)
+            
+        EndMode2D();                        // End drawing through camera
         
         rlglDraw();                         // Internal buffers drawing (2D data)
+        
+#if defined(RENDER_STATS)
+        if ((framesCounter%60) == 0) rlTraceRenderStats();
+        framesCounter++;
+#endif
+
+        // Frames recording: frame read back asynchronously, written to file two frames later
+        if (IsKeyPressed(GLFW_KEY_F11))
+        {
+            if (recordingFile == NULL) recordingFile = fopen("recording.rgba", "wb");
+            else
+            {
+                rlFlushReadbacks();         // Pending frames are written before closing file
+                fclose(recordingFile);
+                recordingFile = NULL;
+            }
+        }
+
+        if (recordingFile != NULL) rlReadScreenPixelsAsync(screenWidth, screenHeight, RecordFrame, recordingFile);
+        rlUpdateReadbacks();                // Complete readbacks issued two frames ago
+        
+        // NOTE: Screenshot is taken before swapping, back buffer content is undefined after swap
+        if (IsKeyPressed(GLFW_KEY_F12)) TakeScreenshot("screenshot.ppm", screenWidth, screenHeight);
 
+#if !defined(GRAPHICS_API_SOFTWARE)
+        rlCaptureFrame();                   // Mark captured frame end (only if capturing)
         glfwSwapBuffers(window);            // Swap buffers: show back buffer into front
+#endif
+        
         PollInputEvents();                  // Register input events (keyboard, mouse)
         SyncFrame();                        // Wait required time to target framerate
         //----------------------------------------------------------------------------------
@@ -254,9 +734,26 @@ int main(void)
     // De-Initialization
     //--------------------------------------------------------------------------------------
     UnloadTexture(texPlayer);       // Unload player texture
-    UnloadTexture(texTileset);      // Unload tileset texture
+    UnloadTileset(tileset);         // Unload tileset data and texture
+    UnloadTilemapCache(tilemapCache);   // Unload tilemap render cache
     UnloadTilemap(tilemap);         // Unload tilemap data
+    UnloadFlowField(flowField);     // Unload flow field data
+    UnloadFieldOfView(fov);         // Unload field of view data
+    UnloadEntities(entities);       // Unload entities storage
+    UnloadSpatialHash(spatialHash); // Unload entities spatial hash
+    free(hits);                     // Unload spatial hash queries results
+    rlUnloadCommandBuffer(entitiesCommands);    // Unload entities drawing command buffer
     
+#if defined(GRAPHICS_API_SOFTWARE)
+    TakeScreenshot("screenshot.ppm", screenWidth, screenHeight);   // Software rasterizer framebuffer is not shown, last frame is saved
+#endif
+
+    if (recordingFile != NULL)
+    {
+        rlFlushReadbacks();         // Write pending recorded frames
+        fclose(recordingFile);
+    }
+
     rlglClose();                    // Unload rlgl internal buffers and default shader/texture
     
     CloseWindow();                  // Close window and OpenGL context
@@ -296,12 +793,17 @@ static void InitWindow(int screenWidth, int screenHeight)
     if (!glfwInit()) TraceLog(LOG_WARNING, "GLFW3: Can not initialize GLFW");
     else TraceLog(LOG_INFO, "GLFW3: GLFW initialized successfully");
     
+#if defined(GRAPHICS_API_SOFTWARE)
+    // NOTE: Software rasterizer does not require an OpenGL context, window is only used for inputs
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+#else
     glfwWindowHint(GLFW_SAMPLES, 4);
     glfwWindowHint(GLFW_DEPTH_BITS, 16);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+#endif
    
     window = glfwCreateWindow(screenWidth, screenHeight, "CHALLENGE 02: 2D DUNGEON GAME", NULL, NULL);
     
@@ -312,8 +814,10 @@ static void InitWindow(int screenWidth, int screenHeight)
     
     glfwSetKeyCallback(window, KeyCallback);
     
+#if !defined(GRAPHICS_API_SOFTWARE)
     glfwMakeContextCurrent(window);
     glfwSwapInterval(1);
+#endif
 }
 
 // Close window and free resources
@@ -360,8 +864,15 @@ static void SyncFrame(void)
 // Initialize graphic device (OpenGL 3.3)
 static void InitGraphicsDevice(int width, int height)
 {
+#if !defined(GRAPHICS_API_SOFTWARE)
     // Load OpenGL 3.3 supported extensions
     rlLoadExtensions(glfwGetProcAddress);
+#endif
+
+#if defined(RLGL_CAPTURE)
+    // Capture must start before rlglInit(), default resources creation is captured
+    rlBeginCapture("dungeon.gltrace", CAPTURE_FRAMES);
+#endif
 
     // Initialize OpenGL context (states and resources)
     rlglInit(width, height);
@@ -370,7 +881,8 @@ static void InitGraphicsDevice(int width, int height)
     rlViewport(0, 0, width, height);
     rlMatrixMode(RL_PROJECTION);                        // Switch to PROJECTION matrix
     rlLoadIdentity();                                   // Reset current matrix (PROJECTION)
-    rlOrtho(0, width, height, 0, 0.0f, 1.0f);           // Orthographic projection with top-left corner at (0,0)
+    // NOTE: Depth range (z from -2.0f to 1.0f) contains rlgl batch depths (from -1.0f) and tilemap layers depths
+    rlOrtho(0, width, height, 0, -1.0f, 2.0f);          // Orthographic projection with top-left corner at (0,0)
     rlMatrixMode(RL_MODELVIEW);                         // Switch back to MODELVIEW matrix
     rlLoadIdentity();                                   // Reset current matrix (MODELVIEW)
 
@@ -378,6 +890,32 @@ static void InitGraphicsDevice(int width, int height)
     rlEnableDepthTest();                                // Enable DEPTH_TEST for 3D
 }
 
+// Save current framebuffer as PPM image (binary RGB)
+static void TakeScreenshot(const char *fileName, int width, int height)
+{
+    unsigned char *pixels = rlReadScreenPixels(width, height);
+    FILE *ppmFile = fopen(fileName, "wb");
+
+    if (ppmFile != NULL)
+    {
+        fprintf(ppmFile, "P6\n%i %i\n255\n", width, height);
+        for (int i = 0; i < width*height; i++) fwrite(pixels + i*4, 1, 3, ppmFile);
+        fclose(ppmFile);
+
+        TraceLog(LOG_INFO, "Screenshot saved: %s", fileName);
+    }
+    else TraceLog(LOG_WARNING, "[%s] Screenshot could not be saved", fileName);
+
+    free(pixels);
+}
+
+// Append frame pixels to recording file (readback callback)
+// NOTE: Rows are written top-down following stride, alpha channel is kept (raw RGBA)
+static void RecordFrame(const unsigned char *pixels, int width, int height, int stride, void *userData)
+{
+    for (int y = 0; y < height; y++) fwrite(pixels + y*stride, 1, width*4, (FILE *)userData);
+}
+
 // LESSON 03: Inputs management (keyboard and mouse)
 //----------------------------------------------------------------------------------
 // Detect if a key is being pressed (key held down)
@@ -617,177 +1155,2102 @@ static void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, f
     DrawTexturePro(texture, sourceRec, destRec, origin, rotation, tint);
 }
 
-// Draw a part of a texture (defined by a rectangle)
-static void DrawTextureRec(Texture2D texture, Rectangle sourceRec, Vector2 position, Color tint)
-{
-    Rectangle destRec = { (int)position.x, (int)position.y, abs(sourceRec.width), abs(sourceRec.height) };
-    Vector2 origin = { 0, 0 };
-
-    DrawTexturePro(texture, sourceRec, destRec, origin, 0.0f, tint);
-}
-
 // Draw a part of a texture (defined by a rectangle) with 'pro' parameters
-// NOTE: origin is relative to destination rectangle size
+// NOTE: origin is relative to destination rectangle size, texture is drawn as a single sprite batch
 static void DrawTexturePro(Texture2D texture, Rectangle sourceRec, Rectangle destRec, Vector2 origin, float rotation, Color tint)
 {
     // Check if texture is valid
     if (texture.id != 0)
     {
-        if (sourceRec.width < 0) sourceRec.x -= sourceRec.width;
-        if (sourceRec.height < 0) sourceRec.y -= sourceRec.height;
-
-        rlEnableTexture(texture.id);
-
-        rlPushMatrix();
-            rlTranslatef((float)destRec.x, (float)destRec.y, 0);
-            rlRotatef(rotation, 0, 0, 1);
-            rlTranslatef(-origin.x, -origin.y, 0);
-
-            rlBegin(RL_QUADS);
-                rlColor4ub(tint.r, tint.g, tint.b, tint.a);
-                rlNormal3f(0.0f, 0.0f, 1.0f);                          // Normal vector pointing towards viewer
-
-                // Bottom-left corner for texture and quad
-                rlTexCoord2f((float)sourceRec.x/texture.width, (float)sourceRec.y/texture.height);
-                rlVertex2f(0.0f, 0.0f);
-
-                // Bottom-right corner for texture and quad
-                rlTexCoord2f((float)sourceRec.x/texture.width, (float)(sourceRec.y + sourceRec.height)/texture.height);
-                rlVertex2f(0.0f, (float)destRec.height);
-
-                // Top-right corner for texture and quad
-                rlTexCoord2f((float)(sourceRec.x + sourceRec.width)/texture.width, (float)(sourceRec.y + sourceRec.height)/texture.height);
-                rlVertex2f((float)destRec.width, (float)destRec.height);
-
-                // Top-left corner for texture and quad
-                rlTexCoord2f((float)(sourceRec.x + sourceRec.width)/texture.width, (float)sourceRec.y/texture.height);
-                rlVertex2f((float)destRec.width, 0.0f);
-            rlEnd();
-        rlPopMatrix();
-
-        rlDisableTexture();
+        SpriteBatch batch = BeginSpriteBatch(texture);
+        DrawSprite(batch, sourceRec, destRec, origin, rotation, tint);
+        EndSpriteBatch();
     }
 }
 
-// LESSON 06: Tilemap data loading and drawing
+// Sprites batching
 //----------------------------------------------------------------------------------
-// Load tilemap data from file (text/image)
-static Tilemap LoadTilemap(const char *valuesMap, const char *collidersMap)
+// Begin sprites batch, all sprites drawn until EndSpriteBatch() use the same texture
+// NOTE: Texture texel size is computed once per batch
+static SpriteBatch BeginSpriteBatch(Texture2D texture)
 {
-    Tilemap map = { 0 };
-    const char *fileExt;
+    SpriteBatch batch = { 0 };
     
-    if ((fileExt = strrchr(valuesMap, '.')) != NULL)
-    {
-        // Check if file extension is supported
-        if (strcmp(fileExt, ".txt") == 0) 
-        {
-            int counter = 0;
-            int temp = 0;
-            
-            // Read values from text file
-            FILE *valuesFile = fopen(valuesMap, "rt");
-            
-            while (!feof(valuesFile))
-            {
-                fscanf(valuesFile, "%i", &temp);
-                counter++;
-            }
-            
-            rewind(valuesFile);        // Return to the beginning of the file, to read again
-
-            map.tiles = (Tile *)malloc(counter*sizeof(Tile));
-            
-            map.tileCountX = 12;
-            map.tileCountY = 8;
-            counter = 0;
-
-            while (!feof(valuesFile))
-            {
-                fscanf(valuesFile, "%i", &map.tiles[counter].value);
-                counter++;
-            }
-            
-            fclose(valuesFile);
-            
-            // Read values from text file
-            // NOTE: Colliders map data MUST match values data, 
-            // or we need to do a previous check like done with values data
-            FILE *collidersFile = fopen(collidersMap, "rt");
-            counter = 0;
-            temp = 0;
-            
-            while (!feof(collidersFile))
-            {
-                fscanf(collidersFile, "%i", &temp);
-                map.tiles[counter].collider = temp;
-
-                counter++;
-            }
+    batch.texture = texture;
+    batch.texelWidth = 1.0f/texture.width;
+    batch.texelHeight = 1.0f/texture.height;
+    
+    rlEnableTexture(texture.id);
+    
+    return batch;
+}
 
-            fclose(collidersFile);
-            
-#if DEBUG   // print tilemap information loaded
-            for (int j = 0; j < map.tileCountY; j++)
-            {
-                for (int i = 0; i < map.tileCountX; i++)
-                {
-                    printf("%i ", map.tiles[j*map.tileCountX + i].collider);
-                }
-                
-                printf("\n");
-            }
-#endif
-        }
-        else if (strcmp(fileExt, ".bmp") == 0) 
+// Draw sprite into batch, same parameters than DrawTexturePro()
+// NOTE: Quad vertex are transformed here (translation and rotation around origin),
+// rotation matrix is only computed for rotated sprites (sinf/cosf, no matrix stack)
+static void DrawSprite(SpriteBatch batch, Rectangle sourceRec, Rectangle destRec, Vector2 origin, float rotation, Color tint)
+{
+    if (sourceRec.width < 0) sourceRec.x -= sourceRec.width;
+    if (sourceRec.height < 0) sourceRec.y -= sourceRec.height;
+    
+    float left = sourceRec.x*batch.texelWidth;
+    float top = sourceRec.y*batch.texelHeight;
+    float right = (sourceRec.x + sourceRec.width)*batch.texelWidth;
+    float bottom = (sourceRec.y + sourceRec.height)*batch.texelHeight;
+    
+    // Vertex order: top-left, bottom-left, bottom-right, top-right
+    float texcoords[8] = { left, top, left, bottom, right, bottom, right, top };
+    
+    // Quad corners relative to destination position (origin is the rotation pivot)
+    float x0 = -origin.x;
+    float y0 = -origin.y;
+    float x1 = (float)destRec.width - origin.x;
+    float y1 = (float)destRec.height - origin.y;
+    
+    float positions[8] = { 0 };
+    
+    if (rotation == 0.0f)
+    {
+        x0 += destRec.x; x1 += destRec.x;
+        y0 += destRec.y; y1 += destRec.y;
+        
+        positions[0] = x0; positions[1] = y0;
+        positions[2] = x0; positions[3] = y1;
+        positions[4] = x1; positions[5] = y1;
+        positions[6] = x1; positions[7] = y0;
+    }
+    else
+    {
+        float sinRotation = sinf(rotation*DEG2RAD);
+        float cosRotation = cosf(rotation*DEG2RAD);
+        
+        float corners[8] = { x0, y0, x0, y1, x1, y1, x1, y0 };
+        
+        for (int i = 0; i < 4; i++)
         {
-            Image image = LoadImage(valuesMap);
-            
-            map.tileCountX = image.width;
-            map.tileCountY = image.height;
-            
-            // TODO: Load tile data from image pixel data
-            
-            // NOTE: When using images to codify map data, 
-            // lot of extra information can be codified in each pixel!
+            positions[i*2] = destRec.x + corners[i*2]*cosRotation - corners[i*2 + 1]*sinRotation;
+            positions[i*2 + 1] = destRec.y + corners[i*2]*sinRotation + corners[i*2 + 1]*cosRotation;
         }
     }
-
-    return map;
+    
+    rlQuad2f(positions, texcoords, tint);
 }
 
-// Unload tilemap data from memory
-static void UnloadTilemap(Tilemap map)
+// End sprites batch
+static void EndSpriteBatch(void)
 {
-    if (map.tiles != NULL) free(map.tiles);
+    rlDisableTexture();
 }
 
-// Draw tilemap using tileset
-static void DrawTilemap(Tilemap map, Texture2D tileset)
+#if defined(QUADS_TRANSFORM_BENCHMARK)
+// Log textured quads recording time: rlgl matrix stack (vertex transformed on rlEnd()) and sprites batch
+// NOTE: Dungeon textured quads workload: 32x32 tileset sprites, translated and rotated,
+// only vertex data recording is measured, internal buffers drawing is done out of timing
+static void BenchmarkQuadsTransform(Texture2D texture)
 {
-    for (int y = 0; y < map.tileCountY; y++)
+    #define BENCHMARK_FRAMES     100
+    #define BENCHMARK_QUADS     4000    // Quads per frame (below MAX_QUADS_BATCH)
+    
+    double matrixTime = 0.0;
+    double batchTime = 0.0;
+    
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++)
     {
-        for (int x = 0; x < map.tileCountX; x++)
+        double time = glfwGetTime();
+        
+        rlEnableTexture(texture.id);
+        
+        for (int i = 0; i < BENCHMARK_QUADS; i++)
+        {
+            rlPushMatrix();
+                rlTranslatef((float)(i%64*32), (float)(i/64*32), 0);
+                rlRotatef((float)(i%360), 0, 0, 1);
+                rlTranslatef(-16.0f, -16.0f, 0);
+                
+                rlBegin(RL_QUADS);
+                    rlColor4ub(255, 255, 255, 255);
+                    rlTexCoord2f(0.0f, 0.0f);
+                    rlVertex2f(0.0f, 0.0f);
+                    rlTexCoord2f(0.0f, 0.25f);
+                    rlVertex2f(0.0f, 32.0f);
+                    rlTexCoord2f(0.125f, 0.25f);
+                    rlVertex2f(32.0f, 32.0f);
+                    rlTexCoord2f(0.125f, 0.0f);
+                    rlVertex2f(32.0f, 0.0f);
+                rlEnd();
+            rlPopMatrix();
+        }
+        
+        rlDisableTexture();
+        
+        matrixTime += glfwGetTime() - time;
+        rlglDraw();
+        
+        time = glfwGetTime();
+        
+        SpriteBatch batch = BeginSpriteBatch(texture);
+        
+        for (int i = 0; i < BENCHMARK_QUADS; i++)
         {
-            // Draw each piece of the tileset in the right position to build map
-            DrawTextureRec(tileset, tilesetRecs[map.tiles[y*map.tileCountX + x].value - 1], 
-                          (Vector2){ map.position.x + x*map.tileSize, map.position.y + y*map.tileSize }, WHITE);
+            DrawSprite(batch, (Rectangle){ 0, 0, 32, 32 }, (Rectangle){ i%64*32, i/64*32, 32, 32 }, (Vector2){ 16, 16 }, (float)(i%360), WHITE);
         }
+        
+        EndSpriteBatch();
+        
+        batchTime += glfwGetTime() - time;
+        rlglDraw();
     }
     
+    TraceLog(LOG_INFO, "[QUADS BENCHMARK] %i quads: matrix stack %.3f ms/frame, sprites batch %.3f ms/frame", BENCHMARK_QUADS, 
+             matrixTime*1000.0/BENCHMARK_FRAMES, batchTime*1000.0/BENCHMARK_FRAMES);
 }
+#endif
 
-// LESSON 07: Collision detection
-//----------------------------------------------------------------------------------
-// Check collision between two rectangles
-static bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2)
+#if defined(DRAW_SORT_BENCHMARK)
+// Log interleaved textures sprites drawing time for every rlgl draw calls sorting mode
+// NOTE: Tileset sprites (layer 0) are interleaved with default texture sprites (layer 1),
+// every sprite changes texture, recording and internal buffers drawing are measured
+static void BenchmarkDrawSort(Texture2D texture)
 {
-    bool collision = false;
-
-    int dx = abs((rec1.x + rec1.width/2) - (rec2.x + rec2.width/2));
-    int dy = abs((rec1.y + rec1.height/2) - (rec2.y + rec2.height/2));
-
-    if ((dx <= (rec1.width/2 + rec2.width/2)) && ((dy <= (rec1.height/2 + rec2.height/2)))) collision = true;
-
-    return collision;
-}
+    #define BENCHMARK_FRAMES     100
+    #define BENCHMARK_SPRITES   4000    // Sprites per frame (half of them using default texture)
+    
+    static const char *modeNames[3] = { "none", "depth", "state" };
+    Texture2D textureDefault = GetTextureDefault();
+    
+    for (int mode = RL_SORT_NONE; mode <= RL_SORT_STATE; mode++)
+    {
+        rlSetDrawSortMode(mode);
+        
+        double time = glfwGetTime();
+        
+        for (int frame = 0; frame < BENCHMARK_FRAMES; frame++)
+        {
+            for (int i = 0; i < BENCHMARK_SPRITES; i++)
+            {
+                Rectangle destRec = { i%64*32, i/64*32, 32, 32 };
+                
+                if (i%2 == 0)
+                {
+                    rlSetDrawLayer(0);
+                    DrawTexturePro(texture, (Rectangle){ 0, 0, 32, 32 }, destRec, (Vector2){ 0, 0 }, 0.0f, WHITE);
+                }
+                else
+                {
+                    rlSetDrawLayer(1);
+                    DrawTexturePro(textureDefault, (Rectangle){ 0, 0, 1, 1 }, destRec, (Vector2){ 0, 0 }, 0.0f, (Color){ 0, 0, 0, 128 });
+                }
+            }
+            
+            rlglDraw();
+        }
+        
+        TraceLog(LOG_INFO, "[DRAW SORT BENCHMARK] %i sprites, sort mode %s: %.3f ms/frame", BENCHMARK_SPRITES, 
+                 modeNames[mode], (glfwGetTime() - time)*1000.0/BENCHMARK_FRAMES);
+    }
+    
+    rlSetDrawLayer(0);
+    rlSetDrawSortMode(RL_SORT_NONE);
+}
+#endif
+
+#if defined(COMMAND_BUFFERS_BENCHMARK)
+#define BENCHMARK_THREADS        4
+
+// Sprites recording job (worker thread)
+typedef struct RecordJob {
+    CommandBuffer *buffer;      // Command buffer (one by thread)
+    Texture2D texture;          // Sprites texture
+    int firstSprite;            // First sprite to record
+    int spritesCount;           // Number of sprites to record
+} RecordJob;
+
+// Record sprites range: rotated tileset sprites in a 64 columns grid
+static void RecordSprites(Texture2D texture, int firstSprite, int spritesCount)
+{
+    SpriteBatch batch = BeginSpriteBatch(texture);
+    
+    for (int i = firstSprite; i < (firstSprite + spritesCount); i++)
+    {
+        DrawSprite(batch, (Rectangle){ 0, 0, 32, 32 }, (Rectangle){ i%64*32, i/64*32, 32, 32 }, (Vector2){ 16, 16 }, (float)(i%360), WHITE);
+    }
+    
+    EndSpriteBatch();
+}
+
+// Worker thread: record job sprites into its command buffer
+static void *RecordSpritesJob(void *data)
+{
+    RecordJob *job = (RecordJob *)data;
+    
+    rlBeginCommandBuffer(job->buffer);
+    RecordSprites(job->texture, job->firstSprite, job->spritesCount);
+    rlEndCommandBuffer();
+    
+    return NULL;
+}
+
+// Log sprites recording time: GL thread recording into rlgl default buffers and worker
+// threads recording into command buffers (merged on GL thread in jobs order)
+// NOTE: Internal buffers drawing is done out of timing, drawn vertex are logged to check merging
+static void BenchmarkCommandBuffers(Texture2D texture)
+{
+    #define BENCHMARK_FRAMES     100
+    #define BENCHMARK_SPRITES  40000    // Sprites per frame (split between worker threads)
+    
+    CommandBuffer *buffers[BENCHMARK_THREADS] = { 0 };
+    RecordJob jobs[BENCHMARK_THREADS] = { 0 };
+    pthread_t threads[BENCHMARK_THREADS];
+    
+    for (int i = 0; i < BENCHMARK_THREADS; i++)
+    {
+        buffers[i] = rlLoadCommandBuffer();
+        if (buffers[i] == NULL) return;
+        
+        jobs[i] = (RecordJob){ buffers[i], texture, i*BENCHMARK_SPRITES/BENCHMARK_THREADS, BENCHMARK_SPRITES/BENCHMARK_THREADS };
+    }
+    
+    double singleTime = 0.0;
+    double threadsTime = 0.0;
+    int singleVertex = 0;
+    int threadsVertex = 0;
+    
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++)
+    {
+        rlResetRenderStats();
+        
+        double time = glfwGetTime();
+        RecordSprites(texture, 0, BENCHMARK_SPRITES);
+        singleTime += glfwGetTime() - time;
+        
+        rlglDraw();
+        singleVertex = rlGetRenderStats().quadsVertex;
+        rlResetRenderStats();
+        
+        time = glfwGetTime();
+        
+        for (int i = 0; i < BENCHMARK_THREADS; i++) pthread_create(&threads[i], NULL, RecordSpritesJob, &jobs[i]);
+        for (int i = 0; i < BENCHMARK_THREADS; i++) pthread_join(threads[i], NULL);
+        for (int i = 0; i < BENCHMARK_THREADS; i++) rlSubmitCommandBuffer(buffers[i]);
+        
+        threadsTime += glfwGetTime() - time;
+        
+        rlglDraw();
+        threadsVertex = rlGetRenderStats().quadsVertex;
+    }
+    
+    for (int i = 0; i < BENCHMARK_THREADS; i++) rlUnloadCommandBuffer(buffers[i]);
+    
+    TraceLog(LOG_INFO, "[COMMAND BUFFERS BENCHMARK] %i sprites: GL thread %.3f ms/frame (%i vertex), %i threads %.3f ms/frame (%i vertex)", BENCHMARK_SPRITES, 
+             singleTime*1000.0/BENCHMARK_FRAMES, singleVertex, BENCHMARK_THREADS, threadsTime*1000.0/BENCHMARK_FRAMES, threadsVertex);
+}
+#endif
+
+// LESSON 06: Tilemap data loading and drawing
+//----------------------------------------------------------------------------------
+// Load file data into memory (read-only)
+// NOTE: On POSIX systems file is memory-mapped, no copy is done, on other systems
+// file is loaded with a single read, in both cases it must be released with UnloadFileData()
+static const char *LoadFileData(const char *fileName, int *dataSize)
+{
+    char *data = NULL;
+    *dataSize = 0;
+
+#if !defined(_WIN32)
+    int fd = open(fileName, O_RDONLY);
+
+    if (fd < 0) TraceLog(LOG_WARNING, "[%s] File could not be opened", fileName);
+    else
+    {
+        struct stat info;
+
+        if ((fstat(fd, &info) == 0) && (info.st_size > 0))
+        {
+            data = (char *)mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data == MAP_FAILED) data = NULL;
+            else *dataSize = (int)info.st_size;
+        }
+
+        close(fd);      // NOTE: Mapping keeps valid after closing file descriptor
+    }
+#else
+    FILE *file = fopen(fileName, "rb");
+
+    if (file == NULL) TraceLog(LOG_WARNING, "[%s] File could not be opened", fileName);
+    else
+    {
+        fseek(file, 0, SEEK_END);
+        int size = (int)ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        if (size > 0)
+        {
+            data = (char *)malloc(size);
+
+            if (fread(data, 1, size, file) == (size_t)size) *dataSize = size;
+            else
+            {
+                free(data);
+                data = NULL;
+            }
+        }
+
+        fclose(file);
+    }
+#endif
+
+    return data;
+}
+
+// Unload file data loaded with LoadFileData()
+static void UnloadFileData(const char *data, int dataSize)
+{
+    if (data == NULL) return;
+
+#if !defined(_WIN32)
+    munmap((void *)data, dataSize);
+#else
+    free((void *)data);
+#endif
+}
+
+// Scan integer values from text data, every line of values is a row of tiles
+// NOTE: If values is NULL, only tilemap size is computed (values per line and lines)
+// Empty lines are skipped, all lines must contain the same number of values and '-' must be followed by digits,
+// values must fit in an int and tilemap size is limited to TILEMAP_TEXT_MAX_SIZE values per line and lines
+static bool ScanTilemapText(const char *text, int size, int *values, int *countX, int *countY)
+{
+    int x = 0;          // Values in current line
+    int width = 0;      // Values per line (first line defines it)
+    int height = 0;     // Lines with values
+    int count = 0;      // Values scanned
+
+    for (int i = 0; i <= size; i++)
+    {
+        // NOTE: End of text is considered an end of line (last line could not have one)
+        if ((i == size) || (text[i] == '\n'))
+        {
+            if (x > 0)
+            {
+                if (width == 0) width = x;
+                else if (x != width) return false;
+
+                height++;
+                x = 0;
+
+                if (height > TILEMAP_TEXT_MAX_SIZE) return false;
+            }
+        }
+        else if ((text[i] == '-') || ((text[i] >= '0') && (text[i] <= '9')))
+        {
+            bool negative = (text[i] == '-');
+            int value = 0;
+
+            if (negative) i++;
+
+            // NOTE: A sign without digits is not a value, text is not valid
+            if ((i == size) || (text[i] < '0') || (text[i] > '9')) return false;
+
+            while ((i < size) && (text[i] >= '0') && (text[i] <= '9'))
+            {
+                if (value > (INT_MAX - (text[i] - '0'))/10) return false;   // Value overflows int
+
+                value = value*10 + (text[i] - '0');
+                i++;
+            }
+
+            if (values != NULL) values[count] = negative? -value : value;
+
+            count++;
+            x++;
+            i--;
+
+            if (x > TILEMAP_TEXT_MAX_SIZE) return false;    // Character after value must be checked (could be an end of line)
+        }
+        // NOTE: Any other character (spaces, tabs, '\r') is a separator
+    }
+
+    *countX = width;
+    *countY = height;
+
+    return true;
+}
+
+// Load integer values from a tilemap text file
+// NOTE: Values array size is countX*countY, it must be freed by caller
+static int *LoadTilemapText(const char *fileName, int *countX, int *countY)
+{
+    int *values = NULL;
+    int size = 0;
+    const char *text = LoadFileData(fileName, &size);
+
+    *countX = 0;
+    *countY = 0;
+
+    if (text != NULL)
+    {
+        // First pass: get tilemap size, second pass: get values
+        // NOTE: Scanned size is limited (TILEMAP_TEXT_MAX_SIZE), values count can not overflow
+        if (ScanTilemapText(text, size, NULL, countX, countY) && ((*countX)*(*countY) > 0))
+        {
+            values = (int *)malloc((size_t)(*countX)*(*countY)*sizeof(int));
+
+            if (values != NULL) ScanTilemapText(text, size, values, countX, countY);
+            else
+            {
+                *countX = 0;
+                *countY = 0;
+            }
+        }
+        else TraceLog(LOG_WARNING, "[%s] Tilemap text not valid (lines with different number of values, not valid values or size over limits)", fileName);
+
+        UnloadFileData(text, size);
+    }
+
+    return values;
+}
+
+// Load tilemap data from file (text/binary/image)
+// NOTE: Colliders map is only required for text files, binary and image files include colliders data
+static Tilemap LoadTilemap(const char *valuesMap, const char *collidersMap)
+{
+    Tilemap map = { 0 };
+    const char *fileExt;
+    
+    if ((fileExt = strrchr(valuesMap, '.')) != NULL)
+    {
+        // Check if file extension is supported
+        if (strcmp(fileExt, ".txt") == 0) 
+        {
+            // Read values from text file, tilemap size is defined by file lines
+            int *values = LoadTilemapText(valuesMap, &map.tileCountX, &map.tileCountY);
+            
+            if (values == NULL) return map;
+            
+            map.tiles = (Tile *)calloc(map.tileCountX*map.tileCountY, sizeof(Tile));
+            
+            for (int i = 0; i < map.tileCountX*map.tileCountY; i++) 
+            {
+                map.tiles[i].value = values[i];
+                map.tiles[i].object = -1;       // Objects layer is loaded with LoadTilemapLayer()
+                map.tiles[i].overlay = -1;      // Overlay layer is loaded with LoadTilemapLayer()
+                map.tiles[i].collider = 1;      // Walkable by default
+            }
+            
+            free(values);
+            
+            // Read colliders from text file
+            // NOTE: Colliders map data MUST match values data size, if not, colliders are not loaded
+            if (collidersMap != NULL)
+            {
+                int collidersCountX = 0;
+                int collidersCountY = 0;
+                int *colliders = LoadTilemapText(collidersMap, &collidersCountX, &collidersCountY);
+                
+                if ((collidersCountX == map.tileCountX) && (collidersCountY == map.tileCountY))
+                {
+                    for (int i = 0; i < map.tileCountX*map.tileCountY; i++) map.tiles[i].collider = colliders[i];
+                }
+                else TraceLog(LOG_WARNING, "[%s] Colliders map size (%ix%i) does not match tilemap size (%ix%i)", 
+                              collidersMap, collidersCountX, collidersCountY, map.tileCountX, map.tileCountY);
+                
+                free(colliders);
+            }
+            
+            TraceLog(LOG_INFO, "[%s] Tilemap loaded successfully (%ix%i)", valuesMap, map.tileCountX, map.tileCountY);
+            
+#if DEBUG   // print tilemap information loaded
+            for (int j = 0; j < map.tileCountY; j++)
+            {
+                for (int i = 0; i < map.tileCountX; i++)
+                {
+                    printf("%i ", map.tiles[j*map.tileCountX + i].collider);
+                }
+                
+                printf("\n");
+            }
+#endif
+        }
+        else if (strcmp(fileExt, ".tmb") == 0) map = LoadTilemapBinary(valuesMap);
+        else if (strcmp(fileExt, ".bmp") == 0) 
+        {
+            Image image = LoadImage(valuesMap);
+            
+            if (image.data == NULL) return map;
+            
+            map.tileCountX = image.width;
+            map.tileCountY = image.height;
+            map.tiles = (Tile *)calloc(map.tileCountX*map.tileCountY, sizeof(Tile));
+            
+            // NOTE: When using images to codify map data, 
+            // lot of extra information can be codified in each pixel!
+            // One pixel per tile, all tilemap layers are packed in pixel channels:
+            //   R: tile value (0 -> no tile)
+            //   G: tile object value (0 -> no object)
+            //   B: tile collider (255 -> walkable, 0 -> blocked)
+            // NOTE: Alpha channel is not available in 24bpp BMP files
+            for (int i = 0; i < map.tileCountX*map.tileCountY; i++)
+            {
+                Color pixel = image.data[i];
+                
+                map.tiles[i].value = (pixel.r == 0)? -1 : pixel.r;
+                map.tiles[i].object = (pixel.g == 0)? -1 : pixel.g;
+                map.tiles[i].overlay = -1;
+                map.tiles[i].collider = (pixel.b > 127);
+                map.tiles[i].color = pixel;
+            }
+            
+            UnloadImage(image);
+            
+            TraceLog(LOG_INFO, "[%s] Tilemap loaded successfully from image (%ix%i)", valuesMap, map.tileCountX, map.tileCountY);
+        }
+    }
+
+    return map;
+}
+
+// Load tilemap data from binary file
+// NOTE: Full file is loaded with a single read, tile data is decoded from memory
+static Tilemap LoadTilemapBinary(const char *fileName)
+{
+    Tilemap map = { 0 };
+    int size = 0;
+    const unsigned char *data = (const unsigned char *)LoadFileData(fileName, &size);
+    
+    if (data == NULL) return map;
+    
+    TilemapFileHeader header = { 0 };
+    
+    // NOTE: Header fields are decoded from little-endian bytes, not depending on host byte order
+    if (size >= TILEMAP_FILE_HEADER_SIZE)
+    {
+        memcpy(header.id, data, 4);
+        header.version = (unsigned short)(data[4] | (data[5] << 8));
+        header.tileSize = (unsigned short)(data[6] | (data[7] << 8));
+        header.tileCountX = (int)(data[8] | (data[9] << 8) | (data[10] << 16) | ((unsigned int)data[11] << 24));
+        header.tileCountY = (int)(data[12] | (data[13] << 8) | (data[14] << 16) | ((unsigned int)data[15] << 24));
+    }
+    
+    // NOTE: Tiles counters are checked against file size before multiplying them (no overflow)
+    if ((memcmp(header.id, "TMB ", 4) != 0) || (header.version != TILEMAP_FILE_VERSION) || 
+        (header.tileCountX <= 0) || (header.tileCountY <= 0) || 
+        (header.tileCountY > (size - TILEMAP_FILE_HEADER_SIZE)/2/header.tileCountX) ||
+        (size < (TILEMAP_FILE_HEADER_SIZE + header.tileCountX*header.tileCountY*2 + (header.tileCountX*header.tileCountY + 7)/8)))
+    {
+        TraceLog(LOG_WARNING, "[%s] Tilemap binary file not valid", fileName);
+    }
+    else
+    {
+        int tileCount = header.tileCountX*header.tileCountY;
+        const unsigned char *values = data + TILEMAP_FILE_HEADER_SIZE;
+        const unsigned char *colliders = values + tileCount*sizeof(unsigned short);
+        
+        map.tileCountX = header.tileCountX;
+        map.tileCountY = header.tileCountY;
+        map.tileSize = header.tileSize;
+        map.tiles = (Tile *)calloc(tileCount, sizeof(Tile));
+        
+        for (int i = 0; i < tileCount; i++)
+        {
+            // NOTE: Values are stored in little-endian byte order
+            unsigned short value = (unsigned short)(values[i*2] | (values[i*2 + 1] << 8));
+            
+            map.tiles[i].value = (value == TILEMAP_EMPTY_VALUE)? -1 : value;
+            map.tiles[i].object = -1;
+            map.tiles[i].overlay = -1;
+            map.tiles[i].collider = (colliders[i/8] >> (i%8)) & 1;
+        }
+        
+        TraceLog(LOG_INFO, "[%s] Tilemap binary file loaded successfully (%ix%i)", fileName, map.tileCountX, map.tileCountY);
+    }
+    
+    UnloadFileData((const char *)data, size);
+    
+    return map;
+}
+
+#if defined(EXPORT_TILEMAP_BINARY)
+// Export tilemap data to binary file
+static void ExportTilemapBinary(Tilemap map, const char *fileName)
+{
+    int tileCount = map.tileCountX*map.tileCountY;
+    int dataSize = TILEMAP_FILE_HEADER_SIZE + tileCount*sizeof(unsigned short) + (tileCount + 7)/8;
+    unsigned char *data = (unsigned char *)calloc(dataSize, 1);
+    
+    TilemapFileHeader header = { { 'T', 'M', 'B', ' ' }, TILEMAP_FILE_VERSION, map.tileSize, map.tileCountX, map.tileCountY };
+    
+    // NOTE: Header fields are encoded as little-endian bytes, not depending on host byte order
+    memcpy(data, header.id, 4);
+    data[4] = header.version & 0xff;
+    data[5] = header.version >> 8;
+    data[6] = header.tileSize & 0xff;
+    data[7] = header.tileSize >> 8;
+    
+    for (int i = 0; i < 4; i++)
+    {
+        data[8 + i] = ((unsigned int)header.tileCountX >> (i*8)) & 0xff;
+        data[12 + i] = ((unsigned int)header.tileCountY >> (i*8)) & 0xff;
+    }
+    
+    unsigned char *values = data + TILEMAP_FILE_HEADER_SIZE;
+    unsigned char *colliders = values + tileCount*sizeof(unsigned short);
+    
+    for (int i = 0; i < tileCount; i++)
+    {
+        unsigned short value = (map.tiles[i].value < 0)? TILEMAP_EMPTY_VALUE : (unsigned short)map.tiles[i].value;
+        
+        values[i*2] = value & 0xff;
+        values[i*2 + 1] = value >> 8;
+        
+        if (map.tiles[i].collider) colliders[i/8] |= (1 << (i%8));
+    }
+    
+    FILE *file = fopen(fileName, "wb");
+    
+    if (file == NULL) TraceLog(LOG_WARNING, "[%s] Tilemap binary file could not be created", fileName);
+    else
+    {
+        fwrite(data, 1, dataSize, file);
+        fclose(file);
+        
+        TraceLog(LOG_INFO, "[%s] Tilemap binary file exported successfully", fileName);
+    }
+    
+    free(data);
+}
+#endif
+
+// Load tilemap layer values from text file (-1 -> empty tile)
+// NOTE: Layer data MUST match tilemap size, if not, layer is not loaded
+static void LoadTilemapLayer(Tilemap map, const char *fileName, int layer)
+{
+    int countX = 0;
+    int countY = 0;
+    int *values = LoadTilemapText(fileName, &countX, &countY);
+    
+    if (values == NULL) return;
+    
+    if ((countX == map.tileCountX) && (countY == map.tileCountY))
+    {
+        for (int i = 0; i < map.tileCountX*map.tileCountY; i++)
+        {
+            switch (layer)
+            {
+                case TILEMAP_LAYER_GROUND: map.tiles[i].value = values[i]; break;
+                case TILEMAP_LAYER_OBJECTS: map.tiles[i].object = values[i]; break;
+                case TILEMAP_LAYER_OVERLAY: map.tiles[i].overlay = values[i]; break;
+                default: break;
+            }
+        }
+        
+        TraceLog(LOG_INFO, "[%s] Tilemap layer loaded successfully (%ix%i)", fileName, countX, countY);
+    }
+    else TraceLog(LOG_WARNING, "[%s] Layer map size (%ix%i) does not match tilemap size (%ix%i)", 
+                  fileName, countX, countY, map.tileCountX, map.tileCountY);
+    
+    free(values);
+}
+
+// Unload tilemap data from memory
+static void UnloadTilemap(Tilemap map)
+{
+    if (map.tiles != NULL) free(map.tiles);
+}
+
+// Load tileset texture and tiles layout
+// NOTE: Ids map is a grid of tile ids (0 -> unused cell) matching the tileset image tiles grid,
+// tile size is image size divided by grid size, any tileset size is supported
+static Tileset LoadTileset(const char *fileName, const char *idsMap)
+{
+    Tileset tileset = { 0 };
+    
+    int countX = 0;
+    int countY = 0;
+    int *ids = LoadTilemapText(idsMap, &countX, &countY);
+    
+    if (ids == NULL) return tileset;
+    
+    Image image = LoadImage(fileName);
+    
+    if (image.data == NULL)
+    {
+        free(ids);
+        return tileset;
+    }
+    
+    tileset.texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    
+    // Tiles counter is defined by greater id
+    for (int i = 0; i < countX*countY; i++) if (ids[i] > tileset.tileCount) tileset.tileCount = ids[i];
+    
+    tileset.recs = (Rectangle *)calloc(tileset.tileCount, sizeof(Rectangle));
+    tileset.texcoords = (float *)calloc(tileset.tileCount*4, sizeof(float));
+    tileset.colliders = (int *)malloc(tileset.tileCount*sizeof(int));
+    tileset.animations = (TileAnimation *)calloc(tileset.tileCount, sizeof(TileAnimation));
+    
+    int tileWidth = tileset.texture.width/countX;
+    int tileHeight = tileset.texture.height/countY;
+    
+    // NOTE: Divisions are computed once here, reciprocal is used for all tiles
+    float texelWidth = 1.0f/tileset.texture.width;
+    float texelHeight = 1.0f/tileset.texture.height;
+    
+    for (int i = 0; i < countX*countY; i++)
+    {
+        int id = ids[i];
+        
+        if (id <= 0) continue;
+        
+        Rectangle rec = { (i%countX)*tileWidth, (i/countX)*tileHeight, tileWidth, tileHeight };
+        
+        tileset.recs[id - 1] = rec;
+        
+        // Half texel inset: texture filtering never samples neighbour tiles
+        tileset.texcoords[(id - 1)*4] = (rec.x + 0.5f)*texelWidth;
+        tileset.texcoords[(id - 1)*4 + 1] = (rec.y + 0.5f)*texelHeight;
+        tileset.texcoords[(id - 1)*4 + 2] = (rec.x + rec.width - 0.5f)*texelWidth;
+        tileset.texcoords[(id - 1)*4 + 3] = (rec.y + rec.height - 0.5f)*texelHeight;
+    }
+    
+    for (int i = 0; i < tileset.tileCount; i++) tileset.colliders[i] = 1;     // Walkable by default
+    
+    free(ids);
+    
+    TraceLog(LOG_INFO, "[%s] Tileset loaded successfully (%i tiles, %ix%i)", fileName, tileset.tileCount, tileWidth, tileHeight);
+    
+    return tileset;
+}
+
+// Unload tileset data (RAM and VRAM)
+static void UnloadTileset(Tileset tileset)
+{
+    UnloadTexture(tileset.texture);
+    
+    free(tileset.recs);
+    free(tileset.texcoords);
+    free(tileset.colliders);
+    free(tileset.animations);
+}
+
+#if defined(TILE_ANIMATION_SAMPLE)
+// Set tile animation: frames (tile ids) and frame duration
+// NOTE: Animation is applied by tilemap shader to all tiles with that id, chunks are not rebuilt
+static void SetTileAnimation(Tileset tileset, int id, const int *frames, int frameCount, float frameTime)
+{
+    if ((id <= 0) || (id > tileset.tileCount) || (id >= MAX_ANIMATED_TILE_IDS))
+    {
+        TraceLog(LOG_WARNING, "Tile %i can not be animated", id);
+        return;
+    }
+    
+    if (frameCount > MAX_TILE_ANIMATION_FRAMES) frameCount = MAX_TILE_ANIMATION_FRAMES;
+    
+    TileAnimation animation = { 0 };
+    
+    for (int i = 0; i < frameCount; i++)
+    {
+        // NOTE: Not valid frames keep animated tile
+        animation.frames[i] = ((frames[i] > 0) && (frames[i] <= tileset.tileCount))? frames[i] : id;
+    }
+    
+    animation.frameCount = (frameTime > 0.0f)? frameCount : 0;
+    animation.frameTime = frameTime;
+    
+    tileset.animations[id - 1] = animation;
+}
+#endif
+
+// Set tile texture coordinates into a chunk quad (4 vertex)
+// NOTE: Texcoords are precomputed on tileset loading, value must be a valid tile id
+static void SetTileTexcoords(float *texcoords, int value, Tileset tileset)
+{
+    float left = tileset.texcoords[(value - 1)*4];
+    float top = tileset.texcoords[(value - 1)*4 + 1];
+    float right = tileset.texcoords[(value - 1)*4 + 2];
+    float bottom = tileset.texcoords[(value - 1)*4 + 3];
+    
+    // Same vertex order as DrawTexturePro(): top-left, bottom-left, bottom-right, top-right
+    texcoords[0] = left; texcoords[1] = top;
+    texcoords[2] = left; texcoords[3] = bottom;
+    texcoords[4] = right; texcoords[5] = bottom;
+    texcoords[6] = right; texcoords[7] = top;
+}
+
+// Load tilemap render cache
+// NOTE: Chunks vertex data is not loaded here, only when chunks get visible
+static TilemapCache LoadTilemapCache(Tilemap map, Tileset tileset)
+{
+    TilemapCache cache = { 0 };
+    
+    cache.chunkCountX = (map.tileCountX + TILEMAP_CHUNK_SIZE - 1)/TILEMAP_CHUNK_SIZE;
+    cache.chunkCountY = (map.tileCountY + TILEMAP_CHUNK_SIZE - 1)/TILEMAP_CHUNK_SIZE;
+    cache.chunks = (Mesh *)calloc(cache.chunkCountX*cache.chunkCountY, sizeof(Mesh));
+    cache.dirty = (bool *)calloc(cache.chunkCountX*cache.chunkCountY, sizeof(bool));
+    cache.loaded = (int *)calloc(cache.chunkCountX*cache.chunkCountY, sizeof(int));
+    cache.loadedCount = 0;
+    cache.quadTiles = (int **)calloc(cache.chunkCountX*cache.chunkCountY, sizeof(int *));
+    cache.visibility = (int *)calloc(cache.chunkCountX*cache.chunkCountY, sizeof(int));
+    
+    // Chunks are drawn with tilemap shader and tileset texture
+    // NOTE: Tiles texcoords are offset by tile id (second texcoords) to current animation frame,
+    // transparent texels are discarded, they do not write depth,
+    // entities drawn after the tilemap are only hidden by overlay opaque texels
+#if defined(GRAPHICS_API_OPENGL_33)
+    char tilemapVShaderStr[] =
+    "#version 330                       \n"
+    "in vec3 vertexPosition;            \n"
+    "in vec2 vertexTexCoord;            \n"
+    "in vec2 vertexTexCoord2;           \n"
+    "in vec4 vertexColor;               \n"
+    "out vec2 fragTexCoord;             \n"
+    "out vec4 fragColor;                \n"
+    "uniform mat4 mvp;                  \n"
+    "uniform vec4 tileOffsets[128];     \n"     // NOTE: Size must match MAX_ANIMATED_TILE_IDS/2 (vec2 arrays use a full vector per item)
+    "void main()                        \n"
+    "{                                  \n"
+    "    int id = int(vertexTexCoord2.x);                      \n"
+    "    vec4 offsets = tileOffsets[id/2];                     \n"
+    "    fragTexCoord = vertexTexCoord + (((id%2) == 0)? offsets.xy : offsets.zw); \n"
+    "    fragColor = vertexColor;       \n"
+    "    gl_Position = mvp*vec4(vertexPosition, 1.0); \n"
+    "}                                  \n";
+    
+    char tilemapFShaderStr[] =
+    "#version 330                       \n"
+    "in vec2 fragTexCoord;              \n"
+    "in vec4 fragColor;                 \n"
+    "out vec4 finalColor;               \n"
+    "uniform sampler2D texture0;        \n"
+    "uniform vec4 colDiffuse;           \n"
+    "void main()                        \n"
+    "{                                  \n"
+    "    vec4 texelColor = texture(texture0, fragTexCoord);   \n"
+    "    if (texelColor.a == 0.0) discard;                    \n"
+    "    finalColor = texelColor*colDiffuse*fragColor;        \n"
+    "}                                  \n";
+    
+    cache.material.shader = LoadShaderCode(tilemapVShaderStr, tilemapFShaderStr);
+#else
+    cache.material.shader = GetShaderDefault();
+#endif
+    cache.tileset = tileset;
+    cache.material.maps[MAP_DIFFUSE].texture = tileset.texture;
+    cache.material.maps[MAP_DIFFUSE].color = WHITE;
+    
+    // NOTE: Tiles not animated keep a zero offset
+    cache.tileOffsets = (float *)calloc(MAX_ANIMATED_TILE_IDS*2, sizeof(float));
+    cache.tileOffsetsLoc = GetShaderLocation(cache.material.shader, "tileOffsets");
+    
+    if (cache.tileOffsetsLoc == -1) TraceLog(LOG_WARNING, "Tilemap shader not available, tiles animations applied on chunks texcoords (CPU)");
+    
+    TraceLog(LOG_INFO, "Tilemap render cache loaded successfully (%i chunks)", cache.chunkCountX*cache.chunkCountY);
+    
+    return cache;
+}
+
+// Unload tilemap render cache
+static void UnloadTilemapCache(TilemapCache cache)
+{
+    for (int i = 0; i < cache.loadedCount; i++)
+    {
+        rlUnloadMesh(&cache.chunks[cache.loaded[i]]);
+        free(cache.quadTiles[cache.loaded[i]]);
+    }
+    
+    if (cache.material.shader.id != GetShaderDefault().id) UnloadShader(cache.material.shader);
+    
+    free(cache.chunks);
+    free(cache.dirty);
+    free(cache.loaded);
+    free(cache.tileOffsets);
+    free(cache.quadTiles);
+    free(cache.visibility);
+}
+
+// Load tilemap chunk vertex data (static tiles quads) into RAM and VRAM
+// NOTE: Vertex positions are relative to tilemap origin, map.position is applied on drawing.
+// Layers are stored one after the other (ground, objects, overlay), drawing order is kept
+// inside the single chunk draw call, empty tiles (value -1) get no quad
+static void LoadTilemapChunk(Tilemap map, TilemapCache *cache, int cx, int cy)
+{
+    Mesh *chunk = &cache->chunks[cy*cache->chunkCountX + cx];
+    
+    // Loaded chunks are rebuilt (tiles modified), they are already registered as loaded
+    bool rebuild = (chunk->vertices != NULL);
+    
+    if (rebuild)
+    {
+        rlUnloadMesh(chunk);
+        memset(chunk, 0, sizeof(Mesh));
+        free(cache->quadTiles[cy*cache->chunkCountX + cx]);
+    }
+    
+    // Chunks at map borders could contain less tiles
+    int startX = cx*TILEMAP_CHUNK_SIZE;
+    int startY = cy*TILEMAP_CHUNK_SIZE;
+    int countX = ((startX + TILEMAP_CHUNK_SIZE) > map.tileCountX)? map.tileCountX - startX : TILEMAP_CHUNK_SIZE;
+    int countY = ((startY + TILEMAP_CHUNK_SIZE) > map.tileCountY)? map.tileCountY - startY : TILEMAP_CHUNK_SIZE;
+    
+    // NOTE: Tilemap is placed at the back (z < -1.0f), any element drawn later with rlgl batch (z from -1.0f)
+    // is placed over it, overlay layer is placed at the front (z = 0.5f), over any batch element.
+    // All layers depths are strictly inside projection depth range (no clipping planes ties)
+    const float layerDepth[TILEMAP_LAYERS] = { -1.5f, -1.25f, 0.5f };
+    
+    // First pass: count non-empty tiles
+    int quadCount = 0;
+    
+    for (int y = startY; y < (startY + countY); y++)
+    {
+        for (int x = startX; x < (startX + countX); x++)
+        {
+            Tile tile = map.tiles[y*map.tileCountX + x];
+            
+            if ((tile.value > 0) && (tile.value <= cache->tileset.tileCount)) quadCount++;
+            if ((tile.object > 0) && (tile.object <= cache->tileset.tileCount)) quadCount++;
+            if ((tile.overlay > 0) && (tile.overlay <= cache->tileset.tileCount)) quadCount++;
+        }
+    }
+    
+    // NOTE: Empty chunks keep a minimal allocation, vertex data marks the chunk as loaded
+    int allocCount = (quadCount > 0)? quadCount : 1;
+    
+    chunk->vertexCount = quadCount*4;
+    chunk->triangleCount = quadCount*2;
+    chunk->vertices = (float *)malloc(allocCount*4*3*sizeof(float));
+    chunk->texcoords = (float *)malloc(allocCount*4*2*sizeof(float));
+    chunk->texcoords2 = (float *)malloc(allocCount*4*2*sizeof(float));
+    chunk->indices = (unsigned short *)malloc(allocCount*6*sizeof(unsigned short));
+    
+    int *quadTiles = (int *)malloc(allocCount*sizeof(int));
+    
+    // Second pass: build quads, layer by layer
+    int k = 0;      // Quad counter inside chunk
+    
+    for (int layer = 0; layer < TILEMAP_LAYERS; layer++)
+    {
+        for (int y = startY; y < (startY + countY); y++)
+        {
+            for (int x = startX; x < (startX + countX); x++)
+            {
+                Tile tile = map.tiles[y*map.tileCountX + x];
+                int value = (layer == TILEMAP_LAYER_GROUND)? tile.value : 
+                            (layer == TILEMAP_LAYER_OBJECTS)? tile.object : tile.overlay;
+                
+                if ((value <= 0) || (value > cache->tileset.tileCount)) continue;     // Empty tile, no quad
+                
+                float px = (float)(x*map.tileSize);
+                float py = (float)(y*map.tileSize);
+                float pz = layerDepth[layer];
+                float *v = &chunk->vertices[k*12];
+                
+                v[0] = px; v[1] = py; v[2] = pz;
+                v[3] = px; v[4] = py + map.tileSize; v[5] = pz;
+                v[6] = px + map.tileSize; v[7] = py + map.tileSize; v[8] = pz;
+                v[9] = px + map.tileSize; v[10] = py; v[11] = pz;
+                
+                SetTileTexcoords(&chunk->texcoords[k*8], value, cache->tileset);
+                
+                // Tile id is stored in second texcoords, used by shader to get animation offset
+                // NOTE: Without tilemap shader, current animation offset is applied to texcoords
+                int id = (value < MAX_ANIMATED_TILE_IDS)? value : 0;
+                
+                for (int i = 0; i < 4; i++)
+                {
+                    chunk->texcoords2[k*8 + i*2] = (float)id;
+                    chunk->texcoords2[k*8 + i*2 + 1] = 0.0f;
+                    
+                    if (cache->tileOffsetsLoc == -1)
+                    {
+                        chunk->texcoords[k*8 + i*2] += cache->tileOffsets[id*2];
+                        chunk->texcoords[k*8 + i*2 + 1] += cache->tileOffsets[id*2 + 1];
+                    }
+                }
+                
+                chunk->indices[k*6] = k*4;
+                chunk->indices[k*6 + 1] = k*4 + 1;
+                chunk->indices[k*6 + 2] = k*4 + 2;
+                chunk->indices[k*6 + 3] = k*4;
+                chunk->indices[k*6 + 4] = k*4 + 2;
+                chunk->indices[k*6 + 5] = k*4 + 3;
+                
+                quadTiles[k] = y*map.tileCountX + x;
+                
+                k++;
+            }
+        }
+    }
+    
+    rlLoadMesh(chunk, false);   // Upload chunk vertex data to VRAM (static)
+    
+    cache->dirty[cy*cache->chunkCountX + cx] = false;
+    cache->quadTiles[cy*cache->chunkCountX + cx] = quadTiles;
+    cache->visibility[cy*cache->chunkCountX + cx] = -1;     // All quads drawn
+    
+    if (!rebuild)
+    {
+        cache->loaded[cache->loadedCount] = cy*cache->chunkCountX + cx;
+        cache->loadedCount++;
+    }
+}
+
+// Update tilemap chunk indices to draw only visible tiles quads
+// NOTE: Vertex data is not modified, only visible quads indices are uploaded (same buffer)
+static void UpdateTilemapChunkVisibility(TilemapCache *cache, int index, FieldOfView fov)
+{
+    Mesh *chunk = &cache->chunks[index];
+    int *quadTiles = cache->quadTiles[index];
+    int visibleCount = 0;
+    
+    for (int k = 0; k < chunk->vertexCount/4; k++)
+    {
+        if (fov.visible[quadTiles[k]/32] & (1u << (quadTiles[k]%32)))
+        {
+            chunk->indices[visibleCount*6] = k*4;
+            chunk->indices[visibleCount*6 + 1] = k*4 + 1;
+            chunk->indices[visibleCount*6 + 2] = k*4 + 2;
+            chunk->indices[visibleCount*6 + 3] = k*4;
+            chunk->indices[visibleCount*6 + 4] = k*4 + 2;
+            chunk->indices[visibleCount*6 + 5] = k*4 + 3;
+            
+            visibleCount++;
+        }
+    }
+    
+    chunk->triangleCount = visibleCount*2;
+    
+    if (visibleCount > 0) rlUpdateMesh(*chunk, 6, visibleCount*6);
+    
+    cache->visibility[index] = fov.version;
+}
+
+// Set tile layer value and mark its chunk for rebuild
+// NOTE: Chunk quads depend on non-empty tiles, chunk is rebuilt on next drawing
+static void SetTilemapTile(Tilemap map, TilemapCache cache, int x, int y, int layer, int value)
+{
+    if ((x < 0) || (x >= map.tileCountX) || (y < 0) || (y >= map.tileCountY)) return;
+    
+    switch (layer)
+    {
+        case TILEMAP_LAYER_GROUND: map.tiles[y*map.tileCountX + x].value = value; break;
+        case TILEMAP_LAYER_OBJECTS: map.tiles[y*map.tileCountX + x].object = value; break;
+        case TILEMAP_LAYER_OVERLAY: map.tiles[y*map.tileCountX + x].overlay = value; break;
+        default: break;
+    }
+    
+    // Chunks not loaded just get new tile value when loaded
+    cache.dirty[(y/TILEMAP_CHUNK_SIZE)*cache.chunkCountX + x/TILEMAP_CHUNK_SIZE] = true;
+}
+
+// Draw tilemap area visible in view (world coordinates)
+// NOTE: Only the tiles range intersecting the view is processed, one draw call per chunk,
+// drawing cost depends on view size, not on tilemap size. If a field of view is provided,
+// tiles out of view are not submitted (chunks indices are only updated when visibility changes)
+static void DrawTilemap(Tilemap map, TilemapCache *cache, Rectangle view, const FieldOfView *fov)
+{
+    rlglDraw();     // Draw any pending batch data first, keeping drawing order
+    
+    // Get visible tiles range (clamped to tilemap limits)
+    int startX = (int)floorf((float)(view.x - map.position.x)/map.tileSize);
+    int startY = (int)floorf((float)(view.y - map.position.y)/map.tileSize);
+    int endX = (int)floorf((float)(view.x + view.width - map.position.x)/map.tileSize);
+    int endY = (int)floorf((float)(view.y + view.height - map.position.y)/map.tileSize);
+    
+    if (startX < 0) startX = 0;
+    if (startY < 0) startY = 0;
+    if (endX > (map.tileCountX - 1)) endX = map.tileCountX - 1;
+    if (endY > (map.tileCountY - 1)) endY = map.tileCountY - 1;
+    
+    // Get visible chunks range
+    int chunkStartX = startX/TILEMAP_CHUNK_SIZE;
+    int chunkStartY = startY/TILEMAP_CHUNK_SIZE;
+    int chunkEndX = endX/TILEMAP_CHUNK_SIZE;
+    int chunkEndY = endY/TILEMAP_CHUNK_SIZE;
+    
+    // Unload chunks away from view
+    // NOTE: One chunk margin is kept to avoid reloading chunks when moving around chunks borders
+    for (int i = 0; i < cache->loadedCount;)
+    {
+        int cx = cache->loaded[i]%cache->chunkCountX;
+        int cy = cache->loaded[i]/cache->chunkCountX;
+        
+        if ((cx < (chunkStartX - 1)) || (cx > (chunkEndX + 1)) || (cy < (chunkStartY - 1)) || (cy > (chunkEndY + 1)))
+        {
+            rlUnloadMesh(&cache->chunks[cache->loaded[i]]);
+            memset(&cache->chunks[cache->loaded[i]], 0, sizeof(Mesh));
+            free(cache->quadTiles[cache->loaded[i]]);
+            cache->quadTiles[cache->loaded[i]] = NULL;
+            
+            cache->loadedCount--;
+            cache->loaded[i] = cache->loaded[cache->loadedCount];
+        }
+        else i++;
+    }
+    
+    if ((startX > endX) || (startY > endY)) return;     // Tilemap out of view
+    
+    Matrix transform = MatrixTranslate(map.position.x, map.position.y, 0.0f);
+    
+    // NOTE: Transparent tiles texels must not write depth (entities drawn later behind overlay layer),
+    // tilemap shader discards them by itself, alpha test covers default shader and software renderer
+    rlEnableAlphaTest();
+    
+    for (int cy = chunkStartY; cy <= chunkEndY; cy++)
+    {
+        for (int cx = chunkStartX; cx <= chunkEndX; cx++)
+        {
+            Mesh *chunk = &cache->chunks[cy*cache->chunkCountX + cx];
+            
+            // NOTE: Modified chunks are rebuilt, quads count could change
+            if ((chunk->vertices == NULL) || cache->dirty[cy*cache->chunkCountX + cx]) LoadTilemapChunk(map, cache, cx, cy);
+            
+            if ((fov != NULL) && (fov->version != cache->visibility[cy*cache->chunkCountX + cx])) UpdateTilemapChunkVisibility(cache, cy*cache->chunkCountX + cx, *fov);
+            
+            if (chunk->triangleCount > 0) rlDrawMesh(*chunk, cache->material, transform);
+        }
+    }
+    
+    rlDisableAlphaTest();
+}
+
+// Update tiles animations current frame
+// NOTE: Only tiles ids texcoords offsets are updated (one shader uniform array upload, two ids per vec4),
+// tilemap chunks are not modified, cost only depends on tileset size.
+// Without tilemap shader (OpenGL 1.1/2.1/ES2, software), loaded chunks animated tiles texcoords
+// are updated when any animation frame changes
+static void UpdateTilemapAnimations(TilemapCache cache, float time)
+{
+    int count = (cache.tileset.tileCount < MAX_ANIMATED_TILE_IDS)? cache.tileset.tileCount + 1 : MAX_ANIMATED_TILE_IDS;
+    bool changed = false;
+    
+    for (int id = 1; id < count; id++)
+    {
+        TileAnimation animation = cache.tileset.animations[id - 1];
+        
+        if (animation.frameCount == 0) continue;
+        
+        int frame = animation.frames[(int)(time/animation.frameTime)%animation.frameCount];
+        
+        // Offset from tile texcoords to current frame tile texcoords (same size tiles)
+        float offsetX = cache.tileset.texcoords[(frame - 1)*4] - cache.tileset.texcoords[(id - 1)*4];
+        float offsetY = cache.tileset.texcoords[(frame - 1)*4 + 1] - cache.tileset.texcoords[(id - 1)*4 + 1];
+        
+        if ((offsetX != cache.tileOffsets[id*2]) || (offsetY != cache.tileOffsets[id*2 + 1])) changed = true;
+        
+        cache.tileOffsets[id*2] = offsetX;
+        cache.tileOffsets[id*2 + 1] = offsetY;
+    }
+    
+    if (cache.tileOffsetsLoc != -1) SetShaderValueV(cache.material.shader, cache.tileOffsetsLoc, cache.tileOffsets, 4, (count + 1)/2);
+    else if (changed) UpdateTilemapAnimatedTexcoords(cache);
+}
+
+// Update loaded chunks animated tiles texcoords to current animation frame
+// NOTE: Only used without tilemap shader, quads tile id is read from second texcoords,
+// only chunks with animated tiles are uploaded again (texcoords buffer)
+static void UpdateTilemapAnimatedTexcoords(TilemapCache cache)
+{
+    for (int i = 0; i < cache.loadedCount; i++)
+    {
+        Mesh *chunk = &cache.chunks[cache.loaded[i]];
+        bool updated = false;
+        
+        for (int k = 0; k < chunk->vertexCount/4; k++)
+        {
+            int id = (int)chunk->texcoords2[k*8];
+            
+            if ((id == 0) || (cache.tileset.animations[id - 1].frameCount == 0)) continue;
+            
+            SetTileTexcoords(&chunk->texcoords[k*8], id, cache.tileset);
+            
+            for (int v = 0; v < 4; v++)
+            {
+                chunk->texcoords[k*8 + v*2] += cache.tileOffsets[id*2];
+                chunk->texcoords[k*8 + v*2 + 1] += cache.tileOffsets[id*2 + 1];
+            }
+            
+            updated = true;
+        }
+        
+        if (updated) rlUpdateMesh(*chunk, 1, chunk->vertexCount);
+    }
+}
+
+// 2D camera: scrolling and zoom
+//----------------------------------------------------------------------------------
+// Begin 2D mode with camera transform
+// NOTE: Camera transform is set as modelview matrix, projection (rlOrtho) is not modified
+static void BeginMode2D(Camera2D camera)
+{
+    rlglDraw();                         // Draw any pending batch data (previous transform)
+    rlLoadIdentity();                   // Reset current matrix (MODELVIEW)
+    
+    // Camera transform: move target to origin, apply zoom and move to screen offset
+    Matrix matOrigin = MatrixTranslate(-camera.target.x, -camera.target.y, 0.0f);
+    Matrix matScale = MatrixScale(camera.zoom, camera.zoom, 1.0f);
+    Matrix matTranslation = MatrixTranslate(camera.offset.x, camera.offset.y, 0.0f);
+    
+    rlMultMatrixf(MatrixToFloat(MatrixMultiply(MatrixMultiply(matOrigin, matScale), matTranslation)));
+}
+
+// End 2D mode, reset transform
+static void EndMode2D(void)
+{
+    rlglDraw();                         // Draw batch data using camera transform
+    rlLoadIdentity();                   // Reset current matrix (MODELVIEW)
+}
+
+// Get world area visible through camera (for a screen of provided size)
+static Rectangle GetCameraViewRec(Camera2D camera, int width, int height)
+{
+    Rectangle view = { 0 };
+    
+    // Screen to world: world = (screen - offset)/zoom + target
+    view.x = (int)floorf(camera.target.x - camera.offset.x/camera.zoom);
+    view.y = (int)floorf(camera.target.y - camera.offset.y/camera.zoom);
+    view.width = (int)ceilf(width/camera.zoom) + 1;
+    view.height = (int)ceilf(height/camera.zoom) + 1;
+    
+    return view;
+}
+
+// LESSON 07: Collision detection
+//----------------------------------------------------------------------------------
+// Load tileset colliders (collision shape code per tileset tile)
+// NOTE: Colliders file is a grid of codes matching the tileset image tiles grid
+static void LoadTilesetColliders(Tileset tileset, const char *fileName)
+{
+    int countX = 0;
+    int countY = 0;
+    int *codes = LoadTilemapText(fileName, &countX, &countY);
+    
+    for (int i = 0; i < tileset.tileCount; i++)
+    {
+        tileset.colliders[i] = 1;   // Walkable by default
+        
+        if ((codes == NULL) || (tileset.recs[i].width == 0)) continue;
+        
+        // Tile position in tileset grid, from tileset rectangles
+        int x = tileset.recs[i].x/tileset.recs[i].width;
+        int y = tileset.recs[i].y/tileset.recs[i].height;
+        
+        if ((x < countX) && (y < countY))
+        {
+            tileset.colliders[i] = codes[y*countX + x];
+            
+            if ((tileset.colliders[i] < 0) || (tileset.colliders[i] >= TILE_SHAPES))
+            {
+                TraceLog(LOG_WARNING, "[%s] Tile %i collider code not valid, considered solid", fileName, i + 1);
+                tileset.colliders[i] = 0;
+            }
+        }
+    }
+    
+    free(codes);
+    
+    TraceLog(LOG_INFO, "[%s] Tileset colliders loaded successfully", fileName);
+}
+
+// Get collision shapes of a tile (screen coordinates), returns shapes count
+// NOTE: Tile collider (tilemap) blocks the full tile, if not blocked, 
+// tile value and tile object collision shapes are considered (tileset)
+static int GetTileShapes(Tilemap map, Tileset tileset, int tileX, int tileY, Rectangle *shapes)
+{
+    Tile tile = map.tiles[tileY*map.tileCountX + tileX];
+    int posX = map.position.x + tileX*map.tileSize;
+    int posY = map.position.y + tileY*map.tileSize;
+    int count = 0;
+    
+    if (tile.collider == 0)
+    {
+        shapes[count] = (Rectangle){ posX, posY, map.tileSize, map.tileSize };
+        count++;
+    }
+    else
+    {
+        int layers[2] = { tile.value, tile.object };
+        
+        for (int i = 0; i < 2; i++)
+        {
+            if ((layers[i] <= 0) || (layers[i] > tileset.tileCount)) continue;
+            
+            Rectangle shape = tileShapes[tileset.colliders[layers[i] - 1]];
+            
+            if ((shape.width > 0) && (shape.height > 0))
+            {
+                // Shapes are defined for TILE_SHAPE_SIZE tiles, scaled to tilemap tile size
+                float scale = (float)map.tileSize/TILE_SHAPE_SIZE;
+                
+                shapes[count] = (Rectangle){ posX + shape.x*scale, posY + shape.y*scale, shape.width*scale, shape.height*scale };
+                count++;
+            }
+        }
+    }
+    
+    return count;
+}
+
+// Move collider box through tilemap, resolving collisions with tiles shapes
+// NOTE: Only the tiles under the box swept area are checked (constant cost for any tilemap size),
+// X and Y movements are resolved separately, it allows sliding along walls
+static Rectangle MoveTilemapCollider(Tilemap map, Tileset tileset, Rectangle box, int dx, int dy)
+{
+    Rectangle shapes[2] = { 0 };
+    
+    for (int axis = 0; axis < 2; axis++)
+    {
+        int delta = (axis == 0)? dx : dy;
+        
+        if (delta == 0) continue;
+        
+        // Swept area: box area covered along current axis movement
+        Rectangle swept = box;
+        
+        if (axis == 0)
+        {
+            if (delta < 0) swept.x += delta;
+            swept.width += abs(delta);
+        }
+        else
+        {
+            if (delta < 0) swept.y += delta;
+            swept.height += abs(delta);
+        }
+        
+        // Tiles range under swept area (clamped to tilemap limits)
+        int startX = (int)floorf((swept.x - map.position.x)/map.tileSize);
+        int startY = (int)floorf((swept.y - map.position.y)/map.tileSize);
+        int endX = (int)floorf((swept.x + swept.width - 1 - map.position.x)/map.tileSize);
+        int endY = (int)floorf((swept.y + swept.height - 1 - map.position.y)/map.tileSize);
+        
+        if (startX < 0) startX = 0;
+        if (startY < 0) startY = 0;
+        if (endX > (map.tileCountX - 1)) endX = map.tileCountX - 1;
+        if (endY > (map.tileCountY - 1)) endY = map.tileCountY - 1;
+        
+        for (int y = startY; y <= endY; y++)
+        {
+            for (int x = startX; x <= endX; x++)
+            {
+                int count = GetTileShapes(map, tileset, x, y, shapes);
+                
+                for (int i = 0; i < count; i++)
+                {
+                    Rectangle s = shapes[i];
+                    
+                    // NOTE: Only shapes in front of the box are considered, 
+                    // shapes already overlapping the box do not block it (box can get out)
+                    if (axis == 0)
+                    {
+                        if ((s.y >= (box.y + box.height)) || ((s.y + s.height) <= box.y)) continue;
+                        
+                        if ((delta > 0) && (s.x >= (box.x + box.width)) && ((box.x + box.width + delta) > s.x)) delta = s.x - (box.x + box.width);
+                        else if ((delta < 0) && ((s.x + s.width) <= box.x) && ((box.x + delta) < (s.x + s.width))) delta = (s.x + s.width) - box.x;
+                    }
+                    else
+                    {
+                        if ((s.x >= (box.x + box.width)) || ((s.x + s.width) <= box.x)) continue;
+                        
+                        if ((delta > 0) && (s.y >= (box.y + box.height)) && ((box.y + box.height + delta) > s.y)) delta = s.y - (box.y + box.height);
+                        else if ((delta < 0) && ((s.y + s.height) <= box.y) && ((box.y + delta) < (s.y + s.height))) delta = (s.y + s.height) - box.y;
+                    }
+                }
+            }
+        }
+        
+        if (axis == 0) box.x += delta;
+        else box.y += delta;
+    }
+    
+    return box;
+}
+
+// Monsters navigation (flow field)
+//----------------------------------------------------------------------------------
+// Load flow field data for a tilemap
+// NOTE: No target is defined, field is computed on first update
+static FlowField LoadFlowField(Tilemap map)
+{
+    FlowField field = { 0 };
+    
+    int tileCount = map.tileCountX*map.tileCountY;
+    
+    field.distance = (int *)malloc(tileCount*sizeof(int));
+    field.direction = (char *)malloc(tileCount*sizeof(char));
+    field.queue = (int *)malloc(tileCount*sizeof(int));
+    field.tileCountX = map.tileCountX;
+    field.tileCountY = map.tileCountY;
+    field.targetX = -1;
+    field.targetY = -1;
+    
+    return field;
+}
+
+// Unload flow field data
+static void UnloadFlowField(FlowField field)
+{
+    free(field.distance);
+    free(field.direction);
+    free(field.queue);
+}
+
+// Update flow field to reach target tile
+// NOTE: Field is only recomputed when target changes tile, it costs O(tiles)
+// but then any number of monsters can follow it with O(1) cost per monster
+static void UpdateFlowField(FlowField *field, Tilemap map, int targetX, int targetY)
+{
+    if ((targetX == field->targetX) && (targetY == field->targetY)) return;
+    if ((targetX < 0) || (targetX >= field->tileCountX) || (targetY < 0) || (targetY >= field->tileCountY)) return;
+    
+    field->targetX = targetX;
+    field->targetY = targetY;
+    
+    for (int i = 0; i < field->tileCountX*field->tileCountY; i++)
+    {
+        field->distance[i] = -1;
+        field->direction[i] = -1;
+    }
+    
+    // Breadth-first search from target tile through walkable tiles,
+    // every reached tile points back to the tile it was reached from
+    int head = 0;
+    int tail = 0;
+    
+    field->distance[targetY*field->tileCountX + targetX] = 0;
+    field->queue[tail++] = targetY*field->tileCountX + targetX;
+    
+    while (head < tail)
+    {
+        int current = field->queue[head++];
+        int x = current%field->tileCountX;
+        int y = current/field->tileCountX;
+        
+        for (int n = 0; n < 4; n++)
+        {
+            int nx = x + flowDirX[n];
+            int ny = y + flowDirY[n];
+            
+            if ((nx < 0) || (nx >= field->tileCountX) || (ny < 0) || (ny >= field->tileCountY)) continue;
+            
+            int next = ny*field->tileCountX + nx;
+            
+            if ((map.tiles[next].collider != 0) && (field->distance[next] == -1))
+            {
+                field->distance[next] = field->distance[current] + 1;
+                field->direction[next] = (n + 2)%4;     // Opposite direction, back to current tile
+                field->queue[tail++] = next;
+            }
+        }
+    }
+}
+
+// Get direction to follow from a tile to reach flow field target
+// NOTE: Returns { 0, 0 } if tile is the target or target can not be reached
+static Vector2 GetFlowFieldDirection(FlowField field, int tileX, int tileY)
+{
+    Vector2 direction = { 0.0f, 0.0f };
+    
+    if ((tileX >= 0) && (tileX < field.tileCountX) && (tileY >= 0) && (tileY < field.tileCountY))
+    {
+        int n = field.direction[tileY*field.tileCountX + tileX];
+        
+        if (n >= 0)
+        {
+            direction.x = (float)flowDirX[n];
+            direction.y = (float)flowDirY[n];
+        }
+    }
+    
+    return direction;
+}
+
+// Field of view (symmetric shadowcasting)
+//----------------------------------------------------------------------------------
+// Load field of view data for a tilemap
+// NOTE: No tile is visible until first update
+static FieldOfView LoadFieldOfView(Tilemap map, int radius)
+{
+    FieldOfView fov = { 0 };
+    
+    fov.tileCountX = map.tileCountX;
+    fov.tileCountY = map.tileCountY;
+    fov.visible = (unsigned int *)calloc((map.tileCountX*map.tileCountY + 31)/32, sizeof(unsigned int));
+    fov.originX = -1;
+    fov.originY = -1;
+    fov.radius = radius;
+    fov.version = 0;
+    
+    return fov;
+}
+
+// Unload field of view data
+static void UnloadFieldOfView(FieldOfView fov)
+{
+    free(fov.visible);
+}
+
+// Integer division rounding down (divisor must be positive)
+static int FloorDiv(int a, int b)
+{
+    return (a >= 0)? a/b : -((-a + b - 1)/b);
+}
+
+// Scan one row of a field of view quadrant, next rows are scanned recursively
+// NOTE: Quadrant rows go away from origin (depth), row tiles are columns between start and end slopes,
+// slopes are kept as fractions (numerator/denominator, denominator > 0) to get exact symmetric results
+static void ScanFieldOfView(FieldOfView *fov, Tilemap map, int quadrant, int depth, int startNum, int startDen, int endNum, int endDen)
+{
+    if (depth > fov->radius) return;
+    
+    // Row columns range: start slope rounded with ties up, end slope rounded with ties down
+    int minCol = FloorDiv(2*depth*startNum + startDen, 2*startDen);
+    int maxCol = -FloorDiv(-(2*depth*endNum - endDen), 2*endDen);
+    
+    int prevTile = -1;      // Previous tile in row: -1 -> none, 0 -> floor, 1 -> wall
+    
+    for (int col = minCol; col <= maxCol; col++)
+    {
+        // Quadrant tile to tilemap tile: north, south, east, west
+        int x = fov->originX;
+        int y = fov->originY;
+        
+        switch (quadrant)
+        {
+            case 0: x += col; y -= depth; break;
+            case 1: x += col; y += depth; break;
+            case 2: x += depth; y += col; break;
+            case 3: x -= depth; y += col; break;
+            default: break;
+        }
+        
+        bool inside = (x >= 0) && (x < map.tileCountX) && (y >= 0) && (y < map.tileCountY);
+        bool wall = !inside || (map.tiles[y*map.tileCountX + x].collider == 0);     // Tiles out of map block view
+        
+        // Walls are always revealed, floor tiles only if their center is inside the row slopes (symmetry)
+        bool symmetric = (col*startDen >= depth*startNum) && (col*endDen <= depth*endNum);
+        
+        if (inside && (wall || symmetric) && ((col*col + depth*depth) <= (fov->radius*fov->radius + fov->radius)))
+        {
+            fov->visible[(y*map.tileCountX + x)/32] |= (1u << ((y*map.tileCountX + x)%32));
+        }
+        
+        // Wall to floor: next rows start at floor tile left edge
+        if ((prevTile == 1) && !wall)
+        {
+            startNum = 2*col - 1;
+            startDen = 2*depth;
+        }
+        
+        // Floor to wall: scan next rows until wall tile left edge
+        if ((prevTile == 0) && wall) ScanFieldOfView(fov, map, quadrant, depth + 1, startNum, startDen, 2*col - 1, 2*depth);
+        
+        prevTile = wall? 1 : 0;
+    }
+    
+    if (prevTile == 0) ScanFieldOfView(fov, map, quadrant, depth + 1, startNum, startDen, endNum, endDen);
+}
+
+// Update visible tiles from origin tile
+// NOTE: Visibility is only computed if origin tile changed, tiles with collider 0 block view
+static void UpdateFieldOfView(FieldOfView *fov, Tilemap map, int originX, int originY)
+{
+    if ((originX == fov->originX) && (originY == fov->originY)) return;
+    if ((originX < 0) || (originX >= map.tileCountX) || (originY < 0) || (originY >= map.tileCountY)) return;
+    
+    fov->originX = originX;
+    fov->originY = originY;
+    
+    memset(fov->visible, 0, ((fov->tileCountX*fov->tileCountY + 31)/32)*sizeof(unsigned int));
+    
+    // Origin tile is always visible, every quadrant is scanned from first row (slopes -1 to 1)
+    fov->visible[(originY*map.tileCountX + originX)/32] |= (1u << ((originY*map.tileCountX + originX)%32));
+    
+    for (int quadrant = 0; quadrant < 4; quadrant++) ScanFieldOfView(fov, map, quadrant, 1, -1, 1, 1, 1);
+    
+    fov->version++;
+}
+
+// Check if a tile is visible
+static bool IsTileVisible(FieldOfView fov, int tileX, int tileY)
+{
+    if ((tileX < 0) || (tileX >= fov.tileCountX) || (tileY < 0) || (tileY >= fov.tileCountY)) return false;
+    
+    return (fov.visible[(tileY*fov.tileCountX + tileX)/32] & (1u << ((tileY*fov.tileCountX + tileX)%32))) != 0;
+}
+
+// Entities (structure of arrays)
+//----------------------------------------------------------------------------------
+// Load entities storage: all components arrays are allocated once
+static Entities LoadEntities(int capacity)
+{
+    Entities entities = { 0 };
+    
+    entities.positionX = (float *)calloc(capacity, sizeof(float));
+    entities.positionY = (float *)calloc(capacity, sizeof(float));
+    entities.velocityX = (float *)calloc(capacity, sizeof(float));
+    entities.velocityY = (float *)calloc(capacity, sizeof(float));
+    entities.width = (float *)calloc(capacity, sizeof(float));
+    entities.height = (float *)calloc(capacity, sizeof(float));
+    entities.speed = (float *)calloc(capacity, sizeof(float));
+    entities.sprite = (int *)calloc(capacity, sizeof(int));
+    entities.color = (Color *)calloc(capacity, sizeof(Color));
+    entities.flags = (unsigned int *)calloc(capacity, sizeof(unsigned int));
+    entities.freeIds = (int *)malloc(capacity*sizeof(int));
+    entities.freeCount = 0;
+    entities.count = 0;
+    entities.capacity = capacity;
+    
+    return entities;
+}
+
+// Unload entities storage
+static void UnloadEntities(Entities entities)
+{
+    free(entities.positionX);
+    free(entities.positionY);
+    free(entities.velocityX);
+    free(entities.velocityY);
+    free(entities.width);
+    free(entities.height);
+    free(entities.speed);
+    free(entities.sprite);
+    free(entities.color);
+    free(entities.flags);
+    free(entities.freeIds);
+}
+
+// Create entity with provided flags and AABB
+// NOTE: Destroyed entities ids are reused first, used ids range only grows if there are no free ids
+static int CreateEntity(Entities *entities, unsigned int flags, Rectangle box)
+{
+    int id = -1;
+    
+    if (entities->freeCount > 0)
+    {
+        entities->freeCount--;
+        id = entities->freeIds[entities->freeCount];
+    }
+    else if (entities->count < entities->capacity)
+    {
+        id = entities->count;
+        entities->count++;
+    }
+    else
+    {
+        TraceLog(LOG_WARNING, "[ENTITIES] Entities storage is full (%i)", entities->capacity);
+        return -1;
+    }
+    
+    entities->positionX[id] = box.x;
+    entities->positionY[id] = box.y;
+    entities->velocityX[id] = 0.0f;
+    entities->velocityY[id] = 0.0f;
+    entities->width[id] = box.width;
+    entities->height[id] = box.height;
+    entities->speed[id] = 0.0f;
+    entities->sprite[id] = -1;
+    entities->color[id] = WHITE;
+    entities->flags[id] = flags | ENTITY_ACTIVE;
+    
+    return id;
+}
+
+// Destroy entity
+// NOTE: Velocity is reset, movement system can move destroyed entities without checking flags
+static void DestroyEntity(Entities *entities, int id)
+{
+    if ((id < 0) || (id >= entities->count) || !(entities->flags[id] & ENTITY_ACTIVE)) return;
+    
+    entities->flags[id] = 0;
+    entities->velocityX[id] = 0.0f;
+    entities->velocityY[id] = 0.0f;
+    
+    entities->freeIds[entities->freeCount] = id;
+    entities->freeCount++;
+}
+
+// Get entity AABB
+static Rectangle GetEntityRec(Entities entities, int id)
+{
+    return (Rectangle){ entities.positionX[id], entities.positionY[id], entities.width[id], entities.height[id] };
+}
+
+// Create item entities for tilemap objects layer tiles
+// NOTE: Tilemap keeps drawing and colliding objects tiles, entity sprite is the object tile id
+static void LoadTilemapEntities(Entities *entities, Tilemap map)
+{
+    for (int y = 0; y < map.tileCountY; y++)
+    {
+        for (int x = 0; x < map.tileCountX; x++)
+        {
+            int object = map.tiles[y*map.tileCountX + x].object;
+            
+            if (object <= 0) continue;      // Empty tile (-1) or not valid tile id
+            
+            int id = CreateEntity(entities, ENTITY_ITEM | ENTITY_TILE, (Rectangle){ map.position.x + x*map.tileSize, 
+                                  map.position.y + y*map.tileSize, map.tileSize, map.tileSize });
+            
+            if (id >= 0) entities->sprite[id] = object;
+        }
+    }
+}
+
+// Create monster entity at a random walkable tile (8x8 tinted box, random speed)
+// NOTE: Random attempts are bounded, then next walkable tile is scanned (no monster if map has none)
+static int SpawnMonster(Entities *entities, Tilemap map)
+{
+    int tilesCount = map.tileCountX*map.tileCountY;
+    int tile = rand()%tilesCount;
+    
+    for (int i = 0; (i < tilesCount) && (map.tiles[tile].collider == 0); i++) tile = rand()%tilesCount;
+    
+    for (int i = 0; (i < tilesCount) && (map.tiles[tile].collider == 0); i++) tile = (tile + 1)%tilesCount;
+    
+    if (map.tiles[tile].collider == 0) return -1;
+    
+    int id = CreateEntity(entities, ENTITY_MONSTER, (Rectangle){ map.position.x + (tile%map.tileCountX + 0.5f)*map.tileSize - 4, 
+                                                                 map.position.y + (tile/map.tileCountX + 0.5f)*map.tileSize - 4, 8, 8 });
+    
+    if (id >= 0)
+    {
+        entities->speed[id] = 0.25f + (float)(rand()%100)/100.0f;
+        entities->color[id] = (Color){ 200 + rand()%56, rand()%100, rand()%100, 255 };
+    }
+    
+    return id;
+}
+
+// Update entities position from velocity
+// NOTE: Dense loop over all used ids, no branches (destroyed entities have no velocity)
+static void UpdateEntitiesMovement(Entities entities)
+{
+    for (int i = 0; i < entities.count; i++)
+    {
+        entities.positionX[i] += entities.velocityX[i];
+        entities.positionY[i] += entities.velocityY[i];
+    }
+}
+
+// Update monsters velocity following flow field
+// NOTE: Monster moves towards next tile center at its max speed, it avoids cutting walls corners
+static void UpdateMonstersVelocity(Entities entities, FlowField field, Tilemap map)
+{
+    for (int i = 0; i < entities.count; i++)
+    {
+        if (!(entities.flags[i] & ENTITY_MONSTER)) continue;
+        
+        float centerX = entities.positionX[i] + entities.width[i]/2;
+        float centerY = entities.positionY[i] + entities.height[i]/2;
+        int tileX = (int)(centerX - map.position.x)/map.tileSize;
+        int tileY = (int)(centerY - map.position.y)/map.tileSize;
+        
+        Vector2 direction = GetFlowFieldDirection(field, tileX, tileY);
+        
+        float deltaX = map.position.x + (tileX + direction.x + 0.5f)*map.tileSize - centerX;
+        float deltaY = map.position.y + (tileY + direction.y + 0.5f)*map.tileSize - centerY;
+        float length = sqrtf(deltaX*deltaX + deltaY*deltaY);
+        
+        if (length > entities.speed[i])
+        {
+            deltaX *= entities.speed[i]/length;
+            deltaY *= entities.speed[i]/length;
+        }
+        
+        entities.velocityX[i] = deltaX;
+        entities.velocityY[i] = deltaY;
+    }
+}
+
+// Draw entities in field of view
+// NOTE: Entities with sprite are drawn in a tileset sprites batch, entities without sprite in a default
+// texture batch (1x1 white pixel) as tinted boxes. Player and tilemap objects are not drawn here
+static void DrawEntities(Entities entities, Tilemap map, Tileset tileset, FieldOfView fov)
+{
+    const unsigned int skipFlags = ENTITY_PLAYER | ENTITY_TILE;
+    
+    for (int pass = 0; pass < 2; pass++)
+    {
+        SpriteBatch batch = BeginSpriteBatch((pass == 0)? tileset.texture : GetTextureDefault());
+        
+        for (int i = 0; i < entities.count; i++)
+        {
+            if (!(entities.flags[i] & ENTITY_ACTIVE) || (entities.flags[i] & skipFlags)) continue;
+            if ((pass == 0) != (entities.sprite[i] >= 0)) continue;
+            
+            // NOTE: Sprite is a tileset tile id (from 1 to tileCount), not valid ids are not drawn
+            if ((pass == 0) && ((entities.sprite[i] <= 0) || (entities.sprite[i] > tileset.tileCount))) continue;
+            
+            int tileX = (int)(entities.positionX[i] + entities.width[i]/2 - map.position.x)/map.tileSize;
+            int tileY = (int)(entities.positionY[i] + entities.height[i]/2 - map.position.y)/map.tileSize;
+            
+            if (!IsTileVisible(fov, tileX, tileY)) continue;
+            
+            Rectangle source = (pass == 0)? tileset.recs[entities.sprite[i] - 1] : (Rectangle){ 0, 0, 1, 1 };
+            
+            DrawSprite(batch, source, GetEntityRec(entities, i), (Vector2){ 0, 0 }, 0.0f, entities.color[i]);
+        }
+        
+        EndSpriteBatch();
+    }
+}
+
+// Entities spatial hash (uniform grid, tile cells)
+//----------------------------------------------------------------------------------
+// Load spatial hash for entities
+// NOTE: Buckets counter must be a power of two, cells are not limited to tilemap area
+static SpatialHash LoadSpatialHash(int capacity, float cellSize, Vector2 origin, int bucketCount)
+{
+    SpatialHash hash = { 0 };
+    
+    hash.buckets = (int *)malloc(bucketCount*sizeof(int));
+    hash.next = (int *)malloc(capacity*sizeof(int));
+    hash.prev = (int *)malloc(capacity*sizeof(int));
+    hash.bucket = (int *)malloc(capacity*sizeof(int));
+    hash.cellX = (int *)calloc(capacity, sizeof(int));
+    hash.cellY = (int *)calloc(capacity, sizeof(int));
+    hash.bucketCount = bucketCount;
+    hash.capacity = capacity;
+    hash.cellSize = cellSize;
+    hash.origin = origin;
+    hash.maxExtent = 0.0f;
+    
+    for (int i = 0; i < bucketCount; i++) hash.buckets[i] = -1;
+    for (int i = 0; i < capacity; i++) hash.bucket[i] = -1;
+    
+    return hash;
+}
+
+// Unload spatial hash data
+static void UnloadSpatialHash(SpatialHash hash)
+{
+    free(hash.buckets);
+    free(hash.next);
+    free(hash.prev);
+    free(hash.bucket);
+    free(hash.cellX);
+    free(hash.cellY);
+}
+
+// Get cell bucket (cell coordinates hash)
+static int GetSpatialHashBucket(SpatialHash hash, int cellX, int cellY)
+{
+    return (int)(((unsigned int)cellX*73856093u ^ (unsigned int)cellY*19349663u) & (unsigned int)(hash.bucketCount - 1));
+}
+
+// Update entities cells
+// NOTE: Only entities changing cell are unlinked from previous bucket and linked to the new one,
+// destroyed entities are removed, O(1) per moved entity
+static void UpdateSpatialHash(SpatialHash *hash, Entities entities)
+{
+    int count = (entities.count < hash->capacity)? entities.count : hash->capacity;
+    
+    for (int i = 0; i < count; i++)
+    {
+        bool active = (entities.flags[i] & ENTITY_ACTIVE);
+        int cellX = (int)floorf((entities.positionX[i] + entities.width[i]/2 - hash->origin.x)/hash->cellSize);
+        int cellY = (int)floorf((entities.positionY[i] + entities.height[i]/2 - hash->origin.y)/hash->cellSize);
+        
+        if (active && (hash->bucket[i] >= 0) && (cellX == hash->cellX[i]) && (cellY == hash->cellY[i])) continue;
+        
+        // Unlink entity from previous bucket
+        if (hash->bucket[i] >= 0)
+        {
+            if (hash->prev[i] >= 0) hash->next[hash->prev[i]] = hash->next[i];
+            else hash->buckets[hash->bucket[i]] = hash->next[i];
+            
+            if (hash->next[i] >= 0) hash->prev[hash->next[i]] = hash->prev[i];
+            
+            hash->bucket[i] = -1;
+        }
+        
+        if (!active) continue;
+        
+        // Link entity at new bucket start
+        int bucket = GetSpatialHashBucket(*hash, cellX, cellY);
+        
+        hash->prev[i] = -1;
+        hash->next[i] = hash->buckets[bucket];
+        if (hash->buckets[bucket] >= 0) hash->prev[hash->buckets[bucket]] = i;
+        hash->buckets[bucket] = i;
+        
+        hash->bucket[i] = bucket;
+        hash->cellX[i] = cellX;
+        hash->cellY[i] = cellY;
+        
+        if (entities.width[i]/2 > hash->maxExtent) hash->maxExtent = entities.width[i]/2;
+        if (entities.height[i]/2 > hash->maxExtent) hash->maxExtent = entities.height[i]/2;
+    }
+}
+
+// Get entities overlapping rectangle (AABB), results are stored in provided buffer
+// NOTE: Cells range is expanded by max entity half size (entities are stored by center),
+// buckets entities from other cells (hash collisions) are skipped
+static int QuerySpatialHashRec(SpatialHash hash, Entities entities, Rectangle rec, int *results, int maxResults)
+{
+    int minCellX = (int)floorf((rec.x - hash.maxExtent - hash.origin.x)/hash.cellSize);
+    int minCellY = (int)floorf((rec.y - hash.maxExtent - hash.origin.y)/hash.cellSize);
+    int maxCellX = (int)floorf((rec.x + rec.width + hash.maxExtent - hash.origin.x)/hash.cellSize);
+    int maxCellY = (int)floorf((rec.y + rec.height + hash.maxExtent - hash.origin.y)/hash.cellSize);
+    int count = 0;
+    
+    for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+    {
+        for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+        {
+            for (int i = hash.buckets[GetSpatialHashBucket(hash, cellX, cellY)]; i >= 0; i = hash.next[i])
+            {
+                if ((hash.cellX[i] != cellX) || (hash.cellY[i] != cellY)) continue;
+                
+                if ((entities.positionX[i] < (rec.x + rec.width)) && ((entities.positionX[i] + entities.width[i]) > rec.x) &&
+                    (entities.positionY[i] < (rec.y + rec.height)) && ((entities.positionY[i] + entities.height[i]) > rec.y))
+                {
+                    if (count >= maxResults) return count;
+                    
+                    results[count] = i;
+                    count++;
+                }
+            }
+        }
+    }
+    
+    return count;
+}
+
+// Get entities in range (AABB closest point inside circle), results are stored in provided buffer
+static int QuerySpatialHashRange(SpatialHash hash, Entities entities, Vector2 center, float radius, int *results, int maxResults)
+{
+    int minCellX = (int)floorf((center.x - radius - hash.maxExtent - hash.origin.x)/hash.cellSize);
+    int minCellY = (int)floorf((center.y - radius - hash.maxExtent - hash.origin.y)/hash.cellSize);
+    int maxCellX = (int)floorf((center.x + radius + hash.maxExtent - hash.origin.x)/hash.cellSize);
+    int maxCellY = (int)floorf((center.y + radius + hash.maxExtent - hash.origin.y)/hash.cellSize);
+    int count = 0;
+    
+    for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+    {
+        for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+        {
+            for (int i = hash.buckets[GetSpatialHashBucket(hash, cellX, cellY)]; i >= 0; i = hash.next[i])
+            {
+                if ((hash.cellX[i] != cellX) || (hash.cellY[i] != cellY)) continue;
+                
+                float closestX = fminf(fmaxf(center.x, entities.positionX[i]), entities.positionX[i] + entities.width[i]);
+                float closestY = fminf(fmaxf(center.y, entities.positionY[i]), entities.positionY[i] + entities.height[i]);
+                float dx = closestX - center.x;
+                float dy = closestY - center.y;
+                
+                if ((dx*dx + dy*dy) <= radius*radius)
+                {
+                    if (count >= maxResults) return count;
+                    
+                    results[count] = i;
+                    count++;
+                }
+            }
+        }
+    }
+    
+    return count;
+}
+
+#if defined(ENTITIES_BENCHMARK)
+// Log entities update systems time per frame (monsters velocity from flow field and movement)
+// NOTE: Monsters are spawned at random walkable tiles of the game tilemap, flow field target is tile (1, 1)
+static void BenchmarkEntities(FlowField *field, Tilemap map, int entitiesCount)
+{
+    #define BENCHMARK_FRAMES    100
+    #define BENCHMARK_BUDGET    1.0     // Entities update systems time budget per frame (ms)
+    
+    Entities entities = LoadEntities(entitiesCount);
+    
+    for (int i = 0; i < entitiesCount; i++) SpawnMonster(&entities, map);
+    
+    UpdateFlowField(field, map, 1, 1);
+    
+    double velocityTime = 0.0;
+    double movementTime = 0.0;
+    double maxFrameTime = 0.0;
+    
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++)
+    {
+        double time = glfwGetTime();
+        UpdateMonstersVelocity(entities, *field, map);
+        double velocityEnd = glfwGetTime();
+        UpdateEntitiesMovement(entities);
+        double movementEnd = glfwGetTime();
+        
+        velocityTime += velocityEnd - time;
+        movementTime += movementEnd - velocityEnd;
+        if ((movementEnd - time) > maxFrameTime) maxFrameTime = movementEnd - time;
+    }
+    
+    double frameTime = (velocityTime + movementTime)*1000.0/BENCHMARK_FRAMES;
+    
+    TraceLog(LOG_INFO, "[ENTITIES] %i entities: velocity %.3f ms, movement %.3f ms, frame avg %.3f ms, max %.3f ms (budget %.1f ms)", entities.count, 
+             velocityTime*1000.0/BENCHMARK_FRAMES, movementTime*1000.0/BENCHMARK_FRAMES, frameTime, maxFrameTime*1000.0, BENCHMARK_BUDGET);
+    
+    UnloadEntities(entities);
+    
+    // NOTE: LOG_ERROR exits program, benchmark builds fail on performance regressions
+    if (frameTime > BENCHMARK_BUDGET) TraceLog(LOG_ERROR, "[ENTITIES] Update systems over budget: %.3f ms (budget %.1f ms)", frameTime, BENCHMARK_BUDGET);
+}
+#endif
+
+#if defined(SPATIAL_HASH_BENCHMARK)
+// Log spatial hash update and queries throughput
+// NOTE: Entities (8x8) are spread over a 512x512 tiles area (32 pixels cells), every entity moves
+// a random amount every update, queries are centered at random entities
+static void BenchmarkSpatialHash(int entitiesCount)
+{
+    #define BENCHMARK_QUERIES   10000
+    
+    Entities entities = LoadEntities(entitiesCount);
+    SpatialHash hash = LoadSpatialHash(entitiesCount, 32.0f, (Vector2){ 0, 0 }, 65536);
+    int *results = (int *)malloc(entitiesCount*sizeof(int));
+    
+    for (int i = 0; i < entitiesCount; i++) CreateEntity(&entities, ENTITY_MONSTER, (Rectangle){ (float)(rand()%16384), (float)(rand()%16384), 8, 8 });
+    
+    double time = glfwGetTime();
+    UpdateSpatialHash(&hash, entities);
+    double insertTime = glfwGetTime() - time;
+    
+    for (int i = 0; i < entitiesCount; i++)
+    {
+        entities.velocityX[i] = (float)(rand()%9 - 4);
+        entities.velocityY[i] = (float)(rand()%9 - 4);
+    }
+    
+    UpdateEntitiesMovement(entities);
+    
+    time = glfwGetTime();
+    UpdateSpatialHash(&hash, entities);
+    double updateTime = glfwGetTime() - time;
+    
+    int rangeResults = 0;
+    int recResults = 0;
+    
+    time = glfwGetTime();
+    for (int q = 0; q < BENCHMARK_QUERIES; q++)
+    {
+        int id = rand()%entitiesCount;
+        rangeResults += QuerySpatialHashRange(hash, entities, (Vector2){ entities.positionX[id], entities.positionY[id] }, 64.0f, results, entitiesCount);
+    }
+    double rangeTime = glfwGetTime() - time;
+    
+    time = glfwGetTime();
+    for (int q = 0; q < BENCHMARK_QUERIES; q++)
+    {
+        int id = rand()%entitiesCount;
+        recResults += QuerySpatialHashRec(hash, entities, (Rectangle){ entities.positionX[id] - 32, entities.positionY[id] - 32, 64, 64 }, results, entitiesCount);
+    }
+    double recTime = glfwGetTime() - time;
+    
+    TraceLog(LOG_INFO, "[SPATIAL HASH] %i entities: insert %.3f ms, update %.3f ms", entitiesCount, insertTime*1000.0, updateTime*1000.0);
+    TraceLog(LOG_INFO, "[SPATIAL HASH] %i entities: range queries %.0f/s (%.1f results), rec queries %.0f/s (%.1f results)", entitiesCount, 
+             BENCHMARK_QUERIES/rangeTime, (float)rangeResults/BENCHMARK_QUERIES, BENCHMARK_QUERIES/recTime, (float)recResults/BENCHMARK_QUERIES);
+    
+    free(results);
+    UnloadSpatialHash(hash);
+    UnloadEntities(entities);
+}
+#endif
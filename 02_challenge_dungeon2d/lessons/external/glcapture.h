@@ -0,0 +1,1609 @@
+/**********************************************************************************************
+*
+*   glcapture - OpenGL calls capture and replay (binary trace)
+*
+*   Capture mode hooks GLAD function pointers: every OpenGL call issued by the program (and all
+*   buffers/textures data uploaded) is recorded into a compact binary trace for some frames.
+*   Trace can be replayed later against any OpenGL 3.3 context (i.e. Mesa llvmpipe), without
+*   game logic or inputs involved, useful for reproducible offline rendering benchmarks.
+*
+*   CONFIGURATION:
+*
+*   #define GLCAPTURE_IMPLEMENTATION
+*       Generates the implementation of the library into the included file.
+*       If not defined, the library is in header only mode and can be included in other headers
+*       or source files without problems. But only ONE file should hold the implementation.
+*
+*   #define GLCAPTURE_LOG(...)
+*       Define to redirect library messages (i.e. to TraceLog()), printf() used by default.
+*
+*   DEPENDENCIES:
+*       glad.h - OpenGL extensions loader, MUST be included before this header
+*
+*   TRACE FORMAT (little-endian):
+*       Header:     "GLTR", version, width, height, frames count, calls count (32 bit each)
+*       Call:       call id (8 bit) + arguments (32 bit words, sizes/offsets/doubles use 64 bit)
+*       Data block: size (32 bit, GLCAPTURE_NULL_DATA for NULL pointers) + bytes (4 byte aligned)
+*       Frame end:  GLCALL_FRAME call id (no arguments)
+*       NOTE: Words are encoded byte by byte (same trace on any host), data blocks bytes are stored
+*       as passed to OpenGL (vertex/pixels data keep host byte order)
+*
+*   LIMITATIONS:
+*       - Capture must start before any OpenGL resource is created (replay needs all of them)
+*       - Persistent mapped buffers writes can not be observed (capture requires unmapping)
+*       - Client-side vertex arrays are not captured, attrib/index pointers recorded as offsets
+*       - Queries (glGet*) are not recorded, except uniform/attrib locations (remapped on replay)
+*         and textures readbacks (glGetTexImage, pixels not recorded, same as glReadPixels)
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2019 Ramon Santamaria (@raysan5)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+#ifndef GLCAPTURE_H
+#define GLCAPTURE_H
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GLCAPTURE_VERSION           1
+#define GLCAPTURE_NULL_DATA         0xFFFFFFFF      // Data block size for NULL pointers
+#define GLCAPTURE_MAX_MAPPINGS      4               // Maximum buffers mapped at the same time
+#define GLCAPTURE_MAX_ATTRIBS       16              // Maximum vertex attribs locations remapped
+
+// OpenGL captured functions list: X(Name, NAME)
+// NOTE: Call id is the position on the list (GLCALL_FRAME = 0), append new functions at the end
+#define GLCAPTURE_CALLS(X) \
+    X(ActiveTexture, ACTIVETEXTURE) \
+    X(AttachShader, ATTACHSHADER) \
+    X(BindAttribLocation, BINDATTRIBLOCATION) \
+    X(BindBuffer, BINDBUFFER) \
+    X(BindFramebuffer, BINDFRAMEBUFFER) \
+    X(BindRenderbuffer, BINDRENDERBUFFER) \
+    X(BindTexture, BINDTEXTURE) \
+    X(BindVertexArray, BINDVERTEXARRAY) \
+    X(BlendFunc, BLENDFUNC) \
+    X(BufferData, BUFFERDATA) \
+    X(BufferStorage, BUFFERSTORAGE) \
+    X(BufferSubData, BUFFERSUBDATA) \
+    X(Clear, CLEAR) \
+    X(ClearColor, CLEARCOLOR) \
+    X(ClearDepth, CLEARDEPTH) \
+    X(ClientWaitSync, CLIENTWAITSYNC) \
+    X(CompileShader, COMPILESHADER) \
+    X(CompressedTexImage2D, COMPRESSEDTEXIMAGE2D) \
+    X(CreateProgram, CREATEPROGRAM) \
+    X(CreateShader, CREATESHADER) \
+    X(CullFace, CULLFACE) \
+    X(DeleteBuffers, DELETEBUFFERS) \
+    X(DeleteFramebuffers, DELETEFRAMEBUFFERS) \
+    X(DeleteProgram, DELETEPROGRAM) \
+    X(DeleteRenderbuffers, DELETERENDERBUFFERS) \
+    X(DeleteShader, DELETESHADER) \
+    X(DeleteSync, DELETESYNC) \
+    X(DeleteTextures, DELETETEXTURES) \
+    X(DeleteVertexArrays, DELETEVERTEXARRAYS) \
+    X(DepthFunc, DEPTHFUNC) \
+    X(DetachShader, DETACHSHADER) \
+    X(Disable, DISABLE) \
+    X(DisableVertexAttribArray, DISABLEVERTEXATTRIBARRAY) \
+    X(DrawArrays, DRAWARRAYS) \
+    X(DrawElements, DRAWELEMENTS) \
+    X(DrawElementsBaseVertex, DRAWELEMENTSBASEVERTEX) \
+    X(Enable, ENABLE) \
+    X(EnableVertexAttribArray, ENABLEVERTEXATTRIBARRAY) \
+    X(FenceSync, FENCESYNC) \
+    X(FramebufferRenderbuffer, FRAMEBUFFERRENDERBUFFER) \
+    X(FramebufferTexture2D, FRAMEBUFFERTEXTURE2D) \
+    X(FrontFace, FRONTFACE) \
+    X(GenBuffers, GENBUFFERS) \
+    X(GenFramebuffers, GENFRAMEBUFFERS) \
+    X(GenRenderbuffers, GENRENDERBUFFERS) \
+    X(GenTextures, GENTEXTURES) \
+    X(GenVertexArrays, GENVERTEXARRAYS) \
+    X(GenerateMipmap, GENERATEMIPMAP) \
+    X(GetAttribLocation, GETATTRIBLOCATION) \
+    X(GetUniformLocation, GETUNIFORMLOCATION) \
+    X(Hint, HINT) \
+    X(LinkProgram, LINKPROGRAM) \
+    X(MapBuffer, MAPBUFFER) \
+    X(MapBufferRange, MAPBUFFERRANGE) \
+    X(PixelStorei, PIXELSTOREI) \
+    X(PolygonMode, POLYGONMODE) \
+    X(ReadPixels, READPIXELS) \
+    X(RenderbufferStorage, RENDERBUFFERSTORAGE) \
+    X(ShaderSource, SHADERSOURCE) \
+    X(TexImage2D, TEXIMAGE2D) \
+    X(TexParameterf, TEXPARAMETERF) \
+    X(TexParameteri, TEXPARAMETERI) \
+    X(TexParameteriv, TEXPARAMETERIV) \
+    X(TexSubImage2D, TEXSUBIMAGE2D) \
+    X(Uniform1f, UNIFORM1F) \
+    X(Uniform1fv, UNIFORM1FV) \
+    X(Uniform1i, UNIFORM1I) \
+    X(Uniform1iv, UNIFORM1IV) \
+    X(Uniform2fv, UNIFORM2FV) \
+    X(Uniform2iv, UNIFORM2IV) \
+    X(Uniform3fv, UNIFORM3FV) \
+    X(Uniform3iv, UNIFORM3IV) \
+    X(Uniform4f, UNIFORM4F) \
+    X(Uniform4fv, UNIFORM4FV) \
+    X(Uniform4iv, UNIFORM4IV) \
+    X(UniformMatrix4fv, UNIFORMMATRIX4FV) \
+    X(UnmapBuffer, UNMAPBUFFER) \
+    X(UseProgram, USEPROGRAM) \
+    X(VertexAttrib2f, VERTEXATTRIB2F) \
+    X(VertexAttrib3f, VERTEXATTRIB3F) \
+    X(VertexAttrib4f, VERTEXATTRIB4F) \
+    X(VertexAttribPointer, VERTEXATTRIBPOINTER) \
+    X(Viewport, VIEWPORT) \
+    X(GetTexImage, GETTEXIMAGE)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Captured calls ids
+typedef enum {
+    GLCALL_FRAME = 0,               // Frame end marker (not an OpenGL call)
+#define GLCAPTURE_CALL_ID(name, upper) GLCALL_##upper,
+    GLCAPTURE_CALLS(GLCAPTURE_CALL_ID)
+#undef GLCAPTURE_CALL_ID
+    GLCALL_COUNT
+} GlCall;
+
+// Replay objects types (captured ids remapped to replay context ids)
+typedef enum {
+    GLOBJECT_BUFFER = 0,
+    GLOBJECT_TEXTURE,
+    GLOBJECT_VERTEX_ARRAY,
+    GLOBJECT_FRAMEBUFFER,
+    GLOBJECT_RENDERBUFFER,
+    GLOBJECT_PROGRAM,               // Programs and shaders (shared namespace)
+    GLOBJECT_TYPES
+} GlObjectType;
+
+// Replay uniform location (per captured program)
+typedef struct GlUniformLocation {
+    unsigned int program;           // Captured program id
+    int captured;                   // Captured uniform location
+    int location;                   // Replay uniform location
+} GlUniformLocation;
+
+// Captured trace, loaded for replay
+typedef struct GlTrace {
+    unsigned char *data;            // Trace file data
+    unsigned int size;              // Trace file size (bytes)
+    unsigned int position;          // Next call position (bytes)
+
+    int width;                      // Captured default framebuffer width (largest viewport)
+    int height;                     // Captured default framebuffer height (largest viewport)
+    int framesCount;                // Captured frames count
+    int callsCount;                 // Captured calls count (frame markers not included)
+    int frame;                      // Current replay frame
+
+    // Replay state: objects remapping
+    unsigned int *objects[GLOBJECT_TYPES];  // Replay ids, indexed by captured id
+    int objectsCapacity[GLOBJECT_TYPES];    // Replay ids tables capacity
+    GLsync *syncs;                  // Replay sync objects, indexed by captured sync index
+    int syncsCapacity;              // Replay sync objects table capacity
+    GlUniformLocation *uniforms;    // Replay uniform locations
+    int uniformsCount;              // Replay uniform locations count
+    int attribs[GLCAPTURE_MAX_ATTRIBS];     // Replay attribs locations, indexed by captured location
+    unsigned int program;           // Current program (captured id)
+
+    // Replay state: buffers mapping and pixels readback
+    GLenum mappedTargets[GLCAPTURE_MAX_MAPPINGS];   // Mapped buffers targets
+    void *mappedPointers[GLCAPTURE_MAX_MAPPINGS];   // Mapped buffers pointers
+    unsigned char *pixels;          // Pixels readback scratch buffer
+    unsigned int pixelsSize;        // Pixels readback scratch buffer size
+} GlTrace;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//------------------------------------------------------------------------------------
+// Functions Declaration - Capture
+//------------------------------------------------------------------------------------
+int InitGlCapture(const char *fileName, int framesCount);   // Init capture: hook OpenGL calls (call after GLAD loading), returns 1 on success
+void UpdateGlCapture(void);                                 // Mark captured frame end (call before swapping buffers), closes capture when done
+void CloseGlCapture(void);                                  // Close capture: unhook OpenGL calls and complete trace file
+int IsGlCaptureActive(void);                                // Check if OpenGL calls are being captured
+
+//------------------------------------------------------------------------------------
+// Functions Declaration - Replay
+//------------------------------------------------------------------------------------
+GlTrace LoadGlTrace(const char *fileName);                  // Load captured trace for replay (trace.data NULL on failure)
+void UnloadGlTrace(GlTrace trace);                          // Unload trace data and replay state
+int ReplayGlCall(GlTrace *trace);                           // Replay next trace call, returns call id (GLCALL_FRAME on frame end, -1 on trace end)
+const char *GetGlCallName(int call);                        // Get captured call function name
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GLCAPTURE_H
+
+/***********************************************************************************
+*
+*   GLCAPTURE IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(GLCAPTURE_IMPLEMENTATION)
+
+#include <stdio.h>              // Required for: FILE, fopen(), fwrite(), fread(), fseek(), fclose()
+#include <stdlib.h>             // Required for: malloc(), realloc(), calloc(), free()
+#include <string.h>             // Required for: memcpy(), memset(), strlen(), memcmp()
+
+#if !defined(GLCAPTURE_LOG)
+    #define GLCAPTURE_LOG(...) { printf(__VA_ARGS__); printf("\n"); }
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Captured buffer mapping (data recorded on unmapping)
+typedef struct GlCaptureMapping {
+    GLenum target;                  // Mapped buffer target (0: slot not used)
+    unsigned char *pointer;         // Mapped memory
+    unsigned int size;              // Mapped memory size
+    int write;                      // Mapped memory can be written (data must be recorded)
+} GlCaptureMapping;
+
+// Capture state
+typedef struct GlCapture {
+    FILE *file;                     // Trace file
+    unsigned int position;          // Trace file position (bytes written)
+    int framesCount;                // Frames to capture
+    int frame;                      // Current captured frame
+    int callsCount;                 // Captured calls count
+    int width;                      // Default framebuffer width (largest viewport)
+    int height;                     // Default framebuffer height (largest viewport)
+
+    unsigned int framebuffer;       // Current draw framebuffer
+    unsigned int packBuffer;        // Current pixel pack buffer
+    int unpackAlignment;            // Current pixels unpack alignment
+
+    GLsync *syncs;                  // Captured sync objects (index used as id)
+    int syncsCount;                 // Captured sync objects count
+    GlCaptureMapping mappings[GLCAPTURE_MAX_MAPPINGS];  // Buffers currently mapped
+} GlCapture;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static GlCapture capture = { 0 };
+
+// Original OpenGL functions (GLAD pointers replaced while capturing)
+#define GLCAPTURE_ORIGINAL(name, upper) static PFNGL##upper##PROC original##name = NULL;
+GLCAPTURE_CALLS(GLCAPTURE_ORIGINAL)
+#undef GLCAPTURE_ORIGINAL
+
+// Captured calls names
+static const char *glCallNames[GLCALL_COUNT] = {
+    "Frame",
+#define GLCAPTURE_CALL_NAME(name, upper) "gl" #name,
+    GLCAPTURE_CALLS(GLCAPTURE_CALL_NAME)
+#undef GLCAPTURE_CALL_NAME
+};
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Declaration
+//----------------------------------------------------------------------------------
+static void WriteCall(GlCall call);                         // Write call id into trace
+static void WriteWord(unsigned int value);                  // Write 32 bit word into trace
+static void WriteFloat(float value);                        // Write float into trace
+static void WriteLong(unsigned long long value);            // Write 64 bit word into trace
+static void WriteData(const void *data, unsigned int size); // Write data block into trace (NULL supported)
+static void WriteString(const char *text);                  // Write NULL-terminated string as data block
+static int GetSyncIndex(GLsync sync);                       // Get captured sync object index (-1 if not captured)
+static unsigned int GetPixelsDataSize(int width, int height, GLenum format, GLenum type, int alignment);  // Get pixels data size, including rows padding
+
+static unsigned int ReadWord(GlTrace *trace);               // Read 32 bit word from trace
+static float ReadFloat(GlTrace *trace);                     // Read float from trace
+static unsigned long long ReadLong(GlTrace *trace);         // Read 64 bit word from trace
+static const void *ReadData(GlTrace *trace, unsigned int *size);        // Read data block from trace (pointer into trace data)
+static unsigned int MapObject(GlTrace *trace, int type, unsigned int id);   // Get replay object id from captured id
+static void SetObject(GlTrace *trace, int type, unsigned int id, unsigned int replayId);   // Set replay object id for captured id
+static int MapUniform(GlTrace *trace, int location);       // Get replay uniform location (current program)
+static void *GetMappedPointer(GlTrace *trace, GLenum target, void *pointer, int set);  // Get/set replay mapped buffer pointer
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Capture functions (OpenGL calls replacements)
+//----------------------------------------------------------------------------------
+// NOTE: Original function is called first, so generated ids and results can be recorded
+
+static void APIENTRY CaptureActiveTexture(GLenum texture) { originalActiveTexture(texture); WriteCall(GLCALL_ACTIVETEXTURE); WriteWord(texture); }
+static void APIENTRY CaptureAttachShader(GLuint program, GLuint shader) { originalAttachShader(program, shader); WriteCall(GLCALL_ATTACHSHADER); WriteWord(program); WriteWord(shader); }
+static void APIENTRY CaptureBindAttribLocation(GLuint program, GLuint index, const GLchar *name) { originalBindAttribLocation(program, index, name); WriteCall(GLCALL_BINDATTRIBLOCATION); WriteWord(program); WriteWord(index); WriteString(name); }
+
+static void APIENTRY CaptureBindBuffer(GLenum target, GLuint buffer)
+{
+    originalBindBuffer(target, buffer);
+    if (target == GL_PIXEL_PACK_BUFFER) capture.packBuffer = buffer;
+    WriteCall(GLCALL_BINDBUFFER); WriteWord(target); WriteWord(buffer);
+}
+
+static void APIENTRY CaptureBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    originalBindFramebuffer(target, framebuffer);
+    if ((target == GL_FRAMEBUFFER) || (target == GL_DRAW_FRAMEBUFFER)) capture.framebuffer = framebuffer;
+    WriteCall(GLCALL_BINDFRAMEBUFFER); WriteWord(target); WriteWord(framebuffer);
+}
+
+static void APIENTRY CaptureBindRenderbuffer(GLenum target, GLuint renderbuffer) { originalBindRenderbuffer(target, renderbuffer); WriteCall(GLCALL_BINDRENDERBUFFER); WriteWord(target); WriteWord(renderbuffer); }
+static void APIENTRY CaptureBindTexture(GLenum target, GLuint texture) { originalBindTexture(target, texture); WriteCall(GLCALL_BINDTEXTURE); WriteWord(target); WriteWord(texture); }
+static void APIENTRY CaptureBindVertexArray(GLuint array) { originalBindVertexArray(array); WriteCall(GLCALL_BINDVERTEXARRAY); WriteWord(array); }
+static void APIENTRY CaptureBlendFunc(GLenum sfactor, GLenum dfactor) { originalBlendFunc(sfactor, dfactor); WriteCall(GLCALL_BLENDFUNC); WriteWord(sfactor); WriteWord(dfactor); }
+
+static void APIENTRY CaptureBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    originalBufferData(target, size, data, usage);
+    WriteCall(GLCALL_BUFFERDATA); WriteWord(target); WriteLong(size); WriteData(data, (unsigned int)size); WriteWord(usage);
+}
+
+static void APIENTRY CaptureBufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+    originalBufferStorage(target, size, data, flags);
+    WriteCall(GLCALL_BUFFERSTORAGE); WriteWord(target); WriteLong(size); WriteData(data, (unsigned int)size); WriteWord(flags);
+}
+
+static void APIENTRY CaptureBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+    originalBufferSubData(target, offset, size, data);
+    WriteCall(GLCALL_BUFFERSUBDATA); WriteWord(target); WriteLong(offset); WriteData(data, (unsigned int)size);
+}
+
+static void APIENTRY CaptureClear(GLbitfield mask) { originalClear(mask); WriteCall(GLCALL_CLEAR); WriteWord(mask); }
+static void APIENTRY CaptureClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) { originalClearColor(red, green, blue, alpha); WriteCall(GLCALL_CLEARCOLOR); WriteFloat(red); WriteFloat(green); WriteFloat(blue); WriteFloat(alpha); }
+
+static void APIENTRY CaptureClearDepth(GLdouble depth)
+{
+    unsigned long long value = 0;
+
+    originalClearDepth(depth);
+    memcpy(&value, &depth, sizeof(double));
+    WriteCall(GLCALL_CLEARDEPTH); WriteLong(value);
+}
+
+static GLenum APIENTRY CaptureClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    GLenum result = originalClientWaitSync(sync, flags, timeout);
+    WriteCall(GLCALL_CLIENTWAITSYNC); WriteWord(GetSyncIndex(sync)); WriteWord(flags); WriteLong(timeout);
+    return result;
+}
+
+static void APIENTRY CaptureCompileShader(GLuint shader) { originalCompileShader(shader); WriteCall(GLCALL_COMPILESHADER); WriteWord(shader); }
+
+static void APIENTRY CaptureCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data)
+{
+    originalCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data);
+    WriteCall(GLCALL_COMPRESSEDTEXIMAGE2D); WriteWord(target); WriteWord(level); WriteWord(internalformat);
+    WriteWord(width); WriteWord(height); WriteWord(border); WriteData(data, imageSize);
+}
+
+static GLuint APIENTRY CaptureCreateProgram(void) { GLuint id = originalCreateProgram(); WriteCall(GLCALL_CREATEPROGRAM); WriteWord(id); return id; }
+static GLuint APIENTRY CaptureCreateShader(GLenum type) { GLuint id = originalCreateShader(type); WriteCall(GLCALL_CREATESHADER); WriteWord(type); WriteWord(id); return id; }
+static void APIENTRY CaptureCullFace(GLenum mode) { originalCullFace(mode); WriteCall(GLCALL_CULLFACE); WriteWord(mode); }
+
+// Objects generation/deletion functions, ids recorded as data block
+#define GLCAPTURE_GEN_OBJECTS(name, upper) \
+static void APIENTRY Capture##name(GLsizei n, GLuint *ids) { original##name(n, ids); WriteCall(GLCALL_##upper); WriteData(ids, n*sizeof(GLuint)); }
+#define GLCAPTURE_DELETE_OBJECTS(name, upper) \
+static void APIENTRY Capture##name(GLsizei n, const GLuint *ids) { original##name(n, ids); WriteCall(GLCALL_##upper); WriteData(ids, n*sizeof(GLuint)); }
+
+GLCAPTURE_DELETE_OBJECTS(DeleteBuffers, DELETEBUFFERS)
+GLCAPTURE_DELETE_OBJECTS(DeleteFramebuffers, DELETEFRAMEBUFFERS)
+GLCAPTURE_DELETE_OBJECTS(DeleteRenderbuffers, DELETERENDERBUFFERS)
+GLCAPTURE_DELETE_OBJECTS(DeleteTextures, DELETETEXTURES)
+GLCAPTURE_DELETE_OBJECTS(DeleteVertexArrays, DELETEVERTEXARRAYS)
+GLCAPTURE_GEN_OBJECTS(GenBuffers, GENBUFFERS)
+GLCAPTURE_GEN_OBJECTS(GenFramebuffers, GENFRAMEBUFFERS)
+GLCAPTURE_GEN_OBJECTS(GenRenderbuffers, GENRENDERBUFFERS)
+GLCAPTURE_GEN_OBJECTS(GenTextures, GENTEXTURES)
+GLCAPTURE_GEN_OBJECTS(GenVertexArrays, GENVERTEXARRAYS)
+
+static void APIENTRY CaptureDeleteProgram(GLuint program) { originalDeleteProgram(program); WriteCall(GLCALL_DELETEPROGRAM); WriteWord(program); }
+static void APIENTRY CaptureDeleteShader(GLuint shader) { originalDeleteShader(shader); WriteCall(GLCALL_DELETESHADER); WriteWord(shader); }
+
+static void APIENTRY CaptureDeleteSync(GLsync sync)
+{
+    int index = GetSyncIndex(sync);
+
+    originalDeleteSync(sync);
+    if (index >= 0) capture.syncs[index] = NULL;    // Index not reused, driver could return same pointer
+    WriteCall(GLCALL_DELETESYNC); WriteWord(index);
+}
+
+static void APIENTRY CaptureDepthFunc(GLenum func) { originalDepthFunc(func); WriteCall(GLCALL_DEPTHFUNC); WriteWord(func); }
+static void APIENTRY CaptureDetachShader(GLuint program, GLuint shader) { originalDetachShader(program, shader); WriteCall(GLCALL_DETACHSHADER); WriteWord(program); WriteWord(shader); }
+static void APIENTRY CaptureDisable(GLenum cap) { originalDisable(cap); WriteCall(GLCALL_DISABLE); WriteWord(cap); }
+static void APIENTRY CaptureDisableVertexAttribArray(GLuint index) { originalDisableVertexAttribArray(index); WriteCall(GLCALL_DISABLEVERTEXATTRIBARRAY); WriteWord(index); }
+static void APIENTRY CaptureDrawArrays(GLenum mode, GLint first, GLsizei count) { originalDrawArrays(mode, first, count); WriteCall(GLCALL_DRAWARRAYS); WriteWord(mode); WriteWord(first); WriteWord(count); }
+
+static void APIENTRY CaptureDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+    originalDrawElements(mode, count, type, indices);
+    WriteCall(GLCALL_DRAWELEMENTS); WriteWord(mode); WriteWord(count); WriteWord(type); WriteLong((size_t)indices);
+}
+
+static void APIENTRY CaptureDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex)
+{
+    originalDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+    WriteCall(GLCALL_DRAWELEMENTSBASEVERTEX); WriteWord(mode); WriteWord(count); WriteWord(type); WriteLong((size_t)indices); WriteWord(basevertex);
+}
+
+static void APIENTRY CaptureEnable(GLenum cap) { originalEnable(cap); WriteCall(GLCALL_ENABLE); WriteWord(cap); }
+static void APIENTRY CaptureEnableVertexAttribArray(GLuint index) { originalEnableVertexAttribArray(index); WriteCall(GLCALL_ENABLEVERTEXATTRIBARRAY); WriteWord(index); }
+
+static GLsync APIENTRY CaptureFenceSync(GLenum condition, GLbitfield flags)
+{
+    GLsync sync = originalFenceSync(condition, flags);
+
+    capture.syncs = (GLsync *)realloc(capture.syncs, (capture.syncsCount + 1)*sizeof(GLsync));
+    capture.syncs[capture.syncsCount] = sync;
+    WriteCall(GLCALL_FENCESYNC); WriteWord(condition); WriteWord(flags); WriteWord(capture.syncsCount);
+    capture.syncsCount++;
+
+    return sync;
+}
+
+static void APIENTRY CaptureFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    originalFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+    WriteCall(GLCALL_FRAMEBUFFERRENDERBUFFER); WriteWord(target); WriteWord(attachment); WriteWord(renderbuffertarget); WriteWord(renderbuffer);
+}
+
+static void APIENTRY CaptureFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    originalFramebufferTexture2D(target, attachment, textarget, texture, level);
+    WriteCall(GLCALL_FRAMEBUFFERTEXTURE2D); WriteWord(target); WriteWord(attachment); WriteWord(textarget); WriteWord(texture); WriteWord(level);
+}
+
+static void APIENTRY CaptureFrontFace(GLenum mode) { originalFrontFace(mode); WriteCall(GLCALL_FRONTFACE); WriteWord(mode); }
+static void APIENTRY CaptureGenerateMipmap(GLenum target) { originalGenerateMipmap(target); WriteCall(GLCALL_GENERATEMIPMAP); WriteWord(target); }
+
+static GLint APIENTRY CaptureGetAttribLocation(GLuint program, const GLchar *name)
+{
+    GLint location = originalGetAttribLocation(program, name);
+    WriteCall(GLCALL_GETATTRIBLOCATION); WriteWord(program); WriteString(name); WriteWord(location);
+    return location;
+}
+
+static GLint APIENTRY CaptureGetUniformLocation(GLuint program, const GLchar *name)
+{
+    GLint location = originalGetUniformLocation(program, name);
+    WriteCall(GLCALL_GETUNIFORMLOCATION); WriteWord(program); WriteString(name); WriteWord(location);
+    return location;
+}
+
+// NOTE: Pixels are not recorded, only pixel pack buffer offset (if bound)
+static void APIENTRY CaptureGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void *pixels)
+{
+    originalGetTexImage(target, level, format, type, pixels);
+    WriteCall(GLCALL_GETTEXIMAGE); WriteWord(target); WriteWord(level); WriteWord(format); WriteWord(type);
+    WriteWord(capture.packBuffer != 0); WriteLong((capture.packBuffer != 0)? (size_t)pixels : 0);
+}
+
+static void APIENTRY CaptureHint(GLenum target, GLenum mode) { originalHint(target, mode); WriteCall(GLCALL_HINT); WriteWord(target); WriteWord(mode); }
+static void APIENTRY CaptureLinkProgram(GLuint program) { originalLinkProgram(program); WriteCall(GLCALL_LINKPROGRAM); WriteWord(program); }
+
+// Register mapped buffer memory, written data is recorded on unmapping
+static void CaptureMapping(GLenum target, void *pointer, unsigned int size, int write)
+{
+    for (int i = 0; i < GLCAPTURE_MAX_MAPPINGS; i++)
+    {
+        if (capture.mappings[i].target == 0)
+        {
+            capture.mappings[i].target = target;
+            capture.mappings[i].pointer = (unsigned char *)pointer;
+            capture.mappings[i].size = size;
+            capture.mappings[i].write = write;
+            return;
+        }
+    }
+
+    GLCAPTURE_LOG("GLCAPTURE: Too many buffers mapped, buffer data will not be captured");
+}
+
+static void *APIENTRY CaptureMapBuffer(GLenum target, GLenum access)
+{
+    void *pointer = originalMapBuffer(target, access);
+    GLint size = 0;
+
+    glad_glGetBufferParameteriv(target, GL_BUFFER_SIZE, &size);
+    if (pointer != NULL) CaptureMapping(target, pointer, size, (access != GL_READ_ONLY));
+    WriteCall(GLCALL_MAPBUFFER); WriteWord(target); WriteWord(access);
+
+    return pointer;
+}
+
+static void *APIENTRY CaptureMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    void *pointer = originalMapBufferRange(target, offset, length, access);
+
+    if (access & GL_MAP_PERSISTENT_BIT) GLCAPTURE_LOG("GLCAPTURE: Persistent mapped buffer writes can not be captured");
+    if (pointer != NULL) CaptureMapping(target, pointer, (unsigned int)length, (access & GL_MAP_WRITE_BIT) && !(access & GL_MAP_PERSISTENT_BIT));
+    WriteCall(GLCALL_MAPBUFFERRANGE); WriteWord(target); WriteLong(offset); WriteLong(length); WriteWord(access);
+
+    return pointer;
+}
+
+static void APIENTRY CapturePixelStorei(GLenum pname, GLint param)
+{
+    originalPixelStorei(pname, param);
+    if (pname == GL_UNPACK_ALIGNMENT) capture.unpackAlignment = param;
+    WriteCall(GLCALL_PIXELSTOREI); WriteWord(pname); WriteWord(param);
+}
+
+static void APIENTRY CapturePolygonMode(GLenum face, GLenum mode) { originalPolygonMode(face, mode); WriteCall(GLCALL_POLYGONMODE); WriteWord(face); WriteWord(mode); }
+
+// NOTE: Pixels are not recorded, only pixel pack buffer offset (if bound)
+static void APIENTRY CaptureReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels)
+{
+    originalReadPixels(x, y, width, height, format, type, pixels);
+    WriteCall(GLCALL_READPIXELS); WriteWord(x); WriteWord(y); WriteWord(width); WriteWord(height); WriteWord(format); WriteWord(type);
+    WriteWord(capture.packBuffer != 0); WriteLong((capture.packBuffer != 0)? (size_t)pixels : 0);
+}
+
+static void APIENTRY CaptureRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    originalRenderbufferStorage(target, internalformat, width, height);
+    WriteCall(GLCALL_RENDERBUFFERSTORAGE); WriteWord(target); WriteWord(internalformat); WriteWord(width); WriteWord(height);
+}
+
+static void APIENTRY CaptureShaderSource(GLuint shader, GLsizei count, const GLchar **string, const GLint *length)
+{
+    originalShaderSource(shader, count, string, length);
+    WriteCall(GLCALL_SHADERSOURCE); WriteWord(shader); WriteWord(count);
+
+    for (int i = 0; i < count; i++) WriteData(string[i], ((length != NULL) && (length[i] >= 0))? (unsigned int)length[i] : (unsigned int)strlen(string[i]));
+}
+
+static void APIENTRY CaptureTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)
+{
+    originalTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+    WriteCall(GLCALL_TEXIMAGE2D); WriteWord(target); WriteWord(level); WriteWord(internalformat); WriteWord(width); WriteWord(height);
+    WriteWord(border); WriteWord(format); WriteWord(type); WriteData(pixels, GetPixelsDataSize(width, height, format, type, capture.unpackAlignment));
+}
+
+static void APIENTRY CaptureTexParameterf(GLenum target, GLenum pname, GLfloat param) { originalTexParameterf(target, pname, param); WriteCall(GLCALL_TEXPARAMETERF); WriteWord(target); WriteWord(pname); WriteFloat(param); }
+static void APIENTRY CaptureTexParameteri(GLenum target, GLenum pname, GLint param) { originalTexParameteri(target, pname, param); WriteCall(GLCALL_TEXPARAMETERI); WriteWord(target); WriteWord(pname); WriteWord(param); }
+
+static void APIENTRY CaptureTexParameteriv(GLenum target, GLenum pname, const GLint *params)
+{
+    originalTexParameteriv(target, pname, params);
+    WriteCall(GLCALL_TEXPARAMETERIV); WriteWord(target); WriteWord(pname);
+    WriteData(params, ((pname == GL_TEXTURE_SWIZZLE_RGBA) || (pname == GL_TEXTURE_BORDER_COLOR))? 4*sizeof(GLint) : sizeof(GLint));
+}
+
+static void APIENTRY CaptureTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)
+{
+    originalTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+    WriteCall(GLCALL_TEXSUBIMAGE2D); WriteWord(target); WriteWord(level); WriteWord(xoffset); WriteWord(yoffset); WriteWord(width); WriteWord(height);
+    WriteWord(format); WriteWord(type); WriteData(pixels, GetPixelsDataSize(width, height, format, type, capture.unpackAlignment));
+}
+
+static void APIENTRY CaptureUniform1f(GLint location, GLfloat v0) { originalUniform1f(location, v0); WriteCall(GLCALL_UNIFORM1F); WriteWord(location); WriteFloat(v0); }
+static void APIENTRY CaptureUniform1i(GLint location, GLint v0) { originalUniform1i(location, v0); WriteCall(GLCALL_UNIFORM1I); WriteWord(location); WriteWord(v0); }
+
+static void APIENTRY CaptureUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+    originalUniform4f(location, v0, v1, v2, v3);
+    WriteCall(GLCALL_UNIFORM4F); WriteWord(location); WriteFloat(v0); WriteFloat(v1); WriteFloat(v2); WriteFloat(v3);
+}
+
+// Uniform arrays functions, values recorded as data block
+#define GLCAPTURE_UNIFORM_ARRAY(name, upper, type, components) \
+static void APIENTRY Capture##name(GLint location, GLsizei count, const type *value) \
+{ original##name(location, count, value); WriteCall(GLCALL_##upper); WriteWord(location); WriteWord(count); WriteData(value, count*components*sizeof(type)); }
+
+GLCAPTURE_UNIFORM_ARRAY(Uniform1fv, UNIFORM1FV, GLfloat, 1)
+GLCAPTURE_UNIFORM_ARRAY(Uniform1iv, UNIFORM1IV, GLint, 1)
+GLCAPTURE_UNIFORM_ARRAY(Uniform2fv, UNIFORM2FV, GLfloat, 2)
+GLCAPTURE_UNIFORM_ARRAY(Uniform2iv, UNIFORM2IV, GLint, 2)
+GLCAPTURE_UNIFORM_ARRAY(Uniform3fv, UNIFORM3FV, GLfloat, 3)
+GLCAPTURE_UNIFORM_ARRAY(Uniform3iv, UNIFORM3IV, GLint, 3)
+GLCAPTURE_UNIFORM_ARRAY(Uniform4fv, UNIFORM4FV, GLfloat, 4)
+GLCAPTURE_UNIFORM_ARRAY(Uniform4iv, UNIFORM4IV, GLint, 4)
+
+static void APIENTRY CaptureUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+    originalUniformMatrix4fv(location, count, transpose, value);
+    WriteCall(GLCALL_UNIFORMMATRIX4FV); WriteWord(location); WriteWord(count); WriteWord(transpose); WriteData(value, count*16*sizeof(GLfloat));
+}
+
+// NOTE: Mapped memory written data is recorded before unmapping (pointer not valid after)
+static GLboolean APIENTRY CaptureUnmapBuffer(GLenum target)
+{
+    GlCaptureMapping mapping = { 0 };
+
+    for (int i = 0; i < GLCAPTURE_MAX_MAPPINGS; i++)
+    {
+        if (capture.mappings[i].target == target)
+        {
+            mapping = capture.mappings[i];
+            capture.mappings[i].target = 0;
+            break;
+        }
+    }
+
+    WriteCall(GLCALL_UNMAPBUFFER); WriteWord(target);
+    WriteData(mapping.write? mapping.pointer : NULL, mapping.size);
+
+    return originalUnmapBuffer(target);
+}
+
+static void APIENTRY CaptureUseProgram(GLuint program) { originalUseProgram(program); WriteCall(GLCALL_USEPROGRAM); WriteWord(program); }
+static void APIENTRY CaptureVertexAttrib2f(GLuint index, GLfloat x, GLfloat y) { originalVertexAttrib2f(index, x, y); WriteCall(GLCALL_VERTEXATTRIB2F); WriteWord(index); WriteFloat(x); WriteFloat(y); }
+static void APIENTRY CaptureVertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z) { originalVertexAttrib3f(index, x, y, z); WriteCall(GLCALL_VERTEXATTRIB3F); WriteWord(index); WriteFloat(x); WriteFloat(y); WriteFloat(z); }
+static void APIENTRY CaptureVertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w) { originalVertexAttrib4f(index, x, y, z, w); WriteCall(GLCALL_VERTEXATTRIB4F); WriteWord(index); WriteFloat(x); WriteFloat(y); WriteFloat(z); WriteFloat(w); }
+
+static void APIENTRY CaptureVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)
+{
+    originalVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    WriteCall(GLCALL_VERTEXATTRIBPOINTER); WriteWord(index); WriteWord(size); WriteWord(type); WriteWord(normalized); WriteWord(stride); WriteLong((size_t)pointer);
+}
+
+static void APIENTRY CaptureViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    originalViewport(x, y, width, height);
+
+    // Default framebuffer size is not available from OpenGL, largest viewport used instead
+    if (capture.framebuffer == 0)
+    {
+        if ((x + width) > capture.width) capture.width = x + width;
+        if ((y + height) > capture.height) capture.height = y + height;
+    }
+
+    WriteCall(GLCALL_VIEWPORT); WriteWord(x); WriteWord(y); WriteWord(width); WriteWord(height);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Capture
+//----------------------------------------------------------------------------------
+
+// Init capture: hook OpenGL calls (call after GLAD loading)
+// NOTE: Capture should start before any OpenGL resource is created
+int InitGlCapture(const char *fileName, int framesCount)
+{
+    if (capture.file != NULL) CloseGlCapture();
+
+    capture.file = fopen(fileName, "wb");
+
+    if (capture.file == NULL)
+    {
+        GLCAPTURE_LOG("GLCAPTURE: [%s] Trace file could not be created", fileName);
+        return 0;
+    }
+
+    capture.position = 0;
+    capture.framesCount = framesCount;
+    capture.frame = 0;
+    capture.callsCount = 0;
+    capture.width = 0;
+    capture.height = 0;
+    capture.framebuffer = 0;
+    capture.packBuffer = 0;
+    capture.unpackAlignment = 4;
+    memset(capture.mappings, 0, sizeof(capture.mappings));
+
+    // Header placeholder (completed on capture closing)
+    fwrite("GLTR", 1, 4, capture.file);
+    capture.position += 4;
+    for (int i = 0; i < 5; i++) WriteWord(0);
+
+    // Replace GLAD function pointers by capture functions
+    // NOTE: Not available functions (i.e. extensions not supported) are not replaced
+#define GLCAPTURE_HOOK(name, upper) if (glad_gl##name != NULL) { original##name = glad_gl##name; glad_gl##name = Capture##name; }
+    GLCAPTURE_CALLS(GLCAPTURE_HOOK)
+#undef GLCAPTURE_HOOK
+
+    GLCAPTURE_LOG("GLCAPTURE: [%s] Capturing OpenGL calls (%i frames)", fileName, framesCount);
+
+    return 1;
+}
+
+// Mark captured frame end (call before swapping buffers)
+void UpdateGlCapture(void)
+{
+    if (capture.file == NULL) return;
+
+    unsigned char id = GLCALL_FRAME;
+    fwrite(&id, 1, 1, capture.file);
+    capture.position++;
+    capture.frame++;
+
+    if (capture.frame >= capture.framesCount) CloseGlCapture();
+}
+
+// Close capture: unhook OpenGL calls and complete trace file
+void CloseGlCapture(void)
+{
+    if (capture.file == NULL) return;
+
+    // Restore GLAD function pointers
+#define GLCAPTURE_UNHOOK(name, upper) if (original##name != NULL) { glad_gl##name = original##name; original##name = NULL; }
+    GLCAPTURE_CALLS(GLCAPTURE_UNHOOK)
+#undef GLCAPTURE_UNHOOK
+
+    // Complete trace header
+    unsigned int header[5] = { GLCAPTURE_VERSION, capture.width, capture.height, capture.frame, capture.callsCount };
+    unsigned int position = capture.position;
+    fseek(capture.file, 4, SEEK_SET);
+    for (int i = 0; i < 5; i++) WriteWord(header[i]);
+    capture.position = position;
+    fclose(capture.file);
+    capture.file = NULL;
+
+    free(capture.syncs);
+    capture.syncs = NULL;
+    capture.syncsCount = 0;
+
+    GLCAPTURE_LOG("GLCAPTURE: Capture completed: %i frames, %i calls, %u bytes", capture.frame, capture.callsCount, capture.position);
+}
+
+// Check if OpenGL calls are being captured
+int IsGlCaptureActive(void)
+{
+    return (capture.file != NULL);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Replay
+//----------------------------------------------------------------------------------
+
+// Load captured trace for replay
+GlTrace LoadGlTrace(const char *fileName)
+{
+    GlTrace trace = { 0 };
+
+    FILE *file = fopen(fileName, "rb");
+
+    if (file == NULL)
+    {
+        GLCAPTURE_LOG("GLCAPTURE: [%s] Trace file could not be opened", fileName);
+        return trace;
+    }
+
+    fseek(file, 0, SEEK_END);
+    trace.size = (unsigned int)ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    trace.data = (unsigned char *)malloc(trace.size);
+    if (fread(trace.data, 1, trace.size, file) != trace.size) trace.size = 0;
+    fclose(file);
+
+    unsigned int version = 0;
+
+    if ((trace.size >= 24) && (memcmp(trace.data, "GLTR", 4) == 0))
+    {
+        trace.position = 4;
+        version = ReadWord(&trace);
+    }
+
+    if (version != GLCAPTURE_VERSION)
+    {
+        GLCAPTURE_LOG("GLCAPTURE: [%s] Trace file not valid", fileName);
+        free(trace.data);
+        return (GlTrace){ 0 };
+    }
+
+    trace.width = ReadWord(&trace);
+    trace.height = ReadWord(&trace);
+    trace.framesCount = ReadWord(&trace);
+    trace.callsCount = ReadWord(&trace);
+
+    for (int i = 0; i < GLCAPTURE_MAX_ATTRIBS; i++) trace.attribs[i] = i;
+
+    GLCAPTURE_LOG("GLCAPTURE: [%s] Trace loaded: %ix%i, %i frames, %i calls", fileName, trace.width, trace.height, trace.framesCount, trace.callsCount);
+
+    return trace;
+}
+
+// Unload trace data and replay state
+// NOTE: Replayed OpenGL objects are not deleted, they are owned by replay context
+void UnloadGlTrace(GlTrace trace)
+{
+    free(trace.data);
+    for (int i = 0; i < GLOBJECT_TYPES; i++) free(trace.objects[i]);
+    free(trace.syncs);
+    free(trace.uniforms);
+    free(trace.pixels);
+}
+
+// Get captured call function name
+const char *GetGlCallName(int call)
+{
+    if ((call < 0) || (call >= GLCALL_COUNT)) return "Unknown";
+
+    return glCallNames[call];
+}
+
+// Replay objects generation
+static void ReplayGenObjects(GlTrace *trace, int type, PFNGLGENBUFFERSPROC genObjects)
+{
+    unsigned int size = 0;
+    const GLuint *ids = (const GLuint *)ReadData(trace, &size);
+    int count = size/sizeof(GLuint);
+    GLuint *replayIds = (GLuint *)malloc(count*sizeof(GLuint) + 1);
+
+    genObjects(count, replayIds);
+    for (int i = 0; i < count; i++) SetObject(trace, type, ids[i], replayIds[i]);
+
+    free(replayIds);
+}
+
+// Replay objects deletion
+static void ReplayDeleteObjects(GlTrace *trace, int type, PFNGLDELETEBUFFERSPROC deleteObjects)
+{
+    unsigned int size = 0;
+    const GLuint *ids = (const GLuint *)ReadData(trace, &size);
+    int count = size/sizeof(GLuint);
+    GLuint *replayIds = (GLuint *)malloc(count*sizeof(GLuint) + 1);
+
+    for (int i = 0; i < count; i++)
+    {
+        replayIds[i] = MapObject(trace, type, ids[i]);
+        SetObject(trace, type, ids[i], 0);
+    }
+
+    deleteObjects(count, replayIds);
+
+    free(replayIds);
+}
+
+// Replay next trace call, returns call id (GLCALL_FRAME on frame end, -1 on trace end)
+// NOTE: Arguments must be read in recording order, they are always read into variables first
+int ReplayGlCall(GlTrace *trace)
+{
+    if (trace->position >= trace->size) return -1;
+
+    int call = trace->data[trace->position];
+    trace->position++;
+
+    switch (call)
+    {
+        case GLCALL_FRAME: trace->frame++; break;
+        case GLCALL_ACTIVETEXTURE: glActiveTexture(ReadWord(trace)); break;
+        case GLCALL_ATTACHSHADER:
+        {
+            GLuint program = ReadWord(trace);
+            GLuint shader = ReadWord(trace);
+            glAttachShader(MapObject(trace, GLOBJECT_PROGRAM, program), MapObject(trace, GLOBJECT_PROGRAM, shader));
+        } break;
+        case GLCALL_BINDATTRIBLOCATION:
+        {
+            GLuint program = ReadWord(trace);
+            GLuint index = ReadWord(trace);
+            const GLchar *name = (const GLchar *)ReadData(trace, NULL);
+            glBindAttribLocation(MapObject(trace, GLOBJECT_PROGRAM, program), index, name);
+        } break;
+        case GLCALL_BINDBUFFER:
+        {
+            GLenum target = ReadWord(trace);
+            GLuint buffer = ReadWord(trace);
+            glBindBuffer(target, MapObject(trace, GLOBJECT_BUFFER, buffer));
+        } break;
+        case GLCALL_BINDFRAMEBUFFER:
+        {
+            GLenum target = ReadWord(trace);
+            GLuint framebuffer = ReadWord(trace);
+            glBindFramebuffer(target, MapObject(trace, GLOBJECT_FRAMEBUFFER, framebuffer));
+        } break;
+        case GLCALL_BINDRENDERBUFFER:
+        {
+            GLenum target = ReadWord(trace);
+            GLuint renderbuffer = ReadWord(trace);
+            glBindRenderbuffer(target, MapObject(trace, GLOBJECT_RENDERBUFFER, renderbuffer));
+        } break;
+        case GLCALL_BINDTEXTURE:
+        {
+            GLenum target = ReadWord(trace);
+            GLuint texture = ReadWord(trace);
+            glBindTexture(target, MapObject(trace, GLOBJECT_TEXTURE, texture));
+        } break;
+        case GLCALL_BINDVERTEXARRAY: glBindVertexArray(MapObject(trace, GLOBJECT_VERTEX_ARRAY, ReadWord(trace))); break;
+        case GLCALL_BLENDFUNC:
+        {
+            GLenum sfactor = ReadWord(trace);
+            GLenum dfactor = ReadWord(trace);
+            glBlendFunc(sfactor, dfactor);
+        } break;
+        case GLCALL_BUFFERDATA:
+        case GLCALL_BUFFERSTORAGE:
+        {
+            GLenum target = ReadWord(trace);
+            GLsizeiptr size = (GLsizeiptr)ReadLong(trace);
+            const void *data = ReadData(trace, NULL);
+            GLenum usage = ReadWord(trace);
+
+            if (call == GLCALL_BUFFERDATA) glBufferData(target, size, data, usage);
+            else glBufferStorage(target, size, data, usage);
+        } break;
+        case GLCALL_BUFFERSUBDATA:
+        {
+            GLenum target = ReadWord(trace);
+            GLintptr offset = (GLintptr)ReadLong(trace);
+            unsigned int size = 0;
+            const void *data = ReadData(trace, &size);
+            glBufferSubData(target, offset, size, data);
+        } break;
+        case GLCALL_CLEAR: glClear(ReadWord(trace)); break;
+        case GLCALL_CLEARCOLOR:
+        {
+            float color[4] = { 0 };
+            for (int i = 0; i < 4; i++) color[i] = ReadFloat(trace);
+            glClearColor(color[0], color[1], color[2], color[3]);
+        } break;
+        case GLCALL_CLEARDEPTH:
+        {
+            unsigned long long value = ReadLong(trace);
+            double depth = 0.0;
+            memcpy(&depth, &value, sizeof(double));
+            glClearDepth(depth);
+        } break;
+        case GLCALL_CLIENTWAITSYNC:
+        {
+            int index = ReadWord(trace);
+            GLbitfield flags = ReadWord(trace);
+            GLuint64 timeout = ReadLong(trace);
+            if ((index >= 0) && (index < trace->syncsCapacity)) glClientWaitSync(trace->syncs[index], flags, timeout);
+        } break;
+        case GLCALL_COMPILESHADER: glCompileShader(MapObject(trace, GLOBJECT_PROGRAM, ReadWord(trace))); break;
+        case GLCALL_COMPRESSEDTEXIMAGE2D:
+        {
+            GLenum target = ReadWord(trace);
+            GLint level = ReadWord(trace);
+            GLenum internalformat = ReadWord(trace);
+            GLsizei width = ReadWord(trace);
+            GLsizei height = ReadWord(trace);
+            GLint border = ReadWord(trace);
+            unsigned int size = 0;
+            const void *data = ReadData(trace, &size);
+            glCompressedTexImage2D(target, level, internalformat, width, height, border, size, data);
+        } break;
+        case GLCALL_CREATEPROGRAM: SetObject(trace, GLOBJECT_PROGRAM, ReadWord(trace), glCreateProgram()); break;
+        case GLCALL_CREATESHADER:
+        {
+            GLenum type = ReadWord(trace);
+            GLuint id = ReadWord(trace);
+            SetObject(trace, GLOBJECT_PROGRAM, id, glCreateShader(type));
+        } break;
+        case GLCALL_CULLFACE: glCullFace(ReadWord(trace)); break;
+        case GLCALL_DELETEBUFFERS: ReplayDeleteObjects(trace, GLOBJECT_BUFFER, glDeleteBuffers); break;
+        case GLCALL_DELETEFRAMEBUFFERS: ReplayDeleteObjects(trace, GLOBJECT_FRAMEBUFFER, glDeleteFramebuffers); break;
+        case GLCALL_DELETEPROGRAM: glDeleteProgram(MapObject(trace, GLOBJECT_PROGRAM, ReadWord(trace))); break;
+        case GLCALL_DELETERENDERBUFFERS: ReplayDeleteObjects(trace, GLOBJECT_RENDERBUFFER, glDeleteRenderbuffers); break;
+        case GLCALL_DELETESHADER: glDeleteShader(MapObject(trace, GLOBJECT_PROGRAM, ReadWord(trace))); break;
+        case GLCALL_DELETESYNC:
+        {
+            int index = ReadWord(trace);
+            if ((index >= 0) && (index < trace->syncsCapacity))
+            {
+                glDeleteSync(trace->syncs[index]);
+                trace->syncs[index] = NULL;
+            }
+        } break;
+        case GLCALL_DELETETEXTURES: ReplayDeleteObjects(trace, GLOBJECT_TEXTURE, glDeleteTextures); break;
+        case GLCALL_DELETEVERTEXARRAYS: ReplayDeleteObjects(trace, GLOBJECT_VERTEX_ARRAY, glDeleteVertexArrays); break;
+        case GLCALL_DEPTHFUNC: glDepthFunc(ReadWord(trace)); break;
+        case GLCALL_DETACHSHADER:
+        {
+            GLuint program = ReadWord(trace);
+            GLuint shader = ReadWord(trace);
+            glDetachShader(MapObject(trace, GLOBJECT_PROGRAM, program), MapObject(trace, GLOBJECT_PROGRAM, shader));
+        } break;
+        case GLCALL_DISABLE: glDisable(ReadWord(trace)); break;
+        case GLCALL_DISABLEVERTEXATTRIBARRAY:
+        {
+            GLuint index = ReadWord(trace);
+            if (index < GLCAPTURE_MAX_ATTRIBS) index = trace->attribs[index];
+            glDisableVertexAttribArray(index);
+        } break;
+        case GLCALL_DRAWARRAYS:
+        {
+            GLenum mode = ReadWord(trace);
+            GLint first = ReadWord(trace);
+            GLsizei count = ReadWord(trace);
+            glDrawArrays(mode, first, count);
+        } break;
+        case GLCALL_DRAWELEMENTS:
+        case GLCALL_DRAWELEMENTSBASEVERTEX:
+        {
+            GLenum mode = ReadWord(trace);
+            GLsizei count = ReadWord(trace);
+            GLenum type = ReadWord(trace);
+            size_t offset = (size_t)ReadLong(trace);
+
+            if (call == GLCALL_DRAWELEMENTS) glDrawElements(mode, count, type, (const void *)offset);
+            else glDrawElementsBaseVertex(mode, count, type, (const void *)offset, ReadWord(trace));
+        } break;
+        case GLCALL_ENABLE: glEnable(ReadWord(trace)); break;
+        case GLCALL_ENABLEVERTEXATTRIBARRAY:
+        {
+            GLuint index = ReadWord(trace);
+            if (index < GLCAPTURE_MAX_ATTRIBS) index = trace->attribs[index];
+            glEnableVertexAttribArray(index);
+        } break;
+        case GLCALL_FENCESYNC:
+        {
+            GLenum condition = ReadWord(trace);
+            GLbitfield flags = ReadWord(trace);
+            int index = ReadWord(trace);
+
+            if (index >= trace->syncsCapacity)
+            {
+                trace->syncs = (GLsync *)realloc(trace->syncs, (index + 64)*sizeof(GLsync));
+                memset(trace->syncs + trace->syncsCapacity, 0, (index + 64 - trace->syncsCapacity)*sizeof(GLsync));
+                trace->syncsCapacity = index + 64;
+            }
+
+            trace->syncs[index] = glFenceSync(condition, flags);
+        } break;
+        case GLCALL_FRAMEBUFFERRENDERBUFFER:
+        {
+            GLenum target = ReadWord(trace);
+            GLenum attachment = ReadWord(trace);
+            GLenum renderbuffertarget = ReadWord(trace);
+            GLuint renderbuffer = ReadWord(trace);
+            glFramebufferRenderbuffer(target, attachment, renderbuffertarget, MapObject(trace, GLOBJECT_RENDERBUFFER, renderbuffer));
+        } break;
+        case GLCALL_FRAMEBUFFERTEXTURE2D:
+        {
+            GLenum target = ReadWord(trace);
+            GLenum attachment = ReadWord(trace);
+            GLenum textarget = ReadWord(trace);
+            GLuint texture = ReadWord(trace);
+            GLint level = ReadWord(trace);
+            glFramebufferTexture2D(target, attachment, textarget, MapObject(trace, GLOBJECT_TEXTURE, texture), level);
+        } break;
+        case GLCALL_FRONTFACE: glFrontFace(ReadWord(trace)); break;
+        case GLCALL_GENBUFFERS: ReplayGenObjects(trace, GLOBJECT_BUFFER, glGenBuffers); break;
+        case GLCALL_GENFRAMEBUFFERS: ReplayGenObjects(trace, GLOBJECT_FRAMEBUFFER, glGenFramebuffers); break;
+        case GLCALL_GENRENDERBUFFERS: ReplayGenObjects(trace, GLOBJECT_RENDERBUFFER, glGenRenderbuffers); break;
+        case GLCALL_GENTEXTURES: ReplayGenObjects(trace, GLOBJECT_TEXTURE, glGenTextures); break;
+        case GLCALL_GENVERTEXARRAYS: ReplayGenObjects(trace, GLOBJECT_VERTEX_ARRAY, glGenVertexArrays); break;
+        case GLCALL_GENERATEMIPMAP: glGenerateMipmap(ReadWord(trace)); break;
+        case GLCALL_GETATTRIBLOCATION:
+        {
+            GLuint program = ReadWord(trace);
+            const GLchar *name = (const GLchar *)ReadData(trace, NULL);
+            int captured = ReadWord(trace);
+            int location = glGetAttribLocation(MapObject(trace, GLOBJECT_PROGRAM, program), name);
+
+            if ((captured >= 0) && (captured < GLCAPTURE_MAX_ATTRIBS) && (location >= 0)) trace->attribs[captured] = location;
+        } break;
+        case GLCALL_GETUNIFORMLOCATION:
+        {
+            GLuint program = ReadWord(trace);
+            const GLchar *name = (const GLchar *)ReadData(trace, NULL);
+            int captured = ReadWord(trace);
+            int location = glGetUniformLocation(MapObject(trace, GLOBJECT_PROGRAM, program), name);
+
+            if (captured >= 0)
+            {
+                trace->uniforms = (GlUniformLocation *)realloc(trace->uniforms, (trace->uniformsCount + 1)*sizeof(GlUniformLocation));
+                trace->uniforms[trace->uniformsCount] = (GlUniformLocation){ program, captured, location };
+                trace->uniformsCount++;
+            }
+        } break;
+        case GLCALL_GETTEXIMAGE:
+        {
+            GLenum target = ReadWord(trace);
+            GLint level = ReadWord(trace);
+            GLenum format = ReadWord(trace);
+            GLenum type = ReadWord(trace);
+            int packBuffer = ReadWord(trace);
+            size_t offset = (size_t)ReadLong(trace);
+
+            if (packBuffer) glGetTexImage(target, level, format, type, (void *)offset);
+            else
+            {
+                // NOTE: Texture level size queried on replay context, 8 reserved for rows alignment
+                GLint width = 0, height = 0;
+                glGetTexLevelParameteriv(target, level, GL_TEXTURE_WIDTH, &width);
+                glGetTexLevelParameteriv(target, level, GL_TEXTURE_HEIGHT, &height);
+
+                unsigned int size = GetPixelsDataSize(width, height, format, type, 8);
+
+                if (size > trace->pixelsSize)
+                {
+                    trace->pixels = (unsigned char *)realloc(trace->pixels, size);
+                    trace->pixelsSize = size;
+                }
+
+                glGetTexImage(target, level, format, type, trace->pixels);
+            }
+        } break;
+        case GLCALL_HINT:
+        {
+            GLenum target = ReadWord(trace);
+            GLenum mode = ReadWord(trace);
+            glHint(target, mode);
+        } break;
+        case GLCALL_LINKPROGRAM: glLinkProgram(MapObject(trace, GLOBJECT_PROGRAM, ReadWord(trace))); break;
+        case GLCALL_MAPBUFFER:
+        {
+            GLenum target = ReadWord(trace);
+            GLenum access = ReadWord(trace);
+            GetMappedPointer(trace, target, glMapBuffer(target, access), 1);
+        } break;
+        case GLCALL_MAPBUFFERRANGE:
+        {
+            GLenum target = ReadWord(trace);
+            GLintptr offset = (GLintptr)ReadLong(trace);
+            GLsizeiptr length = (GLsizeiptr)ReadLong(trace);
+            GLbitfield access = ReadWord(trace);
+            GetMappedPointer(trace, target, glMapBufferRange(target, offset, length, access), 1);
+        } break;
+        case GLCALL_PIXELSTOREI:
+        {
+            GLenum pname = ReadWord(trace);
+            GLint param = ReadWord(trace);
+            glPixelStorei(pname, param);
+        } break;
+        case GLCALL_POLYGONMODE:
+        {
+            GLenum face = ReadWord(trace);
+            GLenum mode = ReadWord(trace);
+            glPolygonMode(face, mode);
+        } break;
+        case GLCALL_READPIXELS:
+        {
+            GLint x = ReadWord(trace);
+            GLint y = ReadWord(trace);
+            GLsizei width = ReadWord(trace);
+            GLsizei height = ReadWord(trace);
+            GLenum format = ReadWord(trace);
+            GLenum type = ReadWord(trace);
+            int packBuffer = ReadWord(trace);
+            size_t offset = (size_t)ReadLong(trace);
+
+            if (packBuffer) glReadPixels(x, y, width, height, format, type, (void *)offset);
+            else
+            {
+                // NOTE: Default pack alignment (4) assumed for scratch buffer size, 8 reserved
+                unsigned int size = GetPixelsDataSize(width, height, format, type, 8);
+
+                if (size > trace->pixelsSize)
+                {
+                    trace->pixels = (unsigned char *)realloc(trace->pixels, size);
+                    trace->pixelsSize = size;
+                }
+
+                glReadPixels(x, y, width, height, format, type, trace->pixels);
+            }
+        } break;
+        case GLCALL_RENDERBUFFERSTORAGE:
+        {
+            GLenum target = ReadWord(trace);
+            GLenum internalformat = ReadWord(trace);
+            GLsizei width = ReadWord(trace);
+            GLsizei height = ReadWord(trace);
+            glRenderbufferStorage(target, internalformat, width, height);
+        } break;
+        case GLCALL_SHADERSOURCE:
+        {
+            GLuint shader = ReadWord(trace);
+            GLsizei count = ReadWord(trace);
+            const GLchar **strings = (const GLchar **)malloc(count*sizeof(const GLchar *) + 1);
+            GLint *lengths = (GLint *)malloc(count*sizeof(GLint) + 1);
+
+            for (int i = 0; i < count; i++)
+            {
+                unsigned int length = 0;
+                strings[i] = (const GLchar *)ReadData(trace, &length);
+                lengths[i] = length;
+            }
+
+            glShaderSource(MapObject(trace, GLOBJECT_PROGRAM, shader), count, strings, lengths);
+
+            free(strings);
+            free(lengths);
+        } break;
+        case GLCALL_TEXIMAGE2D:
+        {
+            GLenum target = ReadWord(trace);
+            GLint level = ReadWord(trace);
+            GLint internalformat = ReadWord(trace);
+            GLsizei width = ReadWord(trace);
+            GLsizei height = ReadWord(trace);
+            GLint border = ReadWord(trace);
+            GLenum format = ReadWord(trace);
+            GLenum type = ReadWord(trace);
+            const void *pixels = ReadData(trace, NULL);
+            glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+        } break;
+        case GLCALL_TEXPARAMETERF:
+        {
+            GLenum target = ReadWord(trace);
+            GLenum pname = ReadWord(trace);
+            glTexParameterf(target, pname, ReadFloat(trace));
+        } break;
+        case GLCALL_TEXPARAMETERI:
+        {
+            GLenum target = ReadWord(trace);
+            GLenum pname = ReadWord(trace);
+            glTexParameteri(target, pname, ReadWord(trace));
+        } break;
+        case GLCALL_TEXPARAMETERIV:
+        {
+            GLenum target = ReadWord(trace);
+            GLenum pname = ReadWord(trace);
+            glTexParameteriv(target, pname, (const GLint *)ReadData(trace, NULL));
+        } break;
+        case GLCALL_TEXSUBIMAGE2D:
+        {
+            GLenum target = ReadWord(trace);
+            GLint level = ReadWord(trace);
+            GLint xoffset = ReadWord(trace);
+            GLint yoffset = ReadWord(trace);
+            GLsizei width = ReadWord(trace);
+            GLsizei height = ReadWord(trace);
+            GLenum format = ReadWord(trace);
+            GLenum type = ReadWord(trace);
+            const void *pixels = ReadData(trace, NULL);
+            glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+        } break;
+        case GLCALL_UNIFORM1F:
+        {
+            int location = MapUniform(trace, ReadWord(trace));
+            glUniform1f(location, ReadFloat(trace));
+        } break;
+        case GLCALL_UNIFORM1I:
+        {
+            int location = MapUniform(trace, ReadWord(trace));
+            glUniform1i(location, ReadWord(trace));
+        } break;
+        case GLCALL_UNIFORM4F:
+        {
+            int location = MapUniform(trace, ReadWord(trace));
+            float values[4] = { 0 };
+            for (int i = 0; i < 4; i++) values[i] = ReadFloat(trace);
+            glUniform4f(location, values[0], values[1], values[2], values[3]);
+        } break;
+        case GLCALL_UNIFORM1FV:
+        case GLCALL_UNIFORM2FV:
+        case GLCALL_UNIFORM3FV:
+        case GLCALL_UNIFORM4FV:
+        {
+            int location = MapUniform(trace, ReadWord(trace));
+            GLsizei count = ReadWord(trace);
+            const GLfloat *value = (const GLfloat *)ReadData(trace, NULL);
+
+            if (call == GLCALL_UNIFORM1FV) glUniform1fv(location, count, value);
+            else if (call == GLCALL_UNIFORM2FV) glUniform2fv(location, count, value);
+            else if (call == GLCALL_UNIFORM3FV) glUniform3fv(location, count, value);
+            else glUniform4fv(location, count, value);
+        } break;
+        case GLCALL_UNIFORM1IV:
+        case GLCALL_UNIFORM2IV:
+        case GLCALL_UNIFORM3IV:
+        case GLCALL_UNIFORM4IV:
+        {
+            int location = MapUniform(trace, ReadWord(trace));
+            GLsizei count = ReadWord(trace);
+            const GLint *value = (const GLint *)ReadData(trace, NULL);
+
+            if (call == GLCALL_UNIFORM1IV) glUniform1iv(location, count, value);
+            else if (call == GLCALL_UNIFORM2IV) glUniform2iv(location, count, value);
+            else if (call == GLCALL_UNIFORM3IV) glUniform3iv(location, count, value);
+            else glUniform4iv(location, count, value);
+        } break;
+        case GLCALL_UNIFORMMATRIX4FV:
+        {
+            int location = MapUniform(trace, ReadWord(trace));
+            GLsizei count = ReadWord(trace);
+            GLboolean transpose = (GLboolean)ReadWord(trace);
+            glUniformMatrix4fv(location, count, transpose, (const GLfloat *)ReadData(trace, NULL));
+        } break;
+        case GLCALL_UNMAPBUFFER:
+        {
+            GLenum target = ReadWord(trace);
+            unsigned int size = 0;
+            const void *data = ReadData(trace, &size);
+            void *pointer = GetMappedPointer(trace, target, NULL, 0);
+
+            if ((pointer != NULL) && (data != NULL)) memcpy(pointer, data, size);
+            glUnmapBuffer(target);
+        } break;
+        case GLCALL_USEPROGRAM:
+        {
+            trace->program = ReadWord(trace);
+            glUseProgram(MapObject(trace, GLOBJECT_PROGRAM, trace->program));
+        } break;
+        case GLCALL_VERTEXATTRIB2F:
+        case GLCALL_VERTEXATTRIB3F:
+        case GLCALL_VERTEXATTRIB4F:
+        {
+            GLuint index = ReadWord(trace);
+            float values[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            int components = 2 + (call - GLCALL_VERTEXATTRIB2F);
+
+            for (int i = 0; i < components; i++) values[i] = ReadFloat(trace);
+            if (index < GLCAPTURE_MAX_ATTRIBS) index = trace->attribs[index];
+
+            if (call == GLCALL_VERTEXATTRIB2F) glVertexAttrib2f(index, values[0], values[1]);
+            else if (call == GLCALL_VERTEXATTRIB3F) glVertexAttrib3f(index, values[0], values[1], values[2]);
+            else glVertexAttrib4f(index, values[0], values[1], values[2], values[3]);
+        } break;
+        case GLCALL_VERTEXATTRIBPOINTER:
+        {
+            GLuint index = ReadWord(trace);
+            GLint size = ReadWord(trace);
+            GLenum type = ReadWord(trace);
+            GLboolean normalized = (GLboolean)ReadWord(trace);
+            GLsizei stride = ReadWord(trace);
+            size_t offset = (size_t)ReadLong(trace);
+
+            if (index < GLCAPTURE_MAX_ATTRIBS) index = trace->attribs[index];
+            glVertexAttribPointer(index, size, type, normalized, stride, (const void *)offset);
+        } break;
+        case GLCALL_VIEWPORT:
+        {
+            GLint x = ReadWord(trace);
+            GLint y = ReadWord(trace);
+            GLsizei width = ReadWord(trace);
+            GLsizei height = ReadWord(trace);
+            glViewport(x, y, width, height);
+        } break;
+        default:
+        {
+            GLCAPTURE_LOG("GLCAPTURE: Unknown call id (%i), trace replay stopped", call);
+            trace->position = trace->size;
+            return -1;
+        } break;
+    }
+
+    return call;
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition
+//----------------------------------------------------------------------------------
+
+// Write call id into trace
+static void WriteCall(GlCall call)
+{
+    unsigned char id = (unsigned char)call;
+
+    fwrite(&id, 1, 1, capture.file);
+    capture.position++;
+    capture.callsCount++;
+}
+
+// Write 32 bit word into trace (little-endian)
+static void WriteWord(unsigned int value)
+{
+    unsigned char bytes[4] = { value & 0xff, (value >> 8) & 0xff, (value >> 16) & 0xff, (value >> 24) & 0xff };
+
+    fwrite(bytes, 1, 4, capture.file);
+    capture.position += 4;
+}
+
+// Write float into trace
+static void WriteFloat(float value)
+{
+    unsigned int word = 0;
+
+    memcpy(&word, &value, sizeof(float));
+    WriteWord(word);
+}
+
+// Write 64 bit word into trace (little-endian: low word first)
+static void WriteLong(unsigned long long value)
+{
+    WriteWord((unsigned int)(value & 0xffffffff));
+    WriteWord((unsigned int)(value >> 32));
+}
+
+// Write data block into trace (NULL supported)
+// NOTE: Data is padded to 4 bytes file position, so it can be used in place on replay
+static void WriteData(const void *data, unsigned int size)
+{
+    static const unsigned char padding[4] = { 0 };
+
+    if (data == NULL) WriteWord(GLCAPTURE_NULL_DATA);
+    else
+    {
+        WriteWord(size);
+
+        unsigned int paddingSize = (4 - capture.position%4)%4;
+        fwrite(padding, 1, paddingSize, capture.file);
+        fwrite(data, 1, size, capture.file);
+        capture.position += paddingSize + size;
+    }
+}
+
+// Write NULL-terminated string as data block
+static void WriteString(const char *text)
+{
+    WriteData(text, (text != NULL)? (unsigned int)strlen(text) + 1 : 0);
+}
+
+// Get captured sync object index (-1 if not captured)
+static int GetSyncIndex(GLsync sync)
+{
+    for (int i = capture.syncsCount - 1; i >= 0; i--) if (capture.syncs[i] == sync) return i;
+
+    return -1;
+}
+
+// Get pixels data size, including rows padding
+static unsigned int GetPixelsDataSize(int width, int height, GLenum format, GLenum type, int alignment)
+{
+    int channels = 4;
+    int bytes = 1;          // Bytes per channel
+    int pixelSize = 0;
+
+    switch (format)
+    {
+        case GL_RED:
+        case GL_DEPTH_COMPONENT: channels = 1; break;
+        case GL_RG: channels = 2; break;
+        case GL_RGB:
+        case GL_BGR: channels = 3; break;
+        default: break;
+    }
+
+    switch (type)
+    {
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+        case GL_UNSIGNED_SHORT_4_4_4_4: pixelSize = 2; break;    // Packed pixel formats
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT: bytes = 2; break;
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT: bytes = 4; break;
+        default: break;
+    }
+
+    if (pixelSize == 0) pixelSize = channels*bytes;
+    if ((width <= 0) || (height <= 0)) return 0;
+    if (alignment < 1) alignment = 1;
+
+    unsigned int lastRowSize = width*pixelSize;
+    unsigned int rowSize = (lastRowSize + alignment - 1)/alignment*alignment;
+
+    return rowSize*(height - 1) + lastRowSize;
+}
+
+// Read 32 bit word from trace (little-endian)
+static unsigned int ReadWord(GlTrace *trace)
+{
+    unsigned int value = 0;
+
+    if ((trace->position + 4) <= trace->size)
+    {
+        const unsigned char *bytes = trace->data + trace->position;
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+    }
+
+    trace->position += 4;
+
+    return value;
+}
+
+// Read float from trace
+static float ReadFloat(GlTrace *trace)
+{
+    unsigned int word = ReadWord(trace);
+    float value = 0.0f;
+
+    memcpy(&value, &word, sizeof(float));
+
+    return value;
+}
+
+// Read 64 bit word from trace (little-endian: low word first)
+static unsigned long long ReadLong(GlTrace *trace)
+{
+    unsigned long long value = ReadWord(trace);
+
+    value |= (unsigned long long)ReadWord(trace) << 32;
+
+    return value;
+}
+
+// Read data block from trace (pointer into trace data)
+static const void *ReadData(GlTrace *trace, unsigned int *size)
+{
+    unsigned int dataSize = ReadWord(trace);
+    const void *data = NULL;
+
+    if (dataSize == GLCAPTURE_NULL_DATA) dataSize = 0;
+    else
+    {
+        trace->position += (4 - trace->position%4)%4;
+
+        if ((trace->position + dataSize) <= trace->size) data = trace->data + trace->position;
+        else dataSize = 0;
+
+        trace->position += dataSize;
+    }
+
+    if (size != NULL) *size = dataSize;
+
+    return data;
+}
+
+// Get replay object id from captured id
+// NOTE: Objects not created on trace keep their captured id
+static unsigned int MapObject(GlTrace *trace, int type, unsigned int id)
+{
+    if ((id < (unsigned int)trace->objectsCapacity[type]) && (trace->objects[type][id] != 0)) return trace->objects[type][id];
+
+    return id;
+}
+
+// Set replay object id for captured id
+static void SetObject(GlTrace *trace, int type, unsigned int id, unsigned int replayId)
+{
+    if (id >= (unsigned int)trace->objectsCapacity[type])
+    {
+        int capacity = id + 256;
+
+        trace->objects[type] = (unsigned int *)realloc(trace->objects[type], capacity*sizeof(unsigned int));
+        memset(trace->objects[type] + trace->objectsCapacity[type], 0, (capacity - trace->objectsCapacity[type])*sizeof(unsigned int));
+        trace->objectsCapacity[type] = capacity;
+    }
+
+    trace->objects[type][id] = replayId;
+}
+
+// Get replay uniform location (current program)
+// NOTE: Latest location queried is used (program ids could be reused after deletion)
+static int MapUniform(GlTrace *trace, int location)
+{
+    for (int i = trace->uniformsCount - 1; i >= 0; i--)
+    {
+        if ((trace->uniforms[i].program == trace->program) && (trace->uniforms[i].captured == location)) return trace->uniforms[i].location;
+    }
+
+    return location;
+}
+
+// Get/set replay mapped buffer pointer (slot released on get)
+static void *GetMappedPointer(GlTrace *trace, GLenum target, void *pointer, int set)
+{
+    for (int i = 0; i < GLCAPTURE_MAX_MAPPINGS; i++)
+    {
+        if (set && (trace->mappedTargets[i] == 0))
+        {
+            trace->mappedTargets[i] = target;
+            trace->mappedPointers[i] = pointer;
+            return pointer;
+        }
+        else if (!set && (trace->mappedTargets[i] == target))
+        {
+            trace->mappedTargets[i] = 0;
+            return trace->mappedPointers[i];
+        }
+    }
+
+    return NULL;
+}
+
+#endif  // GLCAPTURE_IMPLEMENTATION
@@ -8,6 +8,7 @@
 *   When chosing an OpenGL version greater than OpenGL 1.1, rlgl stores vertex data on internal
 *   VBO buffers (and VAOs if available). It requires calling 3 functions:
 *       rlglInit()  - Initialize internal buffers and auxiliar resources
+*       rlglInitEx() - Initialize rlgl with custom internal buffers initial capacity
 *       rlglDraw()  - Process internal buffers and send required draw calls
 *       rlglClose() - De-initialize internal buffers data and other auxiliar resources
 *
@@ -21,6 +22,19 @@
 *       Those preprocessor defines are only used on rlgl module, if OpenGL version is
 *       required by any other module, use rlGetVersion() tocheck it
 *
+*   #define GRAPHICS_API_SOFTWARE
+*       Use software rasterizer backend, no OpenGL (or GPU) required. Default buffers and meshes
+*       are rasterized on CPU into a RGBA8 framebuffer (tiled and multi-threaded), to be read
+*       with rlReadScreenPixels(). Fixed pipeline: textured and colored triangles, depth test
+*       and blending modes, custom shaders and render textures are not supported
+*
+*   #define RLGL_SW_THREADS
+*       Software rasterizer threads (default: 4), 1 rasterizes on calling thread (no pthreads)
+*
+*   #define RLGL_CAPTURE
+*       Support OpenGL calls capture into a binary trace (OpenGL 3.3 only), to be replayed offline
+*       for benchmarking, see rlBeginCapture(). Requires glcapture.h
+*
 *   #define RLGL_IMPLEMENTATION
 *       Generates the implementation of the library into the included file.
 *       If not defined, the library is in header only mode and can be included in other headers
@@ -38,6 +52,8 @@
 *   DEPENDENCIES:
 *       raymath     - 3D math functionality (Vector3, Matrix, Quaternion)
 *       GLAD        - OpenGL extensions loading (OpenGL 3.3 Core only)
+*       pthreads    - Software rasterizer worker threads (GRAPHICS_API_SOFTWARE only)
+*       glcapture   - OpenGL calls capture (RLGL_CAPTURE only)
 *
 *
 *   LICENSE: zlib/libpng
@@ -77,11 +93,20 @@
 #if !defined(GRAPHICS_API_OPENGL_11) && \
     !defined(GRAPHICS_API_OPENGL_21) && \
     !defined(GRAPHICS_API_OPENGL_33) && \
-    !defined(GRAPHICS_API_OPENGL_ES2)
+    !defined(GRAPHICS_API_OPENGL_ES2) && \
+    !defined(GRAPHICS_API_SOFTWARE)
         #define GRAPHICS_API_OPENGL_33
 #endif
 
 // Security check in case multiple GRAPHICS_API_OPENGL_* defined
+// NOTE: Software rasterizer does not use OpenGL at all
+#if defined(GRAPHICS_API_SOFTWARE)
+    #undef GRAPHICS_API_OPENGL_11
+    #undef GRAPHICS_API_OPENGL_21
+    #undef GRAPHICS_API_OPENGL_33
+    #undef GRAPHICS_API_OPENGL_ES2
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_11)
     #if defined(GRAPHICS_API_OPENGL_21)
         #undef GRAPHICS_API_OPENGL_21
@@ -101,17 +126,20 @@
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
-#if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
-    // NOTE: This is the maximum amount of lines, triangles and quads per frame, be careful!
+#if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_SOFTWARE)
+    // NOTE: This is the default initial amount of lines, triangles and quads per batch,
+    // buffers grow when required (up to MAX_BATCH_VERTEX), initial amount can be set with rlglInitEx()
     #define MAX_LINES_BATCH         8192
     #define MAX_TRIANGLES_BATCH     4096
     #define MAX_QUADS_BATCH         8192
+    #define MAX_BATCH_VERTEX        (1 << 22)   // Maximum vertex per batch (buffers growth limit)
 #elif defined(GRAPHICS_API_OPENGL_ES2)
     // NOTE: Reduce memory sizes for embedded systems (RPI and HTML5)
     // NOTE: On HTML5 (emscripten) this is allocated on heap, by default it's only 16MB!...just take care...
     #define MAX_LINES_BATCH         1024    // Critical for wire shapes (sphere)
     #define MAX_TRIANGLES_BATCH     2048    // Critical for some shapes (sphere)
     #define MAX_QUADS_BATCH         1024    // Be careful with text, every letter maps a quad
+    #define MAX_BATCH_VERTEX        65536   // Maximum vertex per batch (quads indices are unsigned short)
 #endif
 
 // Texture parameters (equivalent to OpenGL defines)
@@ -142,13 +170,44 @@
 #define RL_TRIANGLES                    0x0004      // GL_TRIANGLES
 #define RL_QUADS                        0x0007      // GL_QUADS
 
+// Quads draw calls sorting modes (deferred submission)
+#define RL_SORT_NONE                    0           // Draw calls submitted in recording order (default)
+#define RL_SORT_DEPTH                   1           // Sorted by layer, recording order kept inside a layer (depth order wins)
+#define RL_SORT_STATE                   2           // Sorted by layer and texture (state order wins)
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-typedef enum { OPENGL_11 = 1, OPENGL_21, OPENGL_33, OPENGL_ES_20 } GlVersion;
+typedef enum { OPENGL_11 = 1, OPENGL_21, OPENGL_33, OPENGL_ES_20, SOFTWARE_RENDERER } GlVersion;
 
 typedef unsigned char byte;
 
+// Rendering statistics (accumulated until reset, usually once per frame)
+typedef struct RenderStats {
+    int flushes;                // Default buffers flushes (update + draw), all reasons
+    int flushesExplicit;        // Flushes requested with rlglDraw()
+    int flushesCapacity;        // Flushes forced by buffers growth limit (MAX_BATCH_VERTEX)
+    int flushesDrawsLimit;      // Flushes forced by draw calls (texture changes) array limit
+    int flushesState;           // Flushes forced by state changes (shader, blending mode)
+    int drawCalls;              // OpenGL draw calls (default buffers and meshes)
+    int linesVertex;            // Lines vertex drawn
+    int trianglesVertex;        // Triangles vertex drawn
+    int quadsVertex;            // Quads vertex drawn
+    int bytesUploaded;          // Vertex data bytes uploaded by default buffers update
+    int textureBinds;           // Texture binds for drawing
+    int shaderSwitches;         // Shader program changes for drawing
+    int stateFiltered;          // Redundant OpenGL state calls filtered by state cache
+} RenderStats;
+
+// Command buffer: vertex data recorded on a worker thread, merged into default buffers on GL thread
+// NOTE: Data structure is internal, use rlLoadCommandBuffer() and rlUnloadCommandBuffer()
+typedef struct CommandBuffer CommandBuffer;
+
+// Pixels readback callback, pixels memory is only valid inside the callback (mapped pixel buffer)
+// NOTE: Row y starts at pixels + y*stride, rows are top-down without flipping copy required:
+// screen readbacks use a negative stride (OpenGL framebuffer rows are stored bottom-up)
+typedef void (*ReadbackCallback)(const unsigned char *pixels, int width, int height, int stride, void *userData);
+
 #if defined(RLGL_STANDALONE)
     #ifndef __cplusplus
     // Boolean type
@@ -410,6 +469,7 @@ void rlNormal3f(float x, float y, float z);     // Define one vertex (normal) -
 void rlColor4ub(byte r, byte g, byte b, byte a);    // Define one vertex (color) - 4 byte
 void rlColor3f(float x, float y, float z);          // Define one vertex (color) - 3 float
 void rlColor4f(float x, float y, float z, float w); // Define one vertex (color) - 4 float
+void rlQuad2f(const float *positions, const float *texcoords, Color color); // Define one quad (4 vertex), pushed matrix transform applied
 
 //------------------------------------------------------------------------------------
 // Functions Declaration - OpenGL equivalent functions (common to 1.1, 3.3+, ES2)
@@ -422,6 +482,8 @@ void rlEnableRenderTexture(unsigned int id);            // Enable render texture
 void rlDisableRenderTexture(void);                      // Disable render texture (fbo), return to default framebuffer
 void rlEnableDepthTest(void);                           // Enable depth test
 void rlDisableDepthTest(void);                          // Disable depth test
+void rlEnableAlphaTest(void);                           // Enable alpha test (fully transparent fragments discarded)
+void rlDisableAlphaTest(void);                          // Disable alpha test
 void rlEnableWireMode(void);                            // Enable wire mode
 void rlDisableWireMode(void);                           // Disable wire mode
 void rlDeleteTextures(unsigned int id);                 // Delete OpenGL texture from GPU
@@ -436,13 +498,31 @@ void rlClearScreenBuffers(void);                        // Clear used screen buf
 // Functions Declaration - rlgl functionality
 //------------------------------------------------------------------------------------
 void rlglInit(int width, int height);           // Initialize rlgl (buffers, shaders, textures, states)
+void rlglInitEx(int width, int height, int linesCount, int trianglesCount, int quadsCount); // Initialize rlgl with buffers initial capacity (lines, triangles, quads)
 void rlglClose(void);                           // De-inititialize rlgl (buffers, shaders, textures)
 void rlglDraw(void);                            // Update and Draw default buffers (lines, triangles, quads)
 
 int rlGetVersion(void);                         // Returns current OpenGL version
 bool rlCheckBufferLimit(int type, int vCount);  // Check internal buffer overflow for a given number of vertex
+int rlGetBufferCapacity(int type);              // Get internal buffer current capacity (vertex count)
+int rlGetBufferHighWater(int type);             // Get internal buffer high-water mark (max vertex count in a batch)
+void rlSetDrawSortMode(int mode);               // Set quads draw calls sorting mode (deferred submission)
+void rlSetDrawLayer(int layer);                 // Set quads draw layer (most significant sort key)
+RenderStats rlGetRenderStats(void);             // Get rendering statistics (accumulated since last reset)
+void rlResetRenderStats(void);                  // Reset rendering statistics (call once per frame)
+void rlTraceRenderStats(void);                  // Log rendering statistics with TraceLog()
+void rlResetStateCache(void);                   // Reset OpenGL state cache (required after OpenGL calls out of rlgl)
 void rlSetDebugMarker(const char *text);        // Set debug marker for analysis
+
+// Command buffers (multi-threaded vertex data recording)
+CommandBuffer *rlLoadCommandBuffer(void);                   // Load command buffer to record vertex data
+void rlUnloadCommandBuffer(CommandBuffer *buffer);          // Unload command buffer
+void rlBeginCommandBuffer(CommandBuffer *buffer);           // Begin recording into command buffer (calling thread)
+void rlEndCommandBuffer(void);                              // End recording into command buffer (calling thread)
+void rlSubmitCommandBuffer(CommandBuffer *buffer);          // Merge command buffer vertex data into default buffers (GL thread)
 void rlLoadExtensions(void *loader);            // Load OpenGL extensions
+bool rlBeginCapture(const char *fileName, int framesCount); // Begin OpenGL calls capture (call after rlLoadExtensions(), before rlglInit())
+void rlCaptureFrame(void);                      // Mark captured frame end (call before swapping buffers)
 Vector3 rlUnproject(Vector3 source, Matrix proj, Matrix view);  // Get world coordinates from screen coordinates
 
 // Textures data management
@@ -452,6 +532,10 @@ void rlUnloadTexture(unsigned int id);
 void rlGenerateMipmaps(Texture2D *texture);                         // Generate mipmap data for selected texture
 void *rlReadTexturePixels(Texture2D texture);                       // Read texture pixel data
 unsigned char *rlReadScreenPixels(int width, int height);           // Read screen pixel data (color buffer)
+void rlReadScreenPixelsAsync(int width, int height, ReadbackCallback callback, void *userData);  // Issue screen pixels readback (RGBA), completed by rlUpdateReadbacks()
+void rlReadTexturePixelsAsync(Texture2D texture, ReadbackCallback callback, void *userData);     // Issue texture pixels readback (texture format), completed by rlUpdateReadbacks()
+void rlUpdateReadbacks(void);                                       // Complete readbacks issued two frames ago, calling their callbacks (call once per frame)
+void rlFlushReadbacks(void);                                        // Complete all pending readbacks (waits for GPU)
 RenderTexture2D rlLoadRenderTexture(int width, int height);         // Load a texture to be used for rendering (fbo with color and depth attachments)
 
 // Vertex data management
@@ -480,6 +564,7 @@ Texture2D GetTextureDefault(void);                                  // Get defau
 // Shader configuration functions
 int GetShaderLocation(Shader shader, const char *uniformName);              // Get shader uniform location
 void SetShaderValue(Shader shader, int uniformLoc, const float *value, int size); // Set shader uniform value (float)
+void SetShaderValueV(Shader shader, int uniformLoc, const float *value, int size, int count); // Set shader uniform value array (float)
 void SetShaderValuei(Shader shader, int uniformLoc, const int *value, int size);  // Set shader uniform value (int)
 void SetShaderValueMatrix(Shader shader, int uniformLoc, Matrix mat);       // Set shader uniform value (matrix 4x4)
 void SetMatrixProjection(Matrix proj);                              // Set a custom projection matrix (replaces internal projection matrix)
@@ -535,9 +620,16 @@ int GetPixelDataSize(int width, int height, int format);// Get pixel data size i
     #include "config.h"             // rlgl module configuration
 #endif
 
+#if defined(GRAPHICS_API_SOFTWARE)
+    // NOTE: VR stereo rendering requires render textures and shaders (not supported by software rasterizer)
+    #undef SUPPORT_VR_SIMULATOR
+    #undef SUPPORT_DISTORTION_SHADER
+#endif
+
 #include <stdio.h>                  // Required for: fopen(), fclose(), fread()... [Used only on LoadText()]
 #include <stdlib.h>                 // Required for: malloc(), free(), rand()
 #include <string.h>                 // Required for: strcmp(), strlen(), strtok() [Used only in extensions loading]
+#include <stddef.h>                 // Required for: offsetof() [Used only on default buffers vertex attributes]
 #include <math.h>                   // Required for: atan2()
 
 #if !defined(RLGL_STANDALONE)
@@ -581,6 +673,16 @@ int GetPixelDataSize(int width, int height, int format);// Get pixel data size i
         #else
             #include "external/glad.h"  // GLAD extensions loading library, includes OpenGL headers
         #endif
+
+        #if defined(RLGL_CAPTURE)
+            #define GLCAPTURE_IMPLEMENTATION
+            #define GLCAPTURE_LOG(...) TraceLog(LOG_INFO, __VA_ARGS__)
+            #if defined(RLGL_STANDALONE)
+                #include "glcapture.h"          // OpenGL calls capture and replay
+            #else
+                #include "external/glcapture.h" // OpenGL calls capture and replay
+            #endif
+        #endif
     #endif
 #endif
 
@@ -590,17 +692,79 @@ int GetPixelDataSize(int width, int height, int format);// Get pixel data size i
     #include <GLES2/gl2ext.h>           // OpenGL ES 2.0 extensions library
 #endif
 
+#if defined(GRAPHICS_API_SOFTWARE)
+    #if !defined(RLGL_SW_THREADS)
+        #define RLGL_SW_THREADS         4   // Software rasterizer threads (calling thread included)
+    #endif
+    #if (RLGL_SW_THREADS > 1)
+        #include <pthread.h>            // POSIX threads: pthread_create(), pthread_cond_wait()
+    #endif
+
+    // NOTE: No OpenGL headers, state cache types and enums are used as software pipeline state
+    typedef unsigned int GLenum;
+    typedef unsigned int GLuint;
+
+    #define GL_ONE                      1
+    #define GL_SRC_ALPHA                0x0302
+    #define GL_ONE_MINUS_SRC_ALPHA      0x0303
+    #define GL_DST_COLOR                0x0306
+    #define GL_CULL_FACE                0x0B44
+    #define GL_DEPTH_TEST               0x0B71
+    #define GL_BLEND                    0x0BE2
+#endif
+
 #if defined(RLGL_STANDALONE)
     #include <stdarg.h>                 // Required for: va_list, va_start(), vfprintf(), va_end() [Used only on TraceLog()]
 #endif
 
+// SIMD vertex transformation (SSE), it can be disabled defining RLGL_NO_SIMD
+#if !defined(RLGL_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1)))
+    #define RLGL_SIMD_SSE
+    #include <xmmintrin.h>              // Required for: SSE intrinsics [Used only on TransformVertices()]
+#endif
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
 #define MATRIX_STACK_SIZE          16   // Matrix stack max size
-#define MAX_DRAWS_BY_TEXTURE      256   // Draws are organized by texture changes
+#define MAX_DRAWS_BY_TEXTURE      256   // Draws are organized by texture changes (initial capacity, grows when required)
 #define TEMP_VERTEX_BUFFER_SIZE  4096   // Temporal Vertex Buffer (required for vertex-transformations)
                                         // NOTE: Every vertex are 3 floats (12 bytes)
+#define DEFAULT_BUFFERS_SEGMENTS    3   // Default buffers streaming segments (ring buffer, GPU reads one while CPU writes other)
+#define READBACK_BUFFERS            4   // Asynchronous pixels readback buffers (ring of pixel buffer objects in flight)
+#define READBACK_FRAMES_LATENCY     2   // Frames between readback issue and pixels mapping (GPU finished the read)
+
+// Default buffers streaming modes (GPU vertex data update)
+#define STREAM_MODE_SUBDATA         0   // Same buffer updated with glBufferSubData() (implicit synchronization)
+#define STREAM_MODE_UNSYNCHRONIZED  1   // Ring buffer segments updated with unsynchronized glMapBufferRange(), guarded by fences
+#define STREAM_MODE_PERSISTENT      2   // Ring buffer persistently mapped, vertex data written directly, guarded by fences
+
+// Thread local storage (command buffer recording)
+#if defined(_MSC_VER)
+    #define RL_THREAD_LOCAL __declspec(thread)
+#else
+    #define RL_THREAD_LOCAL __thread
+#endif
+
+#define COMMAND_BUFFER_VERTEX    4096   // Command buffer vertex data initial capacity (grows when required)
+#define COMMAND_BUFFER_COMMANDS   256   // Command buffer commands initial capacity (grows when required)
+
+// Default buffers flush reasons (rendering statistics)
+#define FLUSH_EXPLICIT              0   // Requested by user: rlglDraw()
+#define FLUSH_CAPACITY              1   // Buffers growth limit reached
+#define FLUSH_DRAWS_LIMIT           2   // Draw calls array can not grow (texture changes)
+#define FLUSH_STATE                 3   // State change: shader, blending mode
+
+// OpenGL state cache
+#define STATE_UNKNOWN      0xFFFFFFFF   // Cached id value unknown (next state change is not filtered)
+#define STATE_TEXTURE_UNITS        16   // Texture units tracked by state cache (GL_TEXTURE_2D binding)
+#define STATE_UNIFORM_PROGRAMS      8   // Shader programs with cached uniform values
+#define STATE_UNIFORM_LOCATIONS    32   // Uniform locations cached per shader program
+
+// Software rasterizer (GRAPHICS_API_SOFTWARE)
+#define SW_TILE_SIZE               64   // Framebuffer tile size (tiles are rasterized in parallel)
+#define SW_MAX_TRIANGLES        16384   // Triangles queued before being rasterized (resolve)
+#define SW_SUBPIXEL_STEPS      256.0f   // Vertex position subpixel precision (8 bits)
 
 #ifndef GL_SHADING_LANGUAGE_VERSION
     #define GL_SHADING_LANGUAGE_VERSION         0x8B8C
@@ -677,22 +841,30 @@ int GetPixelDataSize(int width, int height, int format);// Get pixel data size i
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 
-// Dynamic vertex buffers (position + texcoords + colors + indices arrays)
+// Dynamic buffer vertex (interleaved vertex data, 24 bytes)
+typedef struct DynamicVertex {
+    float position[3];          // vertex position (XYZ - 3 components per vertex) (shader-location = 0)
+    float texcoord[2];          // vertex texture coordinates (UV - 2 components per vertex) (shader-location = 1)
+    unsigned char color[4];     // vertex colors (RGBA - 4 components per vertex) (shader-location = 3)
+} DynamicVertex;
+
+// Dynamic vertex buffers (interleaved vertex data + indices arrays)
 typedef struct DynamicBuffer {
     int vCounter;               // vertex position counter to process (and draw) from full buffer
     int tcCounter;              // vertex texcoord counter to process (and draw) from full buffer
     int cCounter;               // vertex color counter to process (and draw) from full buffer
-    float *vertices;            // vertex position (XYZ - 3 components per vertex) (shader-location = 0)
-    float *texcoords;           // vertex texture coordinates (UV - 2 components per vertex) (shader-location = 1)
-    unsigned char *colors;      // vertex colors (RGBA - 4 components per vertex) (shader-location = 3)
-#if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
+    int vCapacity;              // vertex capacity (buffer size in vertex, grows when required)
+    int vCounterMax;            // vertex counter high-water mark (max vertex drawn in a batch)
+    DynamicVertex *vertices;    // vertex data (position, texcoords and color interleaved)
+#if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_SOFTWARE)
     unsigned int *indices;      // vertex indices (in case vertex data comes indexed) (6 indices per quad)
 #elif defined(GRAPHICS_API_OPENGL_ES2)
     unsigned short *indices;    // vertex indices (in case vertex data comes indexed) (6 indices per quad)
                                 // NOTE: 6*2 byte = 12 byte, not alignment problem!
 #endif
     unsigned int vaoId;         // OpenGL Vertex Array Object id
-    unsigned int vboId[4];      // OpenGL Vertex Buffer Objects id (4 types of vertex data)
+    unsigned int vboId[2];      // OpenGL Vertex Buffer Objects id (vertex data and indices)
+    void *mapped;               // OpenGL vertex data Vertex Buffer Object mapped memory (persistent streaming mode)
 } DynamicBuffer;
 
 // Draw call type
@@ -702,6 +874,8 @@ typedef struct DrawCall {
     GLuint vaoId;
     GLuint textureId;
     GLuint shaderId;
+    int layer;                  // Draw layer (sort key: layer, texture)
+    int vertexOffset;           // First vertex in quads buffer (used on draw calls sorting)
 
     Matrix projection;
     Matrix modelview;
@@ -711,6 +885,162 @@ typedef struct DrawCall {
     //Guint fboId;
 } DrawCall;
 
+// Recorded command type
+// NOTE: Commands are organized by primitive type and texture changes, like draw calls
+typedef struct RecordCommand {
+    int mode;                   // Primitive type: RL_LINES, RL_TRIANGLES, RL_QUADS
+    unsigned int textureId;     // Quads texture id (0: keep default buffers current texture)
+    bool relativeDepth;         // Vertex depth is relative to default buffers depth on submission (2D vertex)
+    int vertexOffset;           // First vertex in command buffer vertex data
+    int vertexCount;            // Vertex count
+} RecordCommand;
+
+// Command buffer type
+// NOTE: Recording state is independent from default buffers, so it can be used on any thread
+struct CommandBuffer {
+    DynamicVertex *vertices;    // Vertex data (position, texcoords and color interleaved)
+    int vertexCount;            // Vertex data count
+    int vertexCapacity;         // Vertex data capacity (grows when required)
+    RecordCommand *commands;    // Recorded commands
+    int commandsCount;          // Recorded commands count
+    int commandsCapacity;       // Recorded commands capacity (grows when required)
+
+    int mode;                   // Current draw mode
+    unsigned int textureId;     // Current texture id
+    float depth;                // Current depth (relative, 2D vertex)
+    float texcoord[2];          // Current texture coordinates
+    unsigned char color[4];     // Current color
+    Matrix transform;           // Current transform (modelview matrix stack)
+    bool transformRequired;     // Vertex transform required (transform modified)
+    Matrix stack[MATRIX_STACK_SIZE];
+    int stackCounter;
+};
+
+// Shader program uniform values cache
+// NOTE: Values are stored as raw 32 bit words, up to a 4x4 matrix per location
+typedef struct UniformCache {
+    unsigned int programId;                                 // Shader program id (0: cache slot not used)
+    unsigned char size[STATE_UNIFORM_LOCATIONS];            // Cached value size in words (0: value unknown)
+    unsigned int value[STATE_UNIFORM_LOCATIONS][16];        // Cached values
+} UniformCache;
+
+// OpenGL state cache, used to filter redundant state changes
+// NOTE: Only state changed through rlgl is tracked, rlResetStateCache() must be called after external OpenGL calls
+typedef struct StateCache {
+    unsigned int program;                           // Current shader program
+    int activeTexture;                              // Current active texture unit (-1: unknown)
+    unsigned int textures[STATE_TEXTURE_UNITS];     // Current GL_TEXTURE_2D binding per texture unit
+    unsigned int vertexArray;                       // Current VAO
+    unsigned int arrayBuffer;                       // Current GL_ARRAY_BUFFER binding
+    unsigned int elementBuffer;                     // Current GL_ELEMENT_ARRAY_BUFFER binding (VAO state)
+    int blend;                                      // GL_BLEND enabled (-1: unknown)
+    int depthTest;                                  // GL_DEPTH_TEST enabled (-1: unknown)
+    int cullFace;                                   // GL_CULL_FACE enabled (-1: unknown)
+    unsigned int blendSrc;                          // Current blending function source factor
+    unsigned int blendDst;                          // Current blending function destination factor
+
+    UniformCache uniforms[STATE_UNIFORM_PROGRAMS];  // Shader programs uniform values
+    UniformCache *currentUniforms;                  // Current shader program uniform values (NULL: not cached)
+    int nextUniforms;                               // Next uniforms cache slot to be replaced (round robin)
+} StateCache;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+// Asynchronous pixels readback: pixels read into a pixel buffer object, mapped frames later
+typedef struct ReadbackBuffer {
+    unsigned int pboId;         // Pixel buffer object id
+    unsigned int size;          // Pixel buffer object size (bytes)
+    bool pending;               // Readback issued, waiting to be completed
+    GLsync fence;               // Fence signaled once GPU finished the read
+    int frame;                  // Frame readback was issued (rlUpdateReadbacks() calls counter)
+    int sequence;               // Issue order (readbacks are completed in order)
+    int width;                  // Pixels width
+    int height;                 // Pixels height
+    int stride;                 // Row stride (bytes), negative for bottom-up rows
+    ReadbackCallback callback;  // Callback receiving mapped pixels
+    void *userData;             // Callback user data
+} ReadbackBuffer;
+#endif
+
+#if defined(GRAPHICS_API_SOFTWARE)
+// Software rasterizer texture, texels stored as R8G8B8A8
+typedef struct SwTexture {
+    int width;                  // Texture width
+    int height;                 // Texture height
+    bool clampU;                // Texture coordinate U clamped (false: repeat)
+    bool clampV;                // Texture coordinate V clamped (false: repeat)
+    Color *data;                // Texels data (NULL: texture slot not used)
+} SwTexture;
+
+// Software rasterizer vertex, attributes are divided by w (perspective correct interpolation)
+typedef struct SwVertex {
+    float x, y, z;              // Screen position (pixels, top-down rows) and depth [0..1]
+    float invW;                 // Clip space w reciprocal
+    float u, v;                 // Texture coordinates
+    float color[4];             // Normalized color (RGBA)
+} SwVertex;
+
+// Software rasterizer edge function, evaluated at pixel centers
+// NOTE: Edge origin is the top-left endpoint, shared edges get the same values with opposite sign
+typedef struct SwEdge {
+    float x, y;                 // Edge origin
+    float dx, dy;               // Edge direction
+    float sign;                 // Edge function sign (-1.0f: endpoints swapped)
+    bool inclusive;             // Pixel centers on the edge are covered (top-left fill rule)
+} SwEdge;
+
+// Software rasterizer triangle, pipeline state is stored on submission
+typedef struct SwTriangle {
+    SwVertex v[3];              // Triangle vertex (counter-clockwise on screen)
+    SwEdge edges[3];            // Triangle edges (edge i is opposite to vertex i)
+    float area;                 // Triangle doubled area (barycentric coordinates normalization)
+    int minX, minY;             // Bounding box (clipped to viewport)
+    int maxX, maxY;
+    unsigned int textureId;     // Texture to be sampled
+    bool depthTest;             // Depth test (GL_LEQUAL) and depth write enabled
+    bool alphaTest;             // Fully transparent fragments discarded (no color and depth write)
+    bool blend;                 // Blending enabled
+    GLenum blendSrc;            // Blending function source factor
+    GLenum blendDst;            // Blending function destination factor
+} SwTriangle;
+
+// Software rasterizer framebuffer tile, triangles are binned in submission order
+typedef struct SwTile {
+    int *triangles;             // Queued triangles indices overlapping tile
+    int count;
+    int capacity;
+} SwTile;
+
+// Software rasterizer context: framebuffer, textures, triangles queue and worker threads
+typedef struct SwContext {
+    int width;                  // Framebuffer width
+    int height;                 // Framebuffer height
+    Color *color;               // Color buffer (top-down rows)
+    float *depth;               // Depth buffer
+    int viewport[4];            // Viewport (x, y, width, height), bottom-left origin
+    Color clearColor;           // Color buffer clear value
+
+    SwTexture *textures;        // Textures slots (texture id: slot index + 1)
+    int texturesCount;
+
+    SwTriangle *triangles;      // Triangles queue, rasterized on resolve
+    int trianglesCount;
+
+    SwTile *tiles;              // Framebuffer tiles (rasterized in parallel)
+    int tilesX;
+    int tilesY;
+
+#if (RLGL_SW_THREADS > 1)
+    pthread_t threads[RLGL_SW_THREADS - 1];
+    pthread_mutex_t mutex;
+    pthread_cond_t start;       // Workers wait for a new resolve
+    pthread_cond_t done;        // Resolve waits for workers
+    int generation;             // Resolves started (workers wake up on change)
+    int pending;                // Workers still rasterizing current resolve
+    bool quit;
+#endif
+} SwContext;
+#endif
+
 #if defined(SUPPORT_VR_SIMULATOR)
 // VR Stereo rendering configuration for simulator
 typedef struct VrStereoConfig {
@@ -804,14 +1134,17 @@ typedef struct VrStereoConfig {
     "} \n";
 #endif
 
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
 static Matrix stack[MATRIX_STACK_SIZE];
 static int stackCounter = 0;
 
 static Matrix modelview = { 0 };
 static Matrix projection = { 0 };
+static Matrix transformMatrix = { 0 };      // Vertex transform on CPU (modelview matrix stack, inside rlPushMatrix()/rlPopMatrix())
 static Matrix *currentMatrix = NULL;
 static int currentMatrixMode = -1;
+static bool transformRequired = false;      // Vertex transform required (modelview matrix stack not empty)
+static int modelviewStackCounter = 0;       // Modelview matrices pushed into stack (projection pushes not counted)
 
 static int currentDrawMode = -1;
 
@@ -824,19 +1157,55 @@ static DynamicBuffer quads = { 0 };         // Default dynamic buffer for quads
 // Default buffers draw calls
 static DrawCall *draws = NULL;
 static int drawsCounter = 0;
+static int drawsCapacity = 0;
+static int drawSortMode = RL_SORT_NONE;     // Quads draw calls sorting mode (deferred submission)
+static int currentLayer = 0;                // Current quads draw layer
+static DynamicVertex *sortVertices = NULL;  // Quads vertex data sorted by draw calls (sorting scratch buffer)
+static int sortVerticesCapacity = 0;
+
+static RenderStats stats = { 0 };           // Rendering statistics (reset by user)
+static StateCache state = { 0 };            // OpenGL state cache (redundant state changes filtering)
+#if defined(GRAPHICS_API_SOFTWARE)
+static SwContext sw = { 0 };                // Software rasterizer context (framebuffer, textures, triangles queue)
+#endif
+
+// Command buffer being recorded by current thread (NULL: recording into default buffers)
+static RL_THREAD_LOCAL CommandBuffer *currentCommandBuffer = NULL;
+
+// Default buffers streaming: vertex data for every draw is stored in next ring buffer segment
+static int streamMode = STREAM_MODE_SUBDATA;
+static int streamSegment = 0;               // Current segment (vertex data being written)
+#if defined(GRAPHICS_API_OPENGL_33)
+static GLsync streamFences[DEFAULT_BUFFERS_SEGMENTS] = { 0 };   // Segments fences (GPU reading segment)
+
+// Asynchronous pixels readback (requires pixel buffer objects and fences, OpenGL 3.2)
+static ReadbackBuffer readbacks[READBACK_BUFFERS] = { 0 };
+static bool readbackAsyncSupported = false;
+static int readbackFrame = 0;               // Current readback frame (rlUpdateReadbacks() calls)
+static int readbackSequence = 0;            // Readbacks issued counter
+#endif
 
 // Temp vertex buffer to be used with rlTranslate, rlRotate, rlScale
 static Vector3 *tempBuffer = NULL;
 static int tempBufferCount = 0;
-static bool useTempBuffer = false;
 
 // Shaders
+#if !defined(GRAPHICS_API_SOFTWARE)
 static unsigned int defaultVShaderId;       // Default vertex shader id (used by default shader program)
 static unsigned int defaultFShaderId;       // Default fragment shader Id (used by default shader program)
+#endif
 
 static Shader defaultShader;                // Basic shader, support vertex color and diffuse texture
 static Shader currentShader;                // Shader to be used on rendering (by default, defaultShader)
 
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+static bool alphaTest = false;              // Alpha test enabled (fully transparent fragments discarded, no depth write)
+#endif
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+static int defaultAlphaTestLoc = -1;        // Default shader alpha test uniform location
+#endif
+
+#if !defined(GRAPHICS_API_SOFTWARE)
 // Extension supported flag: VAO
 static bool vaoSupported = false;           // VAO support (OpenGL ES2 could not support VAO extension)
 
@@ -845,6 +1214,7 @@ static bool texCompETC1Supported = false;   // ETC1 texture compression support
 static bool texCompETC2Supported = false;   // ETC2/EAC texture compression support
 static bool texCompPVRTSupported = false;   // PVR texture compression support
 static bool texCompASTCSupported = false;   // ASTC texture compression support
+#endif
 
 #if defined(SUPPORT_VR_SIMULATOR)
 // VR global variables
@@ -854,8 +1224,10 @@ static bool vrStereoRender = false;     // VR stereo rendering enabled/disabled
                                         // NOTE: This flag is useful to render data over stereo image (i.e. FPS)
 #endif  // defined(SUPPORT_VR_SIMULATOR)
 
-#endif  // defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#endif  // defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
 
+// NOTE: Extensions are not checked by software rasterizer (no OpenGL)
+#if !defined(GRAPHICS_API_SOFTWARE)
 // Extension supported flag: Anisotropic filtering
 static bool texAnisotropicFilterSupported = false;  // Anisotropic texture filtering support
 static float maxAnisotropicLevel = 0.0f;            // Maximum anisotropy level supported (minimum is 2.0f)
@@ -877,6 +1249,7 @@ static bool debugMarkerSupported = false;
 static bool texCompDXTSupported = false;    // DDS texture compression support
 static bool texNPOTSupported = false;       // NPOT textures full support
 static bool texFloatSupported = false;      // float textures support (32 bit per channel)
+#endif
 
 static int blendMode = 0;   // Track current blending mode
 
@@ -890,7 +1263,34 @@ static int screenHeight;    // Default framebuffer height
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+static void LoadBuffersDefault(int linesCount, int trianglesCount, int quadsCount);  // Load default internal buffers (lines, triangles, quads)
+static bool GrowBufferDefault(DynamicBuffer *buffer, int vertexCount);  // Grow default internal buffer capacity to fit vertex count
+static void PushDrawCall(unsigned int textureId);   // Start a new quads draw call with current state (layer, shader)
+static void SortDrawCalls(void);            // Sort quads draw calls by key and merge draws sharing state
+static int CompareDrawCalls(const void *a, const void *b);  // Compare draw calls sort keys (qsort)
+static void DrawBuffersDefault(void);       // Draw default internal buffers vertex data
+static void FlushBuffersDefault(int reason); // Sort, update and draw default internal buffers (keeping recording state)
+static void UnloadBuffersDefault(void);     // Unload default internal buffers vertex data from CPU and GPU
+static void SetBuffersDefaultSegment(int segment);  // Set default buffers current segment (wait GPU, point to mapped memory)
+#if defined(GRAPHICS_API_OPENGL_33)
+static ReadbackBuffer *GetReadbackBuffer(unsigned int size);    // Get free readback buffer with required size (oldest completed if none free)
+static ReadbackBuffer *GetOldestReadback(void);     // Get oldest pending readback (NULL if none)
+static void SubmitReadback(ReadbackBuffer *readback, int width, int height, int stride, ReadbackCallback callback, void *userData);  // Fence read pixels and set readback pending
+static void CompleteReadback(ReadbackBuffer *readback); // Wait readback fence, map pixels and call readback callback
+#endif
+static void TransformVertices(const Vector3 *input, DynamicVertex *output, int count, Matrix mat);  // Transform vertices by matrix (SIMD batch)
+static void TransformTempBuffer(void);      // Transform temp buffer vertices into current draw mode buffer
+static Matrix *GetCurrentMatrix(void);      // Get current matrix to be transformed (command buffer transform if recording)
+static bool GrowCommandBuffer(CommandBuffer *buffer, int vertexCount);  // Grow command buffer vertex data to fit vertex count
+static void RecordVertex(CommandBuffer *buffer, int mode, Vector3 position, bool relativeDepth);  // Record one vertex with current state (texcoords, color)
+
+static void SetActiveTexture(int unit);     // Set active texture unit (filtered by state cache)
+static void SetTexture(int unit, unsigned int id);  // Bind 2D texture to texture unit (filtered by state cache)
+static void SetCapability(GLenum cap, bool enabled);    // Enable/disable OpenGL capability (filtered by state cache)
+static void SetBlendFunc(GLenum src, GLenum dst);   // Set blending function (filtered by state cache)
+
+#if !defined(GRAPHICS_API_SOFTWARE)
 static unsigned int CompileShader(const char *shaderStr, int type);     // Compile custom shader and return shader id
 static unsigned int LoadShaderProgram(unsigned int vShaderId, unsigned int fShaderId);  // Load custom shader program
 
@@ -898,10 +1298,19 @@ static Shader LoadShaderDefault(void);      // Load default shader (just vertex
 static void SetShaderDefaultLocations(Shader *shader); // Bind default shader locations (attributes and uniforms)
 static void UnloadShaderDefault(void);      // Unload default shader
 
-static void LoadBuffersDefault(void);       // Load default internal buffers (lines, triangles, quads)
 static void UpdateBuffersDefault(void);     // Update default internal buffers (VAOs/VBOs) with vertex data
-static void DrawBuffersDefault(void);       // Draw default internal buffers vertex data
-static void UnloadBuffersDefault(void);     // Unload default internal buffers vertex data from CPU and GPU
+static unsigned int LoadBufferSegments(int segmentSize, const void *data, void **mapped);   // Load vertex buffer (ring buffer segments if streaming)
+static void UpdateBufferSegment(unsigned int vboId, int segmentSize, int size, const void *data);  // Update vertex buffer current segment
+static void SetVertexAttribsDefault(unsigned int vboId);   // Set default buffers vertex attributes (interleaved vertex data)
+
+static void SetProgram(unsigned int id);    // Set current shader program (filtered by state cache)
+static void SetVertexArray(unsigned int id);    // Bind VAO (filtered by state cache)
+static void SetBuffer(GLenum target, unsigned int id);  // Bind vertex/index buffer (filtered by state cache)
+static bool CheckUniformCache(int location, const void *value, int size);  // Check and update current program uniform value (true: redundant)
+static void InvalidateUniforms(int location, int count);    // Invalidate current program cached uniform values
+static void SetUniformMatrix(int location, Matrix mat);     // Set current program uniform value: mat4 (filtered by state cache)
+static void SetUniform4f(int location, float x, float y, float z, float w);  // Set current program uniform value: vec4 (filtered by state cache)
+static void SetUniform1i(int location, int value);  // Set current program uniform value: int/sampler (filtered by state cache)
 
 static void GenDrawCube(void);              // Generate and draw cube
 static void GenDrawQuad(void);              // Generate and draw quad
@@ -910,11 +1319,43 @@ static void GenDrawQuad(void);              // Generate and draw quad
 static void SetStereoConfig(VrDeviceInfo info); // Configure stereo rendering (including distortion shader) with HMD device parameters
 static void SetStereoView(int eye, Matrix matProjection, Matrix matModelView); // Set internal projection and modelview matrix depending on eye
 #endif
+#endif  // !defined(GRAPHICS_API_SOFTWARE)
+
+#endif  // defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
 
-#endif  // defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+// Reset OpenGL state cache bindings and capabilities (state changed out of cache)
+static void ResetStateCache(void);
 
+#if !defined(GRAPHICS_API_SOFTWARE)
 // Get OpenGL internal formats and data type from raylib PixelFormat
 static void GetGlFormats(int format, int *glInternalFormat, int *glFormat, int *glType);
+#endif
+
+#if defined(GRAPHICS_API_SOFTWARE)
+static void SwInit(int width, int height);  // Init software rasterizer (framebuffer, tiles and worker threads)
+static void SwClose(void);                  // Close software rasterizer
+static void SwClear(void);                  // Clear framebuffer color and depth (queued triangles discarded)
+static void SwResolve(void);                // Rasterize queued triangles into framebuffer
+static unsigned char *SwReadPixels(int width, int height);  // Read framebuffer pixels (top-down rows)
+static unsigned int SwLoadTexture(const void *data, int width, int height, int format);    // Load texture, returns texture id
+static void SwUpdateTexture(unsigned int id, int width, int height, int format, const void *data);  // Update texture texels
+static void SwUnloadTexture(unsigned int id);   // Unload texture
+static SwTexture *SwGetTexture(unsigned int id);    // Get texture by id (NULL: not loaded)
+static bool SwConvertPixels(const void *data, int count, int format, Color *output);  // Convert pixels data to R8G8B8A8
+static void SwDrawBuffersDefault(Matrix mvp);   // Submit default internal buffers vertex data triangles
+static void SwDrawMesh(Mesh mesh, Material material, Matrix transform);  // Submit mesh triangles
+static bool SwProjectVertex(Matrix mvp, const float *position, const float *texcoord, const float *color, SwVertex *vertex);  // Project vertex to screen (false: behind camera)
+static void SwPushTriangle(const SwVertex *v0, const SwVertex *v1, const SwVertex *v2, unsigned int textureId, bool cull);   // Queue triangle with current pipeline state
+static void SwPushLine(const SwVertex *v0, const SwVertex *v1);    // Queue line as 1 pixel wide quad
+static SwEdge SwSetupEdge(const SwVertex *a, const SwVertex *b);    // Setup edge function (top-left fill rule)
+static void SwRasterizeTiles(int thread);   // Rasterize queued triangles on thread tiles
+static void SwRasterizeTriangle(const SwTriangle *triangle, int minX, int minY, int maxX, int maxY);    // Rasterize triangle inside tile bounds
+static void SwShadePixel(const SwTriangle *triangle, int x, int y, float w1, float w2);   // Shade, test and blend pixel (barycentric weights of vertex 1 and 2)
+static void SwBlendFactor(GLenum factor, const float *src, const float *dst, float *result);  // Get blending factor
+#if (RLGL_SW_THREADS > 1)
+static void *SwWorkerThread(void *arg);     // Software rasterizer worker thread
+#endif
+#endif
 
 #if defined(GRAPHICS_API_OPENGL_11)
 static int GenerateMipmaps(unsigned char *data, int baseWidth, int baseHeight);
@@ -958,57 +1399,105 @@ void rlRotatef(float angleDeg, float x, float y, float z) { glRotatef(angleDeg,
 void rlScalef(float x, float y, float z) { glScalef(x, y, z); }
 void rlMultMatrixf(float *matf) { glMultMatrixf(matf); }
 
-#elif defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#elif defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
 
 // Choose the current matrix to be transformed
+// NOTE: Inside rlPushMatrix()/rlPopMatrix() modelview changes go to vertex transform (CPU)
 void rlMatrixMode(int mode)
 {
+    if (currentCommandBuffer != NULL) return;   // Command buffers only record modelview transforms
+
     if (mode == RL_PROJECTION) currentMatrix = &projection;
-    else if (mode == RL_MODELVIEW) currentMatrix = &modelview;
+    else if (mode == RL_MODELVIEW) currentMatrix = transformRequired? &transformMatrix : &modelview;
     //else if (mode == RL_TEXTURE) // Not supported
 
     currentMatrixMode = mode;
 }
 
 // Push the current matrix to stack
+// NOTE: On modelview mode, pushed transforms are applied to vertex on CPU (rlEnd()), modelview
+// matrix is not modified, so batch can be drawn anywhere (rlglDraw()) keeping stack and transform
 void rlPushMatrix(void)
 {
-    if (stackCounter == MATRIX_STACK_SIZE - 1)
+    if (currentCommandBuffer != NULL)
+    {
+        CommandBuffer *buffer = currentCommandBuffer;
+
+        if (buffer->stackCounter >= MATRIX_STACK_SIZE) TraceLog(LOG_ERROR, "Stack Buffer Overflow (MAX %i Matrix)", MATRIX_STACK_SIZE);
+        else buffer->stack[buffer->stackCounter++] = buffer->transform;
+        return;
+    }
+
+    if (stackCounter >= MATRIX_STACK_SIZE)
     {
         TraceLog(LOG_ERROR, "Stack Buffer Overflow (MAX %i Matrix)", MATRIX_STACK_SIZE);
+        return;
+    }
+
+    if (currentMatrixMode == RL_MODELVIEW)
+    {
+        if (!transformRequired)
+        {
+            transformMatrix = MatrixIdentity();
+            transformRequired = true;
+            currentMatrix = &transformMatrix;
+        }
+
+        modelviewStackCounter++;
     }
 
     stack[stackCounter] = *currentMatrix;
-    rlLoadIdentity();       // TODO: Review matrix stack logic!
     stackCounter++;
-
-    if (currentMatrixMode == RL_MODELVIEW) useTempBuffer = true;
 }
 
 // Pop lattest inserted matrix from stack
 void rlPopMatrix(void)
 {
+    if (currentCommandBuffer != NULL)
+    {
+        if (currentCommandBuffer->stackCounter > 0) currentCommandBuffer->transform = currentCommandBuffer->stack[--currentCommandBuffer->stackCounter];
+        return;
+    }
+
     if (stackCounter > 0)
     {
+        // Vertex pending to be transformed use current transform
+        if (tempBufferCount > 0) TransformTempBuffer();
+
         Matrix mat = stack[stackCounter - 1];
         *currentMatrix = mat;
         stackCounter--;
+
+        // NOTE: Vertex transform ends when all modelview pushes are popped (projection pushes could remain)
+        if ((currentMatrixMode == RL_MODELVIEW) && (modelviewStackCounter > 0))
+        {
+            modelviewStackCounter--;
+
+            if (modelviewStackCounter == 0)
+            {
+                transformRequired = false;
+                currentMatrix = &modelview;
+            }
+        }
     }
 }
 
 // Reset current matrix to identity matrix
 void rlLoadIdentity(void)
 {
-    *currentMatrix = MatrixIdentity();
+    Matrix *matrix = GetCurrentMatrix();
+
+    *matrix = MatrixIdentity();
 }
 
 // Multiply the current matrix by a translation matrix
 void rlTranslatef(float x, float y, float z)
 {
     Matrix matTranslation = MatrixTranslate(x, y, z);
+    Matrix *matrix = GetCurrentMatrix();
 
     // NOTE: We transpose matrix with multiplication order
-    *currentMatrix = MatrixMultiply(matTranslation, *currentMatrix);
+    *matrix = MatrixMultiply(matTranslation, *matrix);
 }
 
 // Multiply the current matrix by a rotation matrix
@@ -1018,18 +1507,20 @@ void rlRotatef(float angleDeg, float x, float y, float z)
 
     Vector3 axis = (Vector3){ x, y, z };
     matRotation = MatrixRotate(Vector3Normalize(axis), angleDeg*DEG2RAD);
+    Matrix *matrix = GetCurrentMatrix();
 
     // NOTE: We transpose matrix with multiplication order
-    *currentMatrix = MatrixMultiply(matRotation, *currentMatrix);
+    *matrix = MatrixMultiply(matRotation, *matrix);
 }
 
 // Multiply the current matrix by a scaling matrix
 void rlScalef(float x, float y, float z)
 {
     Matrix matScale = MatrixScale(x, y, z);
+    Matrix *matrix = GetCurrentMatrix();
 
     // NOTE: We transpose matrix with multiplication order
-    *currentMatrix = MatrixMultiply(matScale, *currentMatrix);
+    *matrix = MatrixMultiply(matScale, *matrix);
 }
 
 // Multiply the current matrix by another matrix
@@ -1040,24 +1531,27 @@ void rlMultMatrixf(float *matf)
                    matf[1], matf[5], matf[9], matf[13],
                    matf[2], matf[6], matf[10], matf[14],
                    matf[3], matf[7], matf[11], matf[15] };
+    Matrix *matrix = GetCurrentMatrix();
 
-    *currentMatrix = MatrixMultiply(*currentMatrix, mat);
+    *matrix = MatrixMultiply(*matrix, mat);
 }
 
 // Multiply the current matrix by a perspective matrix generated by parameters
 void rlFrustum(double left, double right, double bottom, double top, double near, double far)
 {
     Matrix matPerps = MatrixFrustum(left, right, bottom, top, near, far);
+    Matrix *matrix = GetCurrentMatrix();
 
-    *currentMatrix = MatrixMultiply(*currentMatrix, matPerps);
+    *matrix = MatrixMultiply(*matrix, matPerps);
 }
 
 // Multiply the current matrix by an orthographic matrix generated by parameters
 void rlOrtho(double left, double right, double bottom, double top, double near, double far)
 {
     Matrix matOrtho = MatrixOrtho(left, right, bottom, top, near, far);
+    Matrix *matrix = GetCurrentMatrix();
 
-    *currentMatrix = MatrixMultiply(*currentMatrix, matOrtho);
+    *matrix = MatrixMultiply(*matrix, matOrtho);
 }
 
 #endif
@@ -1066,7 +1560,14 @@ void rlOrtho(double left, double right, double bottom, double top, double near,
 // NOTE: Updates global variables: screenWidth, screenHeight
 void rlViewport(int x, int y, int width, int height)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    sw.viewport[0] = x;
+    sw.viewport[1] = y;
+    sw.viewport[2] = width;
+    sw.viewport[3] = height;
+#else
     glViewport(x, y, width, height);
+#endif
 }
 
 //----------------------------------------------------------------------------------
@@ -1097,11 +1598,31 @@ void rlColor4ub(byte r, byte g, byte b, byte a) { glColor4ub(r, g, b, a); }
 void rlColor3f(float x, float y, float z) { glColor3f(x, y, z); }
 void rlColor4f(float x, float y, float z, float w) { glColor4f(x, y, z, w); }
 
-#elif defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+void rlQuad2f(const float *positions, const float *texcoords, Color color)
+{
+    glBegin(GL_QUADS);
+        glColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 0; i < 4; i++)
+        {
+            glTexCoord2f(texcoords[i*2], texcoords[i*2 + 1]);
+            glVertex2f(positions[i*2], positions[i*2 + 1]);
+        }
+    glEnd();
+}
+
+#elif defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
 
 // Initialize drawing mode (how to organize vertex)
 void rlBegin(int mode)
 {
+    if (currentCommandBuffer != NULL)
+    {
+        currentCommandBuffer->mode = mode;
+        currentCommandBuffer->texcoord[0] = 0.0f;    // Same as missing texcoords on default buffers
+        currentCommandBuffer->texcoord[1] = 0.0f;
+        return;
+    }
+
     // Draw mode can only be RL_LINES, RL_TRIANGLES and RL_QUADS
     currentDrawMode = mode;
 }
@@ -1109,25 +1630,15 @@ void rlBegin(int mode)
 // Finish vertex providing
 void rlEnd(void)
 {
-    if (useTempBuffer)
+    if (currentCommandBuffer != NULL)
     {
-        // NOTE: In this case, *currentMatrix is already transposed because transposing has been applied
-        // independently to translation-scale-rotation matrices -> t(M1 x M2) = t(M2) x t(M1)
-        // This way, rlTranslatef(), rlRotatef()... behaviour is the same than OpenGL 1.1
-
-        // Apply transformation matrix to all temp vertices
-        for (int i = 0; i < tempBufferCount; i++) tempBuffer[i] = Vector3Transform(tempBuffer[i], *currentMatrix);
-
-        // Deactivate tempBuffer usage to allow rlVertex3f do its job
-        useTempBuffer = false;
-
-        // Copy all transformed vertices to right VAO
-        for (int i = 0; i < tempBufferCount; i++) rlVertex3f(tempBuffer[i].x, tempBuffer[i].y, tempBuffer[i].z);
-
-        // Reset temp buffer
-        tempBufferCount = 0;
+        currentCommandBuffer->depth += (1.0f/20000.0f);     // Same depth increment than default buffers
+        return;
     }
 
+    // Vertex defined inside rlPushMatrix()/rlPopMatrix() are transformed now
+    if (tempBufferCount > 0) TransformTempBuffer();
+
     // Make sure vertexCount is the same for vertices-texcoords-normals-colors
     // NOTE: In OpenGL 1.1, one glColor call can be made for all the subsequent glVertex calls.
     switch (currentDrawMode)
@@ -1140,10 +1651,10 @@ void rlEnd(void)
 
                 for (int i = 0; i < addColors; i++)
                 {
-                    lines.colors[4*lines.cCounter] = lines.colors[4*lines.cCounter - 4];
-                    lines.colors[4*lines.cCounter + 1] = lines.colors[4*lines.cCounter - 3];
-                    lines.colors[4*lines.cCounter + 2] = lines.colors[4*lines.cCounter - 2];
-                    lines.colors[4*lines.cCounter + 3] = lines.colors[4*lines.cCounter - 1];
+                    lines.vertices[lines.cCounter].color[0] = lines.vertices[lines.cCounter - 1].color[0];
+                    lines.vertices[lines.cCounter].color[1] = lines.vertices[lines.cCounter - 1].color[1];
+                    lines.vertices[lines.cCounter].color[2] = lines.vertices[lines.cCounter - 1].color[2];
+                    lines.vertices[lines.cCounter].color[3] = lines.vertices[lines.cCounter - 1].color[3];
 
                     lines.cCounter++;
                 }
@@ -1157,10 +1668,10 @@ void rlEnd(void)
 
                 for (int i = 0; i < addColors; i++)
                 {
-                    triangles.colors[4*triangles.cCounter] = triangles.colors[4*triangles.cCounter - 4];
-                    triangles.colors[4*triangles.cCounter + 1] = triangles.colors[4*triangles.cCounter - 3];
-                    triangles.colors[4*triangles.cCounter + 2] = triangles.colors[4*triangles.cCounter - 2];
-                    triangles.colors[4*triangles.cCounter + 3] = triangles.colors[4*triangles.cCounter - 1];
+                    triangles.vertices[triangles.cCounter].color[0] = triangles.vertices[triangles.cCounter - 1].color[0];
+                    triangles.vertices[triangles.cCounter].color[1] = triangles.vertices[triangles.cCounter - 1].color[1];
+                    triangles.vertices[triangles.cCounter].color[2] = triangles.vertices[triangles.cCounter - 1].color[2];
+                    triangles.vertices[triangles.cCounter].color[3] = triangles.vertices[triangles.cCounter - 1].color[3];
 
                     triangles.cCounter++;
                 }
@@ -1175,10 +1686,10 @@ void rlEnd(void)
 
                 for (int i = 0; i < addColors; i++)
                 {
-                    quads.colors[4*quads.cCounter] = quads.colors[4*quads.cCounter - 4];
-                    quads.colors[4*quads.cCounter + 1] = quads.colors[4*quads.cCounter - 3];
-                    quads.colors[4*quads.cCounter + 2] = quads.colors[4*quads.cCounter - 2];
-                    quads.colors[4*quads.cCounter + 3] = quads.colors[4*quads.cCounter - 1];
+                    quads.vertices[quads.cCounter].color[0] = quads.vertices[quads.cCounter - 1].color[0];
+                    quads.vertices[quads.cCounter].color[1] = quads.vertices[quads.cCounter - 1].color[1];
+                    quads.vertices[quads.cCounter].color[2] = quads.vertices[quads.cCounter - 1].color[2];
+                    quads.vertices[quads.cCounter].color[3] = quads.vertices[quads.cCounter - 1].color[3];
 
                     quads.cCounter++;
                 }
@@ -1191,8 +1702,8 @@ void rlEnd(void)
 
                 for (int i = 0; i < addTexCoords; i++)
                 {
-                    quads.texcoords[2*quads.tcCounter] = 0.0f;
-                    quads.texcoords[2*quads.tcCounter + 1] = 0.0f;
+                    quads.vertices[quads.tcCounter].texcoord[0] = 0.0f;
+                    quads.vertices[quads.tcCounter].texcoord[1] = 0.0f;
 
                     quads.tcCounter++;
                 }
@@ -1210,29 +1721,30 @@ void rlEnd(void)
     currentDepth += (1.0f/20000.0f);
 
     // Verify internal buffers limits
-    // NOTE: This check is combined with usage of rlCheckBufferLimit()
-    if ((lines.vCounter/2 >= (MAX_LINES_BATCH - 2)) ||
-        (triangles.vCounter/3 >= (MAX_TRIANGLES_BATCH - 3)) ||
-        (quads.vCounter/4 >= (MAX_QUADS_BATCH - 4)))
-    {
-        // WARNING: If we are between rlPushMatrix() and rlPopMatrix() and we need to force a rlglDraw(),
-        // we need to call rlPopMatrix() before to recover *currentMatrix (modelview) for the next forced draw call!
-        // Also noted that if we had multiple matrix pushed, it will require "stackCounter" pops before launching the draw
-        
-        // TODO: Undoubtely, current rlPushMatrix/rlPopMatrix should be redesigned... or removed... it's not working properly
-        
-        rlPopMatrix();
-        rlglDraw();
-    }
+    // NOTE: Buffers grow when required, draw is only forced when close to growth limit,
+    // it's safe inside rlPushMatrix()/rlPopMatrix(), matrix stack does not modify modelview
+    if ((lines.vCounter >= (MAX_BATCH_VERTEX - 2*2)) ||
+        (triangles.vCounter >= (MAX_BATCH_VERTEX - 3*3)) ||
+        (quads.vCounter >= (MAX_BATCH_VERTEX - 4*4))) FlushBuffersDefault(FLUSH_CAPACITY);
 }
 
 // Define one vertex (position)
 void rlVertex3f(float x, float y, float z)
 {
-    // NOTE: Temp buffer is processed and resetted at rlEnd()
-    // Between rlBegin() and rlEnd() can not be more than TEMP_VERTEX_BUFFER_SIZE rlVertex3f() calls
-    if (useTempBuffer && (tempBufferCount < TEMP_VERTEX_BUFFER_SIZE))
+    if (currentCommandBuffer != NULL)
+    {
+        Vector3 position = { x, y, z };
+
+        if (currentCommandBuffer->transformRequired) position = Vector3Transform(position, currentCommandBuffer->transform);
+        RecordVertex(currentCommandBuffer, currentCommandBuffer->mode, position, false);
+        return;
+    }
+
+    // NOTE: Temp buffer is processed and resetted at rlEnd(), if full it's processed before
+    if (transformRequired)
     {
+        if (tempBufferCount >= TEMP_VERTEX_BUFFER_SIZE) TransformTempBuffer();
+
         tempBuffer[tempBufferCount].x = x;
         tempBuffer[tempBufferCount].y = y;
         tempBuffer[tempBufferCount].z = z;
@@ -1244,46 +1756,46 @@ void rlVertex3f(float x, float y, float z)
         {
             case RL_LINES:
             {
-                // Verify that MAX_LINES_BATCH limit not reached
-                if (lines.vCounter/2 < MAX_LINES_BATCH)
+                // Verify buffer capacity, grow it if required
+                if ((lines.vCounter < lines.vCapacity) || GrowBufferDefault(&lines, lines.vCounter + 1))
                 {
-                    lines.vertices[3*lines.vCounter] = x;
-                    lines.vertices[3*lines.vCounter + 1] = y;
-                    lines.vertices[3*lines.vCounter + 2] = z;
+                    lines.vertices[lines.vCounter].position[0] = x;
+                    lines.vertices[lines.vCounter].position[1] = y;
+                    lines.vertices[lines.vCounter].position[2] = z;
 
                     lines.vCounter++;
                 }
-                else TraceLog(LOG_ERROR, "MAX_LINES_BATCH overflow");
+                else TraceLog(LOG_ERROR, "Lines batch overflow (MAX_BATCH_VERTEX reached)");
 
             } break;
             case RL_TRIANGLES:
             {
-                // Verify that MAX_TRIANGLES_BATCH limit not reached
-                if (triangles.vCounter/3 < MAX_TRIANGLES_BATCH)
+                // Verify buffer capacity, grow it if required
+                if ((triangles.vCounter < triangles.vCapacity) || GrowBufferDefault(&triangles, triangles.vCounter + 1))
                 {
-                    triangles.vertices[3*triangles.vCounter] = x;
-                    triangles.vertices[3*triangles.vCounter + 1] = y;
-                    triangles.vertices[3*triangles.vCounter + 2] = z;
+                    triangles.vertices[triangles.vCounter].position[0] = x;
+                    triangles.vertices[triangles.vCounter].position[1] = y;
+                    triangles.vertices[triangles.vCounter].position[2] = z;
 
                     triangles.vCounter++;
                 }
-                else TraceLog(LOG_ERROR, "MAX_TRIANGLES_BATCH overflow");
+                else TraceLog(LOG_ERROR, "Triangles batch overflow (MAX_BATCH_VERTEX reached)");
 
             } break;
             case RL_QUADS:
             {
-                // Verify that MAX_QUADS_BATCH limit not reached
-                if (quads.vCounter/4 < MAX_QUADS_BATCH)
+                // Verify buffer capacity, grow it if required
+                if ((quads.vCounter < quads.vCapacity) || GrowBufferDefault(&quads, quads.vCounter + 1))
                 {
-                    quads.vertices[3*quads.vCounter] = x;
-                    quads.vertices[3*quads.vCounter + 1] = y;
-                    quads.vertices[3*quads.vCounter + 2] = z;
+                    quads.vertices[quads.vCounter].position[0] = x;
+                    quads.vertices[quads.vCounter].position[1] = y;
+                    quads.vertices[quads.vCounter].position[2] = z;
 
                     quads.vCounter++;
 
                     draws[drawsCounter - 1].vertexCount++;
                 }
-                else TraceLog(LOG_ERROR, "MAX_QUADS_BATCH overflow");
+                else TraceLog(LOG_ERROR, "Quads batch overflow (MAX_BATCH_VERTEX reached)");
 
             } break;
             default: break;
@@ -1294,23 +1806,38 @@ void rlVertex3f(float x, float y, float z)
 // Define one vertex (position)
 void rlVertex2f(float x, float y)
 {
-    rlVertex3f(x, y, currentDepth);
+    if (currentCommandBuffer != NULL)
+    {
+        // NOTE: Vertex depth is relative to command buffer depth, it's offset on submission
+        Vector3 position = { x, y, currentCommandBuffer->depth };
+
+        if (currentCommandBuffer->transformRequired) position = Vector3Transform(position, currentCommandBuffer->transform);
+        RecordVertex(currentCommandBuffer, currentCommandBuffer->mode, position, true);
+    }
+    else rlVertex3f(x, y, currentDepth);
 }
 
 // Define one vertex (position)
 void rlVertex2i(int x, int y)
 {
-    rlVertex3f((float)x, (float)y, currentDepth);
+    rlVertex2f((float)x, (float)y);
 }
 
 // Define one vertex (texture coordinate)
 // NOTE: Texture coordinates are limited to QUADS only
 void rlTexCoord2f(float x, float y)
 {
-    if (currentDrawMode == RL_QUADS)
+    if (currentCommandBuffer != NULL)
+    {
+        currentCommandBuffer->texcoord[0] = x;
+        currentCommandBuffer->texcoord[1] = y;
+        return;
+    }
+
+    if ((currentDrawMode == RL_QUADS) && ((quads.tcCounter < quads.vCapacity) || GrowBufferDefault(&quads, quads.tcCounter + 1)))
     {
-        quads.texcoords[2*quads.tcCounter] = x;
-        quads.texcoords[2*quads.tcCounter + 1] = y;
+        quads.vertices[quads.tcCounter].texcoord[0] = x;
+        quads.vertices[quads.tcCounter].texcoord[1] = y;
 
         quads.tcCounter++;
     }
@@ -1324,36 +1851,58 @@ void rlNormal3f(float x, float y, float z)
 }
 
 // Define one vertex (color)
+// NOTE: Color can be defined before vertex, buffer capacity is verified for it
 void rlColor4ub(byte x, byte y, byte z, byte w)
 {
+    if (currentCommandBuffer != NULL)
+    {
+        currentCommandBuffer->color[0] = x;
+        currentCommandBuffer->color[1] = y;
+        currentCommandBuffer->color[2] = z;
+        currentCommandBuffer->color[3] = w;
+        return;
+    }
+
+    DynamicBuffer *buffer = NULL;
+
+    switch (currentDrawMode)
+    {
+        case RL_LINES: buffer = &lines; break;
+        case RL_TRIANGLES: buffer = &triangles; break;
+        case RL_QUADS: buffer = &quads; break;
+        default: break;
+    }
+
+    if ((buffer == NULL) || ((buffer->cCounter >= buffer->vCapacity) && !GrowBufferDefault(buffer, buffer->cCounter + 1))) return;
+
     switch (currentDrawMode)
     {
         case RL_LINES:
         {
-            lines.colors[4*lines.cCounter] = x;
-            lines.colors[4*lines.cCounter + 1] = y;
-            lines.colors[4*lines.cCounter + 2] = z;
-            lines.colors[4*lines.cCounter + 3] = w;
+            lines.vertices[lines.cCounter].color[0] = x;
+            lines.vertices[lines.cCounter].color[1] = y;
+            lines.vertices[lines.cCounter].color[2] = z;
+            lines.vertices[lines.cCounter].color[3] = w;
 
             lines.cCounter++;
 
         } break;
         case RL_TRIANGLES:
         {
-            triangles.colors[4*triangles.cCounter] = x;
-            triangles.colors[4*triangles.cCounter + 1] = y;
-            triangles.colors[4*triangles.cCounter + 2] = z;
-            triangles.colors[4*triangles.cCounter + 3] = w;
+            triangles.vertices[triangles.cCounter].color[0] = x;
+            triangles.vertices[triangles.cCounter].color[1] = y;
+            triangles.vertices[triangles.cCounter].color[2] = z;
+            triangles.vertices[triangles.cCounter].color[3] = w;
 
             triangles.cCounter++;
 
         } break;
         case RL_QUADS:
         {
-            quads.colors[4*quads.cCounter] = x;
-            quads.colors[4*quads.cCounter + 1] = y;
-            quads.colors[4*quads.cCounter + 2] = z;
-            quads.colors[4*quads.cCounter + 3] = w;
+            quads.vertices[quads.cCounter].color[0] = x;
+            quads.vertices[quads.cCounter].color[1] = y;
+            quads.vertices[quads.cCounter].color[2] = z;
+            quads.vertices[quads.cCounter].color[3] = w;
 
             quads.cCounter++;
 
@@ -1374,6 +1923,68 @@ void rlColor3f(float x, float y, float z)
     rlColor4ub((byte)(x*255), (byte)(y*255), (byte)(z*255), 255);
 }
 
+// Define one quad: 4 vertex positions (xy) and texture coordinates, same color
+// NOTE: Vertex data is written directly into quads buffer (no rlBegin()/rlEnd() required),
+// quad texture must be enabled before with rlEnableTexture(). Inside rlPushMatrix()/rlPopMatrix()
+// vertex are transformed by current transform (same as rlVertex2f()), if not, no transform cost
+void rlQuad2f(const float *positions, const float *texcoords, Color color)
+{
+    if (currentCommandBuffer != NULL)
+    {
+        CommandBuffer *buffer = currentCommandBuffer;
+
+        buffer->color[0] = color.r;
+        buffer->color[1] = color.g;
+        buffer->color[2] = color.b;
+        buffer->color[3] = color.a;
+
+        for (int i = 0; i < 4; i++)
+        {
+            Vector3 position = { positions[i*2], positions[i*2 + 1], buffer->depth };
+
+            if (buffer->transformRequired) position = Vector3Transform(position, buffer->transform);
+
+            buffer->texcoord[0] = texcoords[i*2];
+            buffer->texcoord[1] = texcoords[i*2 + 1];
+
+            RecordVertex(buffer, RL_QUADS, position, true);
+        }
+
+        buffer->depth += (1.0f/20000.0f);
+        return;
+    }
+
+    // If quads buffer can not grow, draw it (current texture is kept for next batch)
+    if (!GrowBufferDefault(&quads, quads.vCounter + 4)) FlushBuffersDefault(FLUSH_CAPACITY);
+
+    for (int i = 0; i < 4; i++)
+    {
+        Vector3 position = { positions[i*2], positions[i*2 + 1], currentDepth };
+
+        if (transformRequired) position = Vector3Transform(position, transformMatrix);
+
+        quads.vertices[quads.vCounter].position[0] = position.x;
+        quads.vertices[quads.vCounter].position[1] = position.y;
+        quads.vertices[quads.vCounter].position[2] = position.z;
+
+        quads.vertices[quads.tcCounter].texcoord[0] = texcoords[i*2];
+        quads.vertices[quads.tcCounter].texcoord[1] = texcoords[i*2 + 1];
+
+        quads.vertices[quads.cCounter].color[0] = color.r;
+        quads.vertices[quads.cCounter].color[1] = color.g;
+        quads.vertices[quads.cCounter].color[2] = color.b;
+        quads.vertices[quads.cCounter].color[3] = color.a;
+
+        quads.vCounter++;
+        quads.tcCounter++;
+        quads.cCounter++;
+    }
+
+    draws[drawsCounter - 1].vertexCount += 4;
+
+    currentDepth += (1.0f/20000.0f);    // Same depth increment than rlEnd()
+}
+
 #endif
 
 //----------------------------------------------------------------------------------
@@ -1388,16 +1999,9 @@ void rlEnableTexture(unsigned int id)
     glBindTexture(GL_TEXTURE_2D, id);
 #endif
 
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    if (draws[drawsCounter - 1].textureId != id)
-    {
-        if (draws[drawsCounter - 1].vertexCount > 0) drawsCounter++;
-
-        if (drawsCounter >= MAX_DRAWS_BY_TEXTURE) rlglDraw();
-
-        draws[drawsCounter - 1].textureId = id;
-        draws[drawsCounter - 1].vertexCount = 0;
-    }
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    if (currentCommandBuffer != NULL) currentCommandBuffer->textureId = id;
+    else if (draws[drawsCounter - 1].textureId != id) PushDrawCall(id);
 #endif
 }
 
@@ -1408,15 +2012,27 @@ void rlDisableTexture(void)
     glDisable(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, 0);
 #else
-    // NOTE: If quads batch limit is reached,
+    // NOTE: If quads batch growth limit is reached,
     // we force a draw call and next batch starts
-    if (quads.vCounter/4 >= MAX_QUADS_BATCH) rlglDraw();
+    if ((currentCommandBuffer == NULL) && (quads.vCounter >= (MAX_BATCH_VERTEX - 4))) FlushBuffersDefault(FLUSH_CAPACITY);
 #endif
 }
 
 // Set texture parameters (wrap mode/filter mode)
 void rlTextureParameters(unsigned int id, int param, int value)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    // NOTE: Software rasterizer samples textures with nearest filter, only wrap mode can be set
+    SwTexture *texture = SwGetTexture(id);
+
+    if ((texture != NULL) && ((param == RL_TEXTURE_WRAP_S) || (param == RL_TEXTURE_WRAP_T)))
+    {
+        SwResolve();        // Pending triangles are rasterized with previous wrap mode
+
+        if (param == RL_TEXTURE_WRAP_S) texture->clampU = (value != RL_WRAP_REPEAT);
+        else texture->clampV = (value != RL_WRAP_REPEAT);
+    }
+#else
     glBindTexture(GL_TEXTURE_2D, id);
 
     switch (param)
@@ -1443,6 +2059,8 @@ void rlTextureParameters(unsigned int id, int param, int value)
     }
 
     glBindTexture(GL_TEXTURE_2D, 0);
+    ResetStateCache();          // Bindings changed out of state cache
+#endif
 }
 
 // Enable rendering to texture (fbo)
@@ -1470,13 +2088,44 @@ void rlDisableRenderTexture(void)
 // Enable depth test
 void rlEnableDepthTest(void)
 {
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    SetCapability(GL_DEPTH_TEST, true);
+#else
     glEnable(GL_DEPTH_TEST);
+#endif
 }
 
 // Disable depth test
 void rlDisableDepthTest(void)
 {
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    SetCapability(GL_DEPTH_TEST, false);
+#else
     glDisable(GL_DEPTH_TEST);
+#endif
+}
+
+// Enable alpha test
+// NOTE: Fully transparent fragments are discarded, they do not write depth,
+// only default shader is affected (custom shaders should discard by themselves)
+void rlEnableAlphaTest(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    alphaTest = true;
+#else
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GREATER, 0.0f);
+#endif
+}
+
+// Disable alpha test
+void rlDisableAlphaTest(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    alphaTest = false;
+#else
+    glDisable(GL_ALPHA_TEST);
+#endif
 }
 
 // Enable wire mode
@@ -1500,7 +2149,12 @@ void rlDisableWireMode(void)
 // Unload texture from GPU memory
 void rlDeleteTextures(unsigned int id)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    SwUnloadTexture(id);
+#else
     if (id > 0) glDeleteTextures(1, &id);
+    ResetStateCache();          // Deleted texture could be bound (binding reverts to 0)
+#endif
 }
 
 // Unload render texture from GPU memory
@@ -1510,6 +2164,7 @@ void rlDeleteRenderTextures(RenderTexture2D target)
     if (target.id > 0) glDeleteFramebuffers(1, &target.id);
     if (target.texture.id > 0) glDeleteTextures(1, &target.texture.id);
     if (target.depth.id > 0) glDeleteTextures(1, &target.depth.id);
+    ResetStateCache();          // Deleted textures could be bound (binding reverts to 0)
 
     TraceLog(LOG_INFO, "[FBO ID %i] Unloaded render texture data from VRAM (GPU)", target.id);
 #endif
@@ -1520,6 +2175,14 @@ void rlDeleteShader(unsigned int id)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     if (id != 0) glDeleteProgram(id);
+
+    // Program id could be reused, cached uniform values are discarded
+    for (int i = 0; i < STATE_UNIFORM_PROGRAMS; i++)
+    {
+        if (state.uniforms[i].programId == id) state.uniforms[i].programId = 0;
+    }
+
+    if (state.program == id) ResetStateCache();
 #endif
 }
 
@@ -1530,6 +2193,7 @@ void rlDeleteVertexArrays(unsigned int id)
     if (vaoSupported)
     {
         if (id != 0) glDeleteVertexArrays(1, &id);
+        ResetStateCache();      // Deleted VAO could be bound (binding reverts to 0)
         TraceLog(LOG_INFO, "[VAO ID %i] Unloaded model data from VRAM (GPU)", id);
     }
 #endif
@@ -1542,6 +2206,7 @@ void rlDeleteBuffers(unsigned int id)
     if (id != 0)
     {
         glDeleteBuffers(1, &id);
+        ResetStateCache();      // Deleted buffer could be bound (binding reverts to 0)
         if (!vaoSupported) TraceLog(LOG_INFO, "[VBO ID %i] Unloaded model vertex data from VRAM (GPU)", id);
     }
 #endif
@@ -1550,6 +2215,9 @@ void rlDeleteBuffers(unsigned int id)
 // Clear color buffer with color
 void rlClearColor(byte r, byte g, byte b, byte a)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    sw.clearColor = (Color){ r, g, b, a };
+#else
     // Color values clamp to 0.0f(0) and 1.0f(255)
     float cr = (float)r/255;
     float cg = (float)g/255;
@@ -1557,13 +2225,18 @@ void rlClearColor(byte r, byte g, byte b, byte a)
     float ca = (float)a/255;
 
     glClearColor(cr, cg, cb, ca);
+#endif
 }
 
 // Clear used screen buffers (color and depth)
 void rlClearScreenBuffers(void)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    SwClear();                                              // Clear software framebuffer: Color and Depth
+#else
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);     // Clear used buffers: Color and Depth (Depth is used for 3D)
     //glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);     // Stencil buffer not used...
+#endif
 }
 
 //----------------------------------------------------------------------------------
@@ -1572,15 +2245,26 @@ void rlClearScreenBuffers(void)
 
 // Initialize rlgl: OpenGL extensions, default buffers/shaders/textures, OpenGL states
 void rlglInit(int width, int height)
+{
+    rlglInitEx(width, height, MAX_LINES_BATCH, MAX_TRIANGLES_BATCH, MAX_QUADS_BATCH);
+}
+
+// Initialize rlgl with default buffers initial capacity (lines, triangles and quads count)
+// NOTE: Buffers grow when required, initial capacity avoids growth on scenes with known size
+void rlglInitEx(int width, int height, int linesCount, int trianglesCount, int quadsCount)
 {
     // Check OpenGL information and capabilities
     //------------------------------------------------------------------------------
 
+#if defined(GRAPHICS_API_SOFTWARE)
+    TraceLog(LOG_INFO, "GPU: Renderer: rlgl software rasterizer (%i threads, %ix%i tiles)", RLGL_SW_THREADS, SW_TILE_SIZE, SW_TILE_SIZE);
+#else
     // Print current OpenGL and GLSL version
     TraceLog(LOG_INFO, "GPU: Vendor:   %s", glGetString(GL_VENDOR));
     TraceLog(LOG_INFO, "GPU: Renderer: %s", glGetString(GL_RENDERER));
     TraceLog(LOG_INFO, "GPU: Version:  %s", glGetString(GL_VERSION));
     TraceLog(LOG_INFO, "GPU: GLSL:     %s", glGetString(GL_SHADING_LANGUAGE_VERSION));
+#endif
 
     // NOTE: We can get a bunch of extra information about GPU capabilities (glGet*)
     //int maxTexSize;
@@ -1617,6 +2301,13 @@ void rlglInit(int width, int height)
     texNPOTSupported = true;
     texFloatSupported = true;
 
+    // NOTE: Asynchronous readback requires fences (OpenGL 3.2), not available on OpenGL 2.1
+    #if defined(__APPLE__)
+    readbackAsyncSupported = true;
+    #else
+    readbackAsyncSupported = GLAD_GL_VERSION_3_2;
+    #endif
+
     // We get a list of available extensions and we check for some of them (compressed textures)
     // NOTE: We don't need to check again supported extensions but we do (GLAD already dealt with that)
     glGetIntegerv(GL_NUM_EXTENSIONS, &numExt);
@@ -1745,6 +2436,14 @@ void rlglInit(int width, int height)
 
     if (debugMarkerSupported) TraceLog(LOG_INFO, "[EXTENSION] Debug Marker supported");
 
+#endif      // defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+
+#if defined(GRAPHICS_API_SOFTWARE)
+    // Initialize software rasterizer framebuffer, tiles and worker threads
+    SwInit(width, height);
+#endif
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
     // Initialize buffers, default shaders and default textures
     //----------------------------------------------------------
 
@@ -1756,12 +2455,27 @@ void rlglInit(int width, int height)
     if (whiteTexture != 0) TraceLog(LOG_INFO, "[TEX ID %i] Base white texture loaded successfully", whiteTexture);
     else TraceLog(LOG_WARNING, "Base white texture could not be loaded");
 
+#if defined(GRAPHICS_API_SOFTWARE)
+    // NOTE: Software rasterizer has a fixed pipeline (texture and color), default shader has no program
+    for (int i = 0; i < MAX_SHADER_LOCATIONS; i++) defaultShader.locs[i] = -1;
+#else
     // Init default Shader (customized for GL 3.3 and ES2)
     defaultShader = LoadShaderDefault();
+#endif
     currentShader = defaultShader;
 
     // Init default vertex arrays buffers (lines, triangles, quads)
-    LoadBuffersDefault();
+    if (linesCount <= 0) linesCount = MAX_LINES_BATCH;
+    if (trianglesCount <= 0) trianglesCount = MAX_TRIANGLES_BATCH;
+    if (quadsCount <= 0) quadsCount = MAX_QUADS_BATCH;
+
+    // Initial capacity is limited the same way buffers growth is (MAX_BATCH_VERTEX),
+    // on OpenGL ES 2.0 quads indices are unsigned short: up to 16384 quads
+    if (linesCount > MAX_BATCH_VERTEX/2) linesCount = MAX_BATCH_VERTEX/2;
+    if (trianglesCount > MAX_BATCH_VERTEX/3) trianglesCount = MAX_BATCH_VERTEX/3;
+    if (quadsCount > MAX_BATCH_VERTEX/4) quadsCount = MAX_BATCH_VERTEX/4;
+
+    LoadBuffersDefault(linesCount, trianglesCount, quadsCount);
 
     // Init temp vertex buffer, used when transformation required (translate, rotate, scale)
     tempBuffer = (Vector3 *)malloc(sizeof(Vector3)*TEMP_VERTEX_BUFFER_SIZE);
@@ -1770,6 +2484,7 @@ void rlglInit(int width, int height)
 
     // Init draw calls tracking system
     draws = (DrawCall *)malloc(sizeof(DrawCall)*MAX_DRAWS_BY_TEXTURE);
+    drawsCapacity = MAX_DRAWS_BY_TEXTURE;
 
     for (int i = 0; i < MAX_DRAWS_BY_TEXTURE; i++)
     {
@@ -1777,6 +2492,8 @@ void rlglInit(int width, int height)
         draws[i].vaoId = 0;
         draws[i].shaderId = 0;
         draws[i].textureId = 0;
+        draws[i].layer = 0;
+        draws[i].vertexOffset = 0;
 
         draws[i].projection = MatrixIdentity();
         draws[i].modelview = MatrixIdentity();
@@ -1784,6 +2501,7 @@ void rlglInit(int width, int height)
 
     drawsCounter = 1;
     draws[0].textureId = whiteTexture;      // Set default draw texture id
+    draws[0].shaderId = currentShader.id;   // Set default draw shader id
     currentDrawMode = RL_TRIANGLES;         // Set default draw mode
 
     // Init internal matrix stack (emulating OpenGL 1.1)
@@ -1792,12 +2510,22 @@ void rlglInit(int width, int height)
     // Init internal projection and modelview matrices
     projection = MatrixIdentity();
     modelview = MatrixIdentity();
+    transformMatrix = MatrixIdentity();
     currentMatrix = &modelview;
-#endif      // defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#endif      // defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
 
     // Initialize OpenGL default states
     //----------------------------------------------------------
-
+#if defined(GRAPHICS_API_SOFTWARE)
+    // NOTE: Software pipeline state is the state cache itself, defaults match OpenGL backends
+    state.depthTest = 0;                                    // Depth testing disabled for 2D (GL_LEQUAL if enabled)
+    state.blend = 1;                                        // Color blending enabled
+    state.blendSrc = GL_SRC_ALPHA;                          // Color blending function: alpha
+    state.blendDst = GL_ONE_MINUS_SRC_ALPHA;
+    state.cullFace = 1;                                     // Backface culling enabled (front faces are CCW)
+
+    SwClear();                                              // Clear color and depth buffers
+#else
     // Init state: Depth test
     glDepthFunc(GL_LEQUAL);                                 // Type of depth testing to apply
     glDisable(GL_DEPTH_TEST);                               // Disable depth testing for 2D (only used for 3D)
@@ -1822,6 +2550,10 @@ void rlglInit(int width, int height)
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);                   // Set clear color (black)
     glClearDepth(1.0f);                                     // Set clear depth value (default)
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);     // Clear color and depth buffers (depth buffer required for 3D)
+#endif
+
+    // Init state cache: current state unknown, no uniform values cached
+    rlResetStateCache();
 
     // Store screen size into global variables
     screenWidth = width;
@@ -1833,28 +2565,50 @@ void rlglInit(int width, int height)
 // Vertex Buffer Object deinitialization (memory free)
 void rlglClose(void)
 {
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+#if !defined(GRAPHICS_API_SOFTWARE)
     UnloadShaderDefault();              // Unload default shader
+#endif
     UnloadBuffersDefault();             // Unload default buffers (lines, triangles, quads)
-    glDeleteTextures(1, &whiteTexture); // Unload default texture
+    rlUnloadTexture(whiteTexture);      // Unload default texture
 
     TraceLog(LOG_INFO, "[TEX ID %i] Unloaded texture data (base white texture) from VRAM", whiteTexture);
 
     free(draws);
+    free(sortVertices);
     free(tempBuffer);
 #endif
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    rlFlushReadbacks();                 // Complete pending readbacks (callbacks are called)
+
+    for (int i = 0; i < READBACK_BUFFERS; i++) if (readbacks[i].pboId != 0) glDeleteBuffers(1, &readbacks[i].pboId);
+    memset(readbacks, 0, sizeof(readbacks));
+#endif
+
+#if defined(GRAPHICS_API_SOFTWARE)
+    SwClose();                          // Unload software framebuffer, textures and worker threads
+#endif
+
+#if defined(RLGL_CAPTURE) && defined(GRAPHICS_API_OPENGL_33) && !defined(__APPLE__)
+    CloseGlCapture();                   // Complete trace file (if closed before all frames captured)
+#endif
 }
 
 // Drawing batches: triangles, quads, lines
 void rlglDraw(void)
 {
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
     // NOTE: In a future version, models could be stored in a stack...
     //for (int i = 0; i < modelsCount; i++) rlDrawMesh(models[i]->mesh, models[i]->material, models[i]->transform);
 
     // NOTE: Default buffers upload and draw
-    UpdateBuffersDefault();
-    DrawBuffersDefault();       // NOTE: Stereo rendering is checked inside
+    FlushBuffersDefault(FLUSH_EXPLICIT);
+
+    // Reset depth and texture for next draw
+    // NOTE: Forced flushes keep current texture, explicit draws start next batch on default texture
+    currentDepth = -1.0f;
+    draws[0].textureId = whiteTexture;
 #endif
 }
 
@@ -1873,46 +2627,307 @@ int rlGetVersion(void)
     return OPENGL_33;
 #elif defined(GRAPHICS_API_OPENGL_ES2)
     return OPENGL_ES_20;
+#elif defined(GRAPHICS_API_SOFTWARE)
+    return SOFTWARE_RENDERER;
 #endif
 }
 
 // Check internal buffer overflow for a given number of vertex
+// NOTE: Buffer grows to fit vertex count, overflow only happens on growth limit (MAX_BATCH_VERTEX)
 bool rlCheckBufferLimit(int type, int vCount)
 {
     bool overflow = false;
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    if (currentCommandBuffer != NULL) return !GrowCommandBuffer(currentCommandBuffer, currentCommandBuffer->vertexCount + vCount);
+
     switch (type)
     {
-        case RL_LINES: overflow = ((lines.vCounter + vCount)/2 >= MAX_LINES_BATCH); break;
-        case RL_TRIANGLES: overflow = ((triangles.vCounter + vCount)/3 >= MAX_TRIANGLES_BATCH); break;
-        case RL_QUADS: overflow = ((quads.vCounter + vCount)/4 >= MAX_QUADS_BATCH); break;
+        case RL_LINES: overflow = !GrowBufferDefault(&lines, lines.vCounter + vCount); break;
+        case RL_TRIANGLES: overflow = !GrowBufferDefault(&triangles, triangles.vCounter + vCount); break;
+        case RL_QUADS: overflow = !GrowBufferDefault(&quads, quads.vCounter + vCount); break;
         default: break;
     }
 #endif
     return overflow;
 }
 
-// Set debug marker
-void rlSetDebugMarker(const char *text)
+// Get internal buffer current capacity (vertex count)
+int rlGetBufferCapacity(int type)
 {
-#if defined(GRAPHICS_API_OPENGL_33)
-    if (debugMarkerSupported) glInsertEventMarkerEXT(0, text);
+    int capacity = 0;
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    switch (type)
+    {
+        case RL_LINES: capacity = lines.vCapacity; break;
+        case RL_TRIANGLES: capacity = triangles.vCapacity; break;
+        case RL_QUADS: capacity = quads.vCapacity; break;
+        default: break;
+    }
 #endif
+    return capacity;
 }
 
-// Load OpenGL extensions
-// NOTE: External loader function could be passed as a pointer
-void rlLoadExtensions(void *loader)
+// Get internal buffer high-water mark: max vertex count drawn in a batch since initialization
+// NOTE: Useful to set initial buffers capacity for a scene with rlglInitEx()
+int rlGetBufferHighWater(int type)
 {
-#if defined(GRAPHICS_API_OPENGL_33)
-    // NOTE: glad is generated and contains only required OpenGL 3.3 Core extensions (and lower versions)
-    #if !defined(__APPLE__)
-        if (!gladLoadGLLoader((GLADloadproc)loader)) TraceLog(LOG_WARNING, "GLAD: Cannot load OpenGL extensions");
-        else TraceLog(LOG_INFO, "GLAD: OpenGL extensions loaded successfully");
+    int highWater = 0;
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    switch (type)
+    {
+        case RL_LINES: highWater = lines.vCounterMax; break;
+        case RL_TRIANGLES: highWater = triangles.vCounterMax; break;
+        case RL_QUADS: highWater = quads.vCounterMax; break;
+        default: break;
+    }
+#endif
+    return highWater;
+}
 
-        #if defined(GRAPHICS_API_OPENGL_21)
-        if (GLAD_GL_VERSION_2_1) TraceLog(LOG_INFO, "OpenGL 2.1 profile supported");
-        #elif defined(GRAPHICS_API_OPENGL_33)
+// Get rendering statistics, accumulated since last rlResetRenderStats()
+RenderStats rlGetRenderStats(void)
+{
+    RenderStats result = { 0 };
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    result = stats;
+#endif
+    return result;
+}
+
+// Reset rendering statistics
+// NOTE: Call it once per frame (i.e. before BeginDrawing()) to get per-frame statistics
+void rlResetRenderStats(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    memset(&stats, 0, sizeof(RenderStats));
+#endif
+}
+
+// Log rendering statistics, fixed format lines to be easily parsed (i.e. batching regressions check)
+void rlTraceRenderStats(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    TraceLog(LOG_INFO, "[STATS] Flushes: %i (explicit: %i, capacity: %i, draws limit: %i, state: %i)",
+             stats.flushes, stats.flushesExplicit, stats.flushesCapacity, stats.flushesDrawsLimit, stats.flushesState);
+    TraceLog(LOG_INFO, "[STATS] Draw calls: %i, texture binds: %i, shader switches: %i, state calls filtered: %i",
+             stats.drawCalls, stats.textureBinds, stats.shaderSwitches, stats.stateFiltered);
+    TraceLog(LOG_INFO, "[STATS] Vertex: %i lines, %i triangles, %i quads, %i bytes uploaded",
+             stats.linesVertex, stats.trianglesVertex, stats.quadsVertex, stats.bytesUploaded);
+#endif
+}
+
+// Reset OpenGL state cache, next state changes are not filtered
+// NOTE: Required after OpenGL calls done out of rlgl (state cache would be out of sync)
+void rlResetStateCache(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    ResetStateCache();
+
+    // Uniform values could also be set by external code
+    for (int i = 0; i < STATE_UNIFORM_PROGRAMS; i++) state.uniforms[i].programId = 0;
+    state.currentUniforms = NULL;
+#endif
+}
+
+// Load command buffer to record vertex data (rlBegin(), rlVertex*(), rlEnd()...) on any thread
+CommandBuffer *rlLoadCommandBuffer(void)
+{
+    CommandBuffer *buffer = NULL;
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    buffer = (CommandBuffer *)calloc(1, sizeof(CommandBuffer));
+
+    if (buffer != NULL)
+    {
+        buffer->vertices = (DynamicVertex *)malloc(sizeof(DynamicVertex)*COMMAND_BUFFER_VERTEX);
+        buffer->commands = (RecordCommand *)malloc(sizeof(RecordCommand)*COMMAND_BUFFER_COMMANDS);
+
+        if ((buffer->vertices == NULL) || (buffer->commands == NULL))
+        {
+            rlUnloadCommandBuffer(buffer);
+            buffer = NULL;
+        }
+        else
+        {
+            buffer->vertexCapacity = COMMAND_BUFFER_VERTEX;
+            buffer->commandsCapacity = COMMAND_BUFFER_COMMANDS;
+        }
+    }
+
+    if (buffer == NULL) TraceLog(LOG_WARNING, "Command buffer could not be loaded");
+#else
+    TraceLog(LOG_WARNING, "Command buffers not supported on OpenGL 1.1");
+#endif
+    return buffer;
+}
+
+// Unload command buffer
+void rlUnloadCommandBuffer(CommandBuffer *buffer)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    if (buffer != NULL)
+    {
+        free(buffer->vertices);
+        free(buffer->commands);
+        free(buffer);
+    }
+#endif
+}
+
+// Begin recording into command buffer, previous recorded data is discarded
+// NOTE: Calling thread rlgl vertex and modelview matrix functions are recorded into command buffer,
+// default buffers and GL state are not accessed, so several threads can record at the same time
+// (one command buffer by thread), any other rlgl function must be called on GL thread
+void rlBeginCommandBuffer(CommandBuffer *buffer)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    if (buffer == NULL) return;
+
+    buffer->vertexCount = 0;
+    buffer->commandsCount = 0;
+
+    buffer->mode = RL_QUADS;
+    buffer->textureId = 0;
+    buffer->depth = 0.0f;
+    buffer->texcoord[0] = 0.0f;
+    buffer->texcoord[1] = 0.0f;
+    buffer->color[0] = 255;
+    buffer->color[1] = 255;
+    buffer->color[2] = 255;
+    buffer->color[3] = 255;
+    buffer->transform = MatrixIdentity();
+    buffer->transformRequired = false;
+    buffer->stackCounter = 0;
+
+    currentCommandBuffer = buffer;
+#endif
+}
+
+// End recording into command buffer, calling thread records into default buffers again
+void rlEndCommandBuffer(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    currentCommandBuffer = NULL;
+#endif
+}
+
+// Merge command buffer vertex data into default buffers, in recording order
+// NOTE: Must be called on GL thread once recording is finished (i.e. worker thread joined),
+// submission order is drawing order, so several command buffers are merged deterministically.
+// Recorded data is kept, a command buffer can be submitted again (static geometry)
+void rlSubmitCommandBuffer(CommandBuffer *buffer)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    if ((buffer == NULL) || (currentCommandBuffer != NULL)) return;     // GL thread can not be recording
+
+    float depthBase = currentDepth;
+
+    for (int i = 0; i < buffer->commandsCount; i++)
+    {
+        RecordCommand *command = &buffer->commands[i];
+        DynamicBuffer *target = NULL;
+        int primitiveSize = 0;
+
+        switch (command->mode)
+        {
+            case RL_LINES: target = &lines; primitiveSize = 2; break;
+            case RL_TRIANGLES: target = &triangles; primitiveSize = 3; break;
+            case RL_QUADS: target = &quads; primitiveSize = 4; break;
+            default: break;
+        }
+
+        if (target == NULL) continue;
+
+        if ((command->mode == RL_QUADS) && (command->textureId != 0)) rlEnableTexture(command->textureId);
+
+        int offset = 0;
+
+        while (offset < command->vertexCount)
+        {
+            int count = command->vertexCount - offset;
+
+            // Buffer grows to fit vertex data, on growth limit vertex data is split (primitives kept)
+            if (!GrowBufferDefault(target, target->vCounter + count))
+            {
+                GrowBufferDefault(target, MAX_BATCH_VERTEX);
+                count = (target->vCapacity - target->vCounter)/primitiveSize*primitiveSize;
+            }
+
+            if (count <= 0)
+            {
+                FlushBuffersDefault(FLUSH_CAPACITY);
+                continue;
+            }
+
+            DynamicVertex *vertices = target->vertices + target->vCounter;
+            memcpy(vertices, buffer->vertices + command->vertexOffset + offset, sizeof(DynamicVertex)*count);
+
+            if (command->relativeDepth)
+            {
+                for (int v = 0; v < count; v++) vertices[v].position[2] += depthBase;
+            }
+
+            target->vCounter += count;
+            target->cCounter = target->vCounter;
+            if (command->mode == RL_QUADS)
+            {
+                target->tcCounter = target->vCounter;
+                draws[drawsCounter - 1].vertexCount += count;
+            }
+
+            offset += count;
+        }
+    }
+
+    currentDepth += buffer->depth;
+#endif
+}
+
+// Set quads draw calls sorting mode: RL_SORT_NONE, RL_SORT_DEPTH, RL_SORT_STATE
+// NOTE: Draw calls are sorted and merged on rlglDraw(), RL_SORT_STATE reorders overlapping
+// quads inside a layer, use it when drawing order is not required (opaque or depth tested quads)
+// NOTE: On persistent mapped streaming vertex data is not reordered, sorted draw calls keep
+// texture changes low but only draws with contiguous vertex data are merged
+void rlSetDrawSortMode(int mode)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    drawSortMode = mode;
+#endif
+}
+
+// Set quads draw layer, lower layers are drawn first on draw calls sorting
+void rlSetDrawLayer(int layer)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    if (layer != currentLayer)
+    {
+        currentLayer = layer;
+
+        if (draws[drawsCounter - 1].layer != layer) PushDrawCall(draws[drawsCounter - 1].textureId);
+    }
+#endif
+}
+
+// Set debug marker
+void rlSetDebugMarker(const char *text)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (debugMarkerSupported) glInsertEventMarkerEXT(0, text);
+#endif
+}
+
+// Load OpenGL extensions
+// NOTE: External loader function could be passed as a pointer
+void rlLoadExtensions(void *loader)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    // NOTE: glad is generated and contains only required OpenGL 3.3 Core extensions (and lower versions)
+    #if !defined(__APPLE__)
+        if (!gladLoadGLLoader((GLADloadproc)loader)) TraceLog(LOG_WARNING, "GLAD: Cannot load OpenGL extensions");
+        else TraceLog(LOG_INFO, "GLAD: OpenGL extensions loaded successfully");
+
+        #if defined(GRAPHICS_API_OPENGL_21)
+        if (GLAD_GL_VERSION_2_1) TraceLog(LOG_INFO, "OpenGL 2.1 profile supported");
+        #elif defined(GRAPHICS_API_OPENGL_33)
         if(GLAD_GL_VERSION_3_3) TraceLog(LOG_INFO, "OpenGL 3.3 Core profile supported");
         else TraceLog(LOG_ERROR, "OpenGL 3.3 Core profile not supported");
         #endif
@@ -1923,6 +2938,27 @@ void rlLoadExtensions(void *loader)
 #endif
 }
 
+// Begin OpenGL calls capture into binary trace file (replayed with glreplay tool)
+// NOTE: Capture must start before rlglInit(), all OpenGL resources creation is required on replay
+bool rlBeginCapture(const char *fileName, int framesCount)
+{
+#if defined(RLGL_CAPTURE) && defined(GRAPHICS_API_OPENGL_33) && !defined(__APPLE__)
+    return InitGlCapture(fileName, framesCount);
+#else
+    TraceLog(LOG_WARNING, "OpenGL calls capture not supported (requires RLGL_CAPTURE and OpenGL 3.3)");
+    return false;
+#endif
+}
+
+// Mark captured frame end (call before swapping buffers)
+// NOTE: Capture is closed automatically once all requested frames are captured
+void rlCaptureFrame(void)
+{
+#if defined(RLGL_CAPTURE) && defined(GRAPHICS_API_OPENGL_33) && !defined(__APPLE__)
+    UpdateGlCapture();
+#endif
+}
+
 // Get world coordinates from screen coordinates
 Vector3 rlUnproject(Vector3 source, Matrix proj, Matrix view)
 {
@@ -1949,7 +2985,12 @@ Vector3 rlUnproject(Vector3 source, Matrix proj, Matrix view)
 // Convert image data to OpenGL texture (returns OpenGL valid Id)
 unsigned int rlLoadTexture(void *data, int width, int height, int format, int mipmapCount)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    // NOTE: Only first mipmap level is loaded, converted to R8G8B8A8 (nearest filter, repeat wrap mode)
+    return SwLoadTexture(data, width, height, format);
+#else
     glBindTexture(GL_TEXTURE_2D, 0);    // Free any old binding
+    ResetStateCache();          // Bindings changed out of state cache
 
     GLuint id = 0;
 
@@ -2098,12 +3139,17 @@ unsigned int rlLoadTexture(void *data, int width, int height, int format, int mi
     else TraceLog(LOG_WARNING, "Texture could not be created");
 
     return id;
+#endif
 }
 
 // Update already loaded texture in GPU with new data
 void rlUpdateTexture(unsigned int id, int width, int height, int format, const void *data)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    SwUpdateTexture(id, width, height, format, data);
+#else
     glBindTexture(GL_TEXTURE_2D, id);
+    ResetStateCache();          // Bindings changed out of state cache
 
     int glInternalFormat, glFormat, glType;
     GetGlFormats(format, &glInternalFormat, &glFormat, &glType);
@@ -2113,12 +3159,18 @@ void rlUpdateTexture(unsigned int id, int width, int height, int format, const v
         glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, glFormat, glType, (unsigned char *)data);
     }
     else TraceLog(LOG_WARNING, "Texture format updating not supported");
+#endif
 }
 
 // Unload texture from GPU memory
 void rlUnloadTexture(unsigned int id)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    SwUnloadTexture(id);
+#else
     if (id > 0) glDeleteTextures(1, &id);
+    ResetStateCache();          // Deleted texture could be bound (binding reverts to 0)
+#endif
 }
 
 
@@ -2141,6 +3193,10 @@ RenderTexture2D rlLoadRenderTexture(int width, int height)
     target.depth.format = 19;       //DEPTH_COMPONENT_24BIT
     target.depth.mipmaps = 1;
 
+#if defined(GRAPHICS_API_SOFTWARE)
+    TraceLog(LOG_WARNING, "Render textures not supported by software rasterizer");
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     // Create the texture that will serve as the color attachment for the framebuffer
     glGenTextures(1, &target.texture.id);
@@ -2212,6 +3268,7 @@ RenderTexture2D rlLoadRenderTexture(int width, int height)
     else TraceLog(LOG_INFO, "[FBO ID %i] Framebuffer object created successfully", target.id);
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    ResetStateCache();          // Bindings changed out of state cache
 #endif
 
     return target;
@@ -2220,6 +3277,10 @@ RenderTexture2D rlLoadRenderTexture(int width, int height)
 // Generate mipmap data for selected texture
 void rlGenerateMipmaps(Texture2D *texture)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    // NOTE: Software rasterizer samples first mipmap level only (nearest filter)
+    TraceLog(LOG_WARNING, "[TEX ID %i] Mipmaps not supported by software rasterizer", texture->id);
+#else
     glBindTexture(GL_TEXTURE_2D, texture->id);
 
     // Check if texture is power-of-two (POT)
@@ -2284,6 +3345,8 @@ void rlGenerateMipmaps(Texture2D *texture)
     else TraceLog(LOG_WARNING, "[TEX ID %i] Mipmaps can not be generated", texture->id);
 
     glBindTexture(GL_TEXTURE_2D, 0);
+    ResetStateCache();          // Bindings changed out of state cache
+#endif
 }
 
 // Upload vertex data into a VAO (if supported) and VBO
@@ -2299,6 +3362,7 @@ void rlLoadMesh(Mesh *mesh, bool dynamic)
     mesh->vboId[5] = 0;     // Vertex texcoords2 VBO
     mesh->vboId[6] = 0;     // Vertex indices VBO
 
+    // NOTE: Software rasterizer reads mesh vertex data from CPU arrays, no upload required
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     int drawHint = GL_STATIC_DRAW;
     if (dynamic) drawHint = GL_DYNAMIC_DRAW;
@@ -2406,6 +3470,8 @@ void rlLoadMesh(Mesh *mesh, bool dynamic)
     {
         TraceLog(LOG_INFO, "[VBOs] Mesh uploaded successfully to VRAM (GPU)");
     }
+
+    ResetStateCache();          // Bindings changed out of state cache
 #endif
 }
 
@@ -2458,11 +3524,18 @@ void rlUpdateMesh(Mesh mesh, int buffer, int numVertex)
             if (numVertex >= mesh.vertexCount) glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*numVertex, mesh.texcoords2, GL_DYNAMIC_DRAW);
             else glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float)*2*numVertex, mesh.texcoords2);
         } break;
+        case 6:     // Update indices (triangles vertex indices)
+        {
+            // NOTE: In this case, numVertex is the number of indices to update (buffer size is not modified)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vboId[6]);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(unsigned short)*numVertex, mesh.indices);
+        } break;
         default: break;
     }
 
     // Unbind the current VAO
     if (vaoSupported) glBindVertexArray(0);
+    ResetStateCache();          // Bindings changed out of state cache
 
     // Another option would be using buffer mapping...
     //mesh.vertices = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
@@ -2506,9 +3579,14 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
     glBindTexture(GL_TEXTURE_2D, 0);
 #endif
 
+#if defined(GRAPHICS_API_SOFTWARE)
+    SwDrawMesh(mesh, material, transform);
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     // Bind shader program
-    glUseProgram(material.shader.id);
+    SetProgram(material.shader.id);
+    if (material.shader.id == defaultShader.id) SetUniform1i(defaultAlphaTestLoc, alphaTest);
 
     // Matrices and other values required by shader
     //-----------------------------------------------------
@@ -2517,14 +3595,14 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
 
     // Upload to shader material.colDiffuse
     if (material.shader.locs[LOC_COLOR_DIFFUSE] != -1)
-        glUniform4f(material.shader.locs[LOC_COLOR_DIFFUSE], (float)material.maps[MAP_DIFFUSE].color.r/255.0f,
-                                                           (float)material.maps[MAP_DIFFUSE].color.g/255.0f,
-                                                           (float)material.maps[MAP_DIFFUSE].color.b/255.0f,
-                                                           (float)material.maps[MAP_DIFFUSE].color.a/255.0f);
+        SetUniform4f(material.shader.locs[LOC_COLOR_DIFFUSE], (float)material.maps[MAP_DIFFUSE].color.r/255.0f,
+                                                            (float)material.maps[MAP_DIFFUSE].color.g/255.0f,
+                                                            (float)material.maps[MAP_DIFFUSE].color.b/255.0f,
+                                                            (float)material.maps[MAP_DIFFUSE].color.a/255.0f);
 
     // Upload to shader material.colSpecular (if available)
     if (material.shader.locs[LOC_COLOR_SPECULAR] != -1)
-        glUniform4f(material.shader.locs[LOC_COLOR_SPECULAR], (float)material.maps[MAP_SPECULAR].color.r/255.0f,
+        SetUniform4f(material.shader.locs[LOC_COLOR_SPECULAR], (float)material.maps[MAP_SPECULAR].color.r/255.0f,
                                                                (float)material.maps[MAP_SPECULAR].color.g/255.0f,
                                                                (float)material.maps[MAP_SPECULAR].color.b/255.0f,
                                                                (float)material.maps[MAP_SPECULAR].color.a/255.0f);
@@ -2538,7 +3616,11 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
     Matrix matProjection = projection;  // Projection matrix (perspective)
 
     // Calculate model-view matrix combining matModel and matView
-    Matrix matModelView = MatrixMultiply(transform, matView);           // Transform to camera-space coordinates
+    // NOTE: Inside rlPushMatrix()/rlPopMatrix() matrix stack transform is also combined
+    Matrix matModel = transform;
+    if (transformRequired) matModel = MatrixMultiply(transform, transformMatrix);
+
+    Matrix matModelView = MatrixMultiply(matModel, matView);            // Transform to camera-space coordinates
     //-----------------------------------------------------
 
     // Bind active texture maps (if available)
@@ -2546,34 +3628,39 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
     {
         if (material.maps[i].texture.id > 0)
         {
-            glActiveTexture(GL_TEXTURE0 + i);
-            if ((i == MAP_IRRADIANCE) || (i == MAP_PREFILTER) || (i == MAP_CUBEMAP)) glBindTexture(GL_TEXTURE_CUBE_MAP, material.maps[i].texture.id);
-            else glBindTexture(GL_TEXTURE_2D, material.maps[i].texture.id);
+            // NOTE: Cubemap bindings are not tracked by state cache
+            if ((i == MAP_IRRADIANCE) || (i == MAP_PREFILTER) || (i == MAP_CUBEMAP))
+            {
+                SetActiveTexture(i);
+                glBindTexture(GL_TEXTURE_CUBE_MAP, material.maps[i].texture.id);
+                stats.textureBinds++;
+            }
+            else SetTexture(i, material.maps[i].texture.id);
 
-            glUniform1i(material.shader.locs[LOC_MAP_DIFFUSE + i], i);
+            SetUniform1i(material.shader.locs[LOC_MAP_DIFFUSE + i], i);
         }
     }
 
     // Bind vertex array objects (or VBOs)
-    if (vaoSupported) glBindVertexArray(mesh.vaoId);
+    if (vaoSupported) SetVertexArray(mesh.vaoId);
     else
     {
         // TODO: Simplify VBO binding into a for loop
 
         // Bind mesh VBO data: vertex position (shader-location = 0)
-        glBindBuffer(GL_ARRAY_BUFFER, mesh.vboId[0]);
+        SetBuffer(GL_ARRAY_BUFFER, mesh.vboId[0]);
         glVertexAttribPointer(material.shader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
         glEnableVertexAttribArray(material.shader.locs[LOC_VERTEX_POSITION]);
 
         // Bind mesh VBO data: vertex texcoords (shader-location = 1)
-        glBindBuffer(GL_ARRAY_BUFFER, mesh.vboId[1]);
+        SetBuffer(GL_ARRAY_BUFFER, mesh.vboId[1]);
         glVertexAttribPointer(material.shader.locs[LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
         glEnableVertexAttribArray(material.shader.locs[LOC_VERTEX_TEXCOORD01]);
 
         // Bind mesh VBO data: vertex normals (shader-location = 2, if available)
         if (material.shader.locs[LOC_VERTEX_NORMAL] != -1)
         {
-            glBindBuffer(GL_ARRAY_BUFFER, mesh.vboId[2]);
+            SetBuffer(GL_ARRAY_BUFFER, mesh.vboId[2]);
             glVertexAttribPointer(material.shader.locs[LOC_VERTEX_NORMAL], 3, GL_FLOAT, 0, 0, 0);
             glEnableVertexAttribArray(material.shader.locs[LOC_VERTEX_NORMAL]);
         }
@@ -2583,7 +3670,7 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
         {
             if (mesh.vboId[3] != 0)
             {
-                glBindBuffer(GL_ARRAY_BUFFER, mesh.vboId[3]);
+                SetBuffer(GL_ARRAY_BUFFER, mesh.vboId[3]);
                 glVertexAttribPointer(material.shader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
                 glEnableVertexAttribArray(material.shader.locs[LOC_VERTEX_COLOR]);
             }
@@ -2599,7 +3686,7 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
         // Bind mesh VBO data: vertex tangents (shader-location = 4, if available)
         if (material.shader.locs[LOC_VERTEX_TANGENT] != -1)
         {
-            glBindBuffer(GL_ARRAY_BUFFER, mesh.vboId[4]);
+            SetBuffer(GL_ARRAY_BUFFER, mesh.vboId[4]);
             glVertexAttribPointer(material.shader.locs[LOC_VERTEX_TANGENT], 4, GL_FLOAT, 0, 0, 0);
             glEnableVertexAttribArray(material.shader.locs[LOC_VERTEX_TANGENT]);
         }
@@ -2607,12 +3694,12 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
         // Bind mesh VBO data: vertex texcoords2 (shader-location = 5, if available)
         if (material.shader.locs[LOC_VERTEX_TEXCOORD02] != -1)
         {
-            glBindBuffer(GL_ARRAY_BUFFER, mesh.vboId[5]);
+            SetBuffer(GL_ARRAY_BUFFER, mesh.vboId[5]);
             glVertexAttribPointer(material.shader.locs[LOC_VERTEX_TEXCOORD02], 2, GL_FLOAT, 0, 0, 0);
             glEnableVertexAttribArray(material.shader.locs[LOC_VERTEX_TEXCOORD02]);
         }
 
-        if (mesh.indices != NULL) glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vboId[6]);
+        if (mesh.indices != NULL) SetBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.vboId[6]);
     }
 
     int eyesCount = 1;
@@ -2631,32 +3718,26 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
         Matrix matMVP = MatrixMultiply(modelview, projection);        // Transform to screen-space coordinates
 
         // Send combined model-view-projection matrix to shader
-        glUniformMatrix4fv(material.shader.locs[LOC_MATRIX_MVP], 1, false, MatrixToFloat(matMVP));
+        SetUniformMatrix(material.shader.locs[LOC_MATRIX_MVP], matMVP);
 
         // Draw call!
         if (mesh.indices != NULL) glDrawElements(GL_TRIANGLES, mesh.triangleCount*3, GL_UNSIGNED_SHORT, 0); // Indexed vertices draw
         else glDrawArrays(GL_TRIANGLES, 0, mesh.vertexCount);
+        stats.drawCalls++;
     }
 
-    // Unbind all binded texture maps
+    // Unbind cubemap texture maps (not tracked by state cache)
+    // NOTE: Shader program, 2D textures and VAO (or VBOs) are kept bound,
+    // next draw only changes the ones required (state cache)
     for (int i = 0; i < MAX_MATERIAL_MAPS; i++)
     {
-        glActiveTexture(GL_TEXTURE0 + i);       // Set shader active texture
-        if ((i == MAP_IRRADIANCE) || (i == MAP_PREFILTER) || (i == MAP_CUBEMAP)) glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-        else glBindTexture(GL_TEXTURE_2D, 0);   // Unbind current active texture
-    }
-
-    // Unind vertex array objects (or VBOs)
-    if (vaoSupported) glBindVertexArray(0);
-    else
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        if (mesh.indices != NULL) glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        if ((material.maps[i].texture.id > 0) && ((i == MAP_IRRADIANCE) || (i == MAP_PREFILTER) || (i == MAP_CUBEMAP)))
+        {
+            SetActiveTexture(i);
+            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        }
     }
 
-    // Unbind shader program
-    glUseProgram(0);
-
     // Restore projection/modelview matrices
     // NOTE: In stereo rendering matrices are being modified to fit every eye
     projection = matProjection;
@@ -2694,6 +3775,9 @@ void rlUnloadMesh(Mesh *mesh)
 // Read screen pixel data (color buffer)
 unsigned char *rlReadScreenPixels(int width, int height)
 {
+#if defined(GRAPHICS_API_SOFTWARE)
+    return SwReadPixels(width, height);     // NOTE: Software framebuffer rows are already top-down
+#else
     unsigned char *screenData = (unsigned char *)calloc(width*height*4, sizeof(unsigned char));
 
     // NOTE: glReadPixels returns image flipped vertically -> (0,0) is the bottom left corner of the framebuffer
@@ -2718,6 +3802,7 @@ unsigned char *rlReadScreenPixels(int width, int height)
     free(screenData);
 
     return imgData;     // NOTE: image data should be freed
+#endif
 }
 
 // Read texture pixel data
@@ -2727,8 +3812,21 @@ void *rlReadTexturePixels(Texture2D texture)
 {
     void *pixels = NULL;
 
+#if defined(GRAPHICS_API_SOFTWARE)
+    SwTexture *data = SwGetTexture(texture.id);
+
+    // NOTE: Software rasterizer textures are stored as R8G8B8A8, other formats are not retrieved
+    if ((data != NULL) && (texture.format == UNCOMPRESSED_R8G8B8A8))
+    {
+        pixels = malloc(data->width*data->height*sizeof(Color));
+        memcpy(pixels, data->data, data->width*data->height*sizeof(Color));
+    }
+    else TraceLog(LOG_WARNING, "Texture data retrieval not suported for pixel format");
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
     glBindTexture(GL_TEXTURE_2D, texture.id);
+    ResetStateCache();          // Bindings changed out of state cache
 
     // NOTE: Using texture.id, we can retrieve some texture info (but not on OpenGL ES 2.0)
     /*
@@ -2825,6 +3923,100 @@ void *rlReadTexturePixels(Texture2D texture)
     return pixels;
 }
 
+// Issue screen pixels readback (RGBA), pixels are handed to callback by rlUpdateReadbacks() two frames later
+// NOTE: Pixels are read into a pixel buffer object (no pipeline stall waiting for GPU), if not supported
+// (OpenGL 2.1, OpenGL ES 2.0, OpenGL 1.1, software rasterizer) pixels are read and handed immediately
+void rlReadScreenPixelsAsync(int width, int height, ReadbackCallback callback, void *userData)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (readbackAsyncSupported)
+    {
+        ReadbackBuffer *readback = GetReadbackBuffer(width*height*4);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pboId);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);     // NOTE: Pixels written to bound pixel buffer
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        // NOTE: Framebuffer rows are bottom-up, negative stride hands them top-down (no flipping)
+        SubmitReadback(readback, width, height, -width*4, callback, userData);
+        return;
+    }
+#endif
+
+    unsigned char *pixels = rlReadScreenPixels(width, height);
+
+    if (callback != NULL) callback(pixels, width, height, width*4, userData);
+
+    free(pixels);
+}
+
+// Issue texture pixels readback (texture format), pixels are handed to callback by rlUpdateReadbacks() two frames later
+// NOTE: Same fallback as rlReadScreenPixelsAsync(), compressed formats are not supported
+void rlReadTexturePixelsAsync(Texture2D texture, ReadbackCallback callback, void *userData)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    int glInternalFormat, glFormat, glType;
+    GetGlFormats(texture.format, &glInternalFormat, &glFormat, &glType);
+
+    if (readbackAsyncSupported && (glInternalFormat != -1) && (texture.format < COMPRESSED_DXT1_RGB))
+    {
+        unsigned int size = GetPixelDataSize(texture.width, texture.height, texture.format);
+        ReadbackBuffer *readback = GetReadbackBuffer(size);
+
+        SetActiveTexture(0);
+        SetTexture(0, texture.id);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pboId);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTexImage(GL_TEXTURE_2D, 0, glFormat, glType, NULL);    // NOTE: Pixels written to bound pixel buffer
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        SubmitReadback(readback, texture.width, texture.height, size/texture.height, callback, userData);
+        return;
+    }
+#endif
+
+    unsigned char *pixels = (unsigned char *)rlReadTexturePixels(texture);
+
+#if defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+    int stride = texture.width*4;       // NOTE: Texture pixels are read as RGBA
+#else
+    int stride = GetPixelDataSize(texture.width, 1, texture.format);
+#endif
+
+    if ((pixels != NULL) && (callback != NULL)) callback(pixels, texture.width, texture.height, stride, userData);
+
+    free(pixels);
+}
+
+// Complete readbacks issued two frames ago (in issue order), handing mapped pixels to their callbacks
+// NOTE: Call it once per frame (frame end), readbacks issued on frame N are completed on frame N+2
+void rlUpdateReadbacks(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    ReadbackBuffer *readback = GetOldestReadback();
+
+    while ((readback != NULL) && ((readbackFrame - readback->frame) >= READBACK_FRAMES_LATENCY))
+    {
+        CompleteReadback(readback);
+        readback = GetOldestReadback();
+    }
+
+    readbackFrame++;
+#endif
+}
+
+// Complete all pending readbacks (waits for GPU), i.e. before closing readback callbacks destination
+void rlFlushReadbacks(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    ReadbackBuffer *readback = NULL;
+
+    while ((readback = GetOldestReadback()) != NULL) CompleteReadback(readback);
+#endif
+}
+
 /*
 // TODO: Record draw calls to be processed in batch
 // NOTE: Global state must be kept
@@ -2866,7 +4058,7 @@ Texture2D GetTextureDefault(void)
 // Get default shader
 Shader GetShaderDefault(void)
 {
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
     return defaultShader;
 #else
     Shader shader = { 0 };
@@ -2937,6 +4129,11 @@ Shader LoadShaderCode(char *vsCode, char *fsCode)
     // NOTE: All locations must be reseted to -1 (no location)
     for (int i = 0; i < MAX_SHADER_LOCATIONS; i++) shader.locs[i] = -1;
 
+#if defined(GRAPHICS_API_SOFTWARE)
+    TraceLog(LOG_WARNING, "Custom shaders not supported by software rasterizer, default shader used");
+    shader = defaultShader;
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     unsigned int vertexShaderId = defaultVShaderId;
     unsigned int fragmentShaderId = defaultFShaderId;
@@ -3006,8 +4203,9 @@ void BeginShaderMode(Shader shader)
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     if (currentShader.id != shader.id)
     {
-        rlglDraw();
+        FlushBuffersDefault(FLUSH_STATE);
         currentShader = shader;
+        draws[drawsCounter - 1].shaderId = shader.id;
     }
 #endif
 }
@@ -3037,7 +4235,9 @@ int GetShaderLocation(Shader shader, const char *uniformName)
 void SetShaderValue(Shader shader, int uniformLoc, const float *value, int size)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glUseProgram(shader.id);
+    SetProgram(shader.id);
+
+    if ((size >= 1) && (size <= 4) && CheckUniformCache(uniformLoc, value, size)) return;     // Value already set
 
     if (size == 1) glUniform1fv(uniformLoc, 1, value);          // Shader uniform type: float
     else if (size == 2) glUniform2fv(uniformLoc, 1, value);     // Shader uniform type: vec2
@@ -3049,11 +4249,29 @@ void SetShaderValue(Shader shader, int uniformLoc, const float *value, int size)
 #endif
 }
 
+// Set shader uniform value array (float)
+// NOTE: All array elements are uploaded with a single call
+void SetShaderValueV(Shader shader, int uniformLoc, const float *value, int size, int count)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    SetProgram(shader.id);
+    InvalidateUniforms(uniformLoc, count);      // Array values not cached (one location per element)
+
+    if (size == 1) glUniform1fv(uniformLoc, count, value);          // Shader uniform type: float[]
+    else if (size == 2) glUniform2fv(uniformLoc, count, value);     // Shader uniform type: vec2[]
+    else if (size == 3) glUniform3fv(uniformLoc, count, value);     // Shader uniform type: vec3[]
+    else if (size == 4) glUniform4fv(uniformLoc, count, value);     // Shader uniform type: vec4[]
+    else TraceLog(LOG_WARNING, "Shader value float array size not supported");
+#endif
+}
+
 // Set shader uniform value (int)
 void SetShaderValuei(Shader shader, int uniformLoc, const int *value, int size)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glUseProgram(shader.id);
+    SetProgram(shader.id);
+
+    if ((size >= 1) && (size <= 4) && CheckUniformCache(uniformLoc, value, size)) return;     // Value already set
 
     if (size == 1) glUniform1iv(uniformLoc, 1, value);          // Shader uniform type: int
     else if (size == 2) glUniform2iv(uniformLoc, 1, value);     // Shader uniform type: ivec2
@@ -3069,9 +4287,8 @@ void SetShaderValuei(Shader shader, int uniformLoc, const int *value, int size)
 void SetShaderValueMatrix(Shader shader, int uniformLoc, Matrix mat)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glUseProgram(shader.id);
-
-    glUniformMatrix4fv(uniformLoc, 1, false, MatrixToFloat(mat));
+    SetProgram(shader.id);
+    SetUniformMatrix(uniformLoc, mat);
 
     //glUseProgram(0);
 #endif
@@ -3080,7 +4297,7 @@ void SetShaderValueMatrix(Shader shader, int uniformLoc, Matrix mat)
 // Set a custom projection matrix (replaces internal projection matrix)
 void SetMatrixProjection(Matrix proj)
 {
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
     projection = proj;
 #endif
 }
@@ -3088,7 +4305,7 @@ void SetMatrixProjection(Matrix proj)
 // Set a custom modelview matrix (replaces internal modelview matrix)
 void SetMatrixModelview(Matrix view)
 {
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
     modelview = view;
 #endif
 }
@@ -3184,6 +4401,8 @@ Texture2D GenTextureCubemap(Shader shader, Texture2D skyHDR, int size)
 
     cubemap.width = size;
     cubemap.height = size;
+
+    ResetStateCache();          // Bindings changed out of state cache
 #endif
     return cubemap;
 }
@@ -3256,6 +4475,8 @@ Texture2D GenTextureIrradiance(Shader shader, Texture2D cubemap, int size)
 
     irradiance.width = size;
     irradiance.height = size;
+
+    ResetStateCache();          // Bindings changed out of state cache
 #endif
     return irradiance;
 }
@@ -3347,6 +4568,8 @@ Texture2D GenTexturePrefilter(Shader shader, Texture2D cubemap, int size)
 
     prefilter.width = size;
     prefilter.height = size;
+
+    ResetStateCache();          // Bindings changed out of state cache
 #endif
     return prefilter;
 }
@@ -3388,6 +4611,8 @@ Texture2D GenTextureBRDF(Shader shader, Texture2D cubemap, int size)
 
     brdf.width = size;
     brdf.height = size;
+
+    ResetStateCache();          // Bindings changed out of state cache
 #endif
     return brdf;
 }
@@ -3398,8 +4623,22 @@ void BeginBlendMode(int mode)
 {
     if ((blendMode != mode) && (mode < 3))
     {
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+        FlushBuffersDefault(FLUSH_STATE);
+        currentDepth = -1.0f;
+#else
         rlglDraw();
+#endif
 
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+        switch (mode)
+        {
+            case BLEND_ALPHA: SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); break;
+            case BLEND_ADDITIVE: SetBlendFunc(GL_SRC_ALPHA, GL_ONE); break; // Alternative: SetBlendFunc(GL_ONE, GL_ONE);
+            case BLEND_MULTIPLIED: SetBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA); break;
+            default: break;
+        }
+#else
         switch (mode)
         {
             case BLEND_ALPHA: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); break;
@@ -3407,6 +4646,7 @@ void BeginBlendMode(int mode)
             case BLEND_MULTIPLIED: glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA); break;
             default: break;
         }
+#endif
 
         blendMode = mode;
     }
@@ -3662,6 +4902,7 @@ void EndVrDrawing(void)
         rlDisableTexture();
 
         // Update and draw render texture fbo with distortion to backbuffer
+        SortDrawCalls();
         UpdateBuffersDefault();
         DrawBuffersDefault();
 
@@ -3683,7 +4924,8 @@ void EndVrDrawing(void)
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
 
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+#if !defined(GRAPHICS_API_SOFTWARE)
 // Compile custom shader and return shader id
 static unsigned int CompileShader(const char *shaderStr, int type)
 {
@@ -3836,14 +5078,19 @@ static Shader LoadShaderDefault(void)
 #endif
     "uniform sampler2D texture0;        \n"
     "uniform vec4 colDiffuse;           \n"
+    "uniform int alphaTest;             \n"
     "void main()                        \n"
     "{                                  \n"
 #if defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_OPENGL_21)
     "    vec4 texelColor = texture2D(texture0, fragTexCoord); \n" // NOTE: texture2D() is deprecated on OpenGL 3.3 and ES 3.0
-    "    gl_FragColor = texelColor*colDiffuse*fragColor;      \n"
+    "    vec4 color = texelColor*colDiffuse*fragColor;        \n"
+    "    if ((alphaTest == 1) && (color.a <= 0.0)) discard;   \n"
+    "    gl_FragColor = color;                                \n"
 #elif defined(GRAPHICS_API_OPENGL_33)
     "    vec4 texelColor = texture(texture0, fragTexCoord);   \n"
-    "    finalColor = texelColor*colDiffuse*fragColor;        \n"
+    "    vec4 color = texelColor*colDiffuse*fragColor;        \n"
+    "    if ((alphaTest == 1) && (color.a <= 0.0)) discard;   \n"
+    "    finalColor = color;                                  \n"
 #endif
     "}                                  \n";
 
@@ -3867,6 +5114,9 @@ static Shader LoadShaderDefault(void)
         shader.locs[LOC_COLOR_DIFFUSE] = glGetUniformLocation(shader.id, "colDiffuse");
         shader.locs[LOC_MAP_DIFFUSE] = glGetUniformLocation(shader.id, "texture0");
 
+        // NOTE: Alpha test is not a standard location, it is only set when drawing with default shader
+        defaultAlphaTestLoc = glGetUniformLocation(shader.id, "alphaTest");
+
         // NOTE: We could also use below function but in case DEFAULT_ATTRIB_* points are
         // changed for external custom shaders, we just use direct bindings above
         //SetShaderDefaultLocations(&shader);
@@ -3921,56 +5171,63 @@ static void UnloadShaderDefault(void)
     glDeleteProgram(defaultShader.id);
 }
 
+#endif  // !defined(GRAPHICS_API_SOFTWARE)
+
 // Load default internal buffers (lines, triangles, quads)
-static void LoadBuffersDefault(void)
+static void LoadBuffersDefault(int linesCount, int trianglesCount, int quadsCount)
 {
+    // Select default buffers streaming mode
+    // NOTE: Ring buffer segments are drawn with first vertex/base vertex offsets (OpenGL 3.2),
+    // persistent mapping requires GL_ARB_buffer_storage (OpenGL 4.4), it can be disabled
+    // defining RLGL_NO_PERSISTENT_MAPPING and streaming defining RLGL_NO_BUFFER_STREAMING
+#if defined(GRAPHICS_API_OPENGL_33) && !defined(__APPLE__) && !defined(RLGL_NO_BUFFER_STREAMING)
+    if (GLAD_GL_VERSION_3_2)
+    {
+        streamMode = STREAM_MODE_UNSYNCHRONIZED;
+    #if !defined(RLGL_NO_PERSISTENT_MAPPING)
+        if (GLAD_GL_ARB_buffer_storage) streamMode = STREAM_MODE_PERSISTENT;
+        #if defined(RLGL_CAPTURE)
+        // NOTE: Persistent mapped buffers writes can not be captured (buffers never unmapped)
+        if (IsGlCaptureActive()) streamMode = STREAM_MODE_UNSYNCHRONIZED;
+        #endif
+    #endif
+    }
+#endif
+
     // [CPU] Allocate and initialize float array buffers to store vertex data (lines, triangles, quads)
     //--------------------------------------------------------------------------------------------
 
-    // Lines - Initialize arrays (vertex position and color data)
-    lines.vertices = (float *)malloc(sizeof(float)*3*2*MAX_LINES_BATCH);        // 3 float by vertex, 2 vertex by line
-    lines.colors = (unsigned char *)malloc(sizeof(unsigned char)*4*2*MAX_LINES_BATCH);  // 4 float by color, 2 colors by line
-    lines.texcoords = NULL;
+    // Lines - Initialize arrays (vertex data, texcoords not used)
+    lines.vCapacity = 2*linesCount;     // 2 vertex by line
+    lines.vertices = (DynamicVertex *)calloc(lines.vCapacity, sizeof(DynamicVertex));
     lines.indices = NULL;
 
-    for (int i = 0; i < (3*2*MAX_LINES_BATCH); i++) lines.vertices[i] = 0.0f;
-    for (int i = 0; i < (4*2*MAX_LINES_BATCH); i++) lines.colors[i] = 0;
-
     lines.vCounter = 0;
     lines.cCounter = 0;
     lines.tcCounter = 0;
 
-    // Triangles - Initialize arrays (vertex position and color data)
-    triangles.vertices = (float *)malloc(sizeof(float)*3*3*MAX_TRIANGLES_BATCH);        // 3 float by vertex, 3 vertex by triangle
-    triangles.colors = (unsigned char *)malloc(sizeof(unsigned char)*4*3*MAX_TRIANGLES_BATCH);  // 4 float by color, 3 colors by triangle
-    triangles.texcoords = NULL;
+    // Triangles - Initialize arrays (vertex data, texcoords not used)
+    triangles.vCapacity = 3*trianglesCount;     // 3 vertex by triangle
+    triangles.vertices = (DynamicVertex *)calloc(triangles.vCapacity, sizeof(DynamicVertex));
     triangles.indices = NULL;
 
-    for (int i = 0; i < (3*3*MAX_TRIANGLES_BATCH); i++) triangles.vertices[i] = 0.0f;
-    for (int i = 0; i < (4*3*MAX_TRIANGLES_BATCH); i++) triangles.colors[i] = 0;
-
     triangles.vCounter = 0;
     triangles.cCounter = 0;
     triangles.tcCounter = 0;
 
-    // Quads - Initialize arrays (vertex position, texcoord, color data and indexes)
-    quads.vertices = (float *)malloc(sizeof(float)*3*4*MAX_QUADS_BATCH);        // 3 float by vertex, 4 vertex by quad
-    quads.texcoords = (float *)malloc(sizeof(float)*2*4*MAX_QUADS_BATCH);       // 2 float by texcoord, 4 texcoord by quad
-    quads.colors = (unsigned char *)malloc(sizeof(unsigned char)*4*4*MAX_QUADS_BATCH);  // 4 float by color, 4 colors by quad
-#if defined(GRAPHICS_API_OPENGL_33)
-    quads.indices = (unsigned int *)malloc(sizeof(unsigned int)*6*MAX_QUADS_BATCH);      // 6 int by quad (indices)
+    // Quads - Initialize arrays (vertex data and indexes)
+    quads.vCapacity = 4*quadsCount;     // 4 vertex by quad
+    quads.vertices = (DynamicVertex *)calloc(quads.vCapacity, sizeof(DynamicVertex));
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_SOFTWARE)
+    quads.indices = (unsigned int *)malloc(sizeof(unsigned int)*6*quadsCount);      // 6 int by quad (indices)
 #elif defined(GRAPHICS_API_OPENGL_ES2)
-    quads.indices = (unsigned short *)malloc(sizeof(unsigned short)*6*MAX_QUADS_BATCH);  // 6 int by quad (indices)
+    quads.indices = (unsigned short *)malloc(sizeof(unsigned short)*6*quadsCount);  // 6 int by quad (indices)
 #endif
 
-    for (int i = 0; i < (3*4*MAX_QUADS_BATCH); i++) quads.vertices[i] = 0.0f;
-    for (int i = 0; i < (2*4*MAX_QUADS_BATCH); i++) quads.texcoords[i] = 0.0f;
-    for (int i = 0; i < (4*4*MAX_QUADS_BATCH); i++) quads.colors[i] = 0;
-
     int k = 0;
 
     // Indices can be initialized right now
-    for (int i = 0; i < (6*MAX_QUADS_BATCH); i+=6)
+    for (int i = 0; i < (6*quadsCount); i+=6)
     {
         quads.indices[i] = 4*k;
         quads.indices[i+1] = 4*k+1;
@@ -3989,6 +5246,7 @@ static void LoadBuffersDefault(void)
     TraceLog(LOG_INFO, "[CPU] Default buffers initialized successfully (lines, triangles, quads)");
     //--------------------------------------------------------------------------------------------
 
+#if !defined(GRAPHICS_API_SOFTWARE)
     // [GPU] Upload vertex data and initialize VAOs/VBOs (lines, triangles, quads)
     // NOTE: Default buffers are linked to use currentShader (defaultShader)
     //--------------------------------------------------------------------------------------------
@@ -4001,23 +5259,12 @@ static void LoadBuffersDefault(void)
         glBindVertexArray(lines.vaoId);
     }
 
-    // Lines - Vertex buffers binding and attributes enable
-    // Vertex position buffer (shader-location = 0)
-    glGenBuffers(2, &lines.vboId[0]);
-    glBindBuffer(GL_ARRAY_BUFFER, lines.vboId[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*2*MAX_LINES_BATCH, lines.vertices, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
-    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-
-    // Vertex color buffer (shader-location = 3)
-    glGenBuffers(2, &lines.vboId[1]);
-    glBindBuffer(GL_ARRAY_BUFFER, lines.vboId[1]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(unsigned char)*4*2*MAX_LINES_BATCH, lines.colors, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
-    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+    // Lines - Vertex buffer binding and attributes enable (interleaved vertex data)
+    lines.vboId[0] = LoadBufferSegments(sizeof(DynamicVertex)*lines.vCapacity, lines.vertices, &lines.mapped);
+    SetVertexAttribsDefault(lines.vboId[0]);
 
     if (vaoSupported) TraceLog(LOG_INFO, "[VAO ID %i] Default buffers VAO initialized successfully (lines)", lines.vaoId);
-    else TraceLog(LOG_INFO, "[VBO ID %i][VBO ID %i] Default buffers VBOs initialized successfully (lines)", lines.vboId[0], lines.vboId[1]);
+    else TraceLog(LOG_INFO, "[VBO ID %i] Default buffers VBOs initialized successfully (lines)", lines.vboId[0]);
 
     // Upload and link triangles vertex buffers
     if (vaoSupported)
@@ -4027,23 +5274,12 @@ static void LoadBuffersDefault(void)
         glBindVertexArray(triangles.vaoId);
     }
 
-    // Triangles - Vertex buffers binding and attributes enable
-    // Vertex position buffer (shader-location = 0)
-    glGenBuffers(1, &triangles.vboId[0]);
-    glBindBuffer(GL_ARRAY_BUFFER, triangles.vboId[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*3*MAX_TRIANGLES_BATCH, triangles.vertices, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
-    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-
-    // Vertex color buffer (shader-location = 3)
-    glGenBuffers(1, &triangles.vboId[1]);
-    glBindBuffer(GL_ARRAY_BUFFER, triangles.vboId[1]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(unsigned char)*4*3*MAX_TRIANGLES_BATCH, triangles.colors, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
-    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+    // Triangles - Vertex buffer binding and attributes enable (interleaved vertex data)
+    triangles.vboId[0] = LoadBufferSegments(sizeof(DynamicVertex)*triangles.vCapacity, triangles.vertices, &triangles.mapped);
+    SetVertexAttribsDefault(triangles.vboId[0]);
 
     if (vaoSupported) TraceLog(LOG_INFO, "[VAO ID %i] Default buffers VAO initialized successfully (triangles)", triangles.vaoId);
-    else TraceLog(LOG_INFO, "[VBO ID %i][VBO ID %i] Default buffers VBOs initialized successfully (triangles)", triangles.vboId[0], triangles.vboId[1]);
+    else TraceLog(LOG_INFO, "[VBO ID %i] Default buffers VBOs initialized successfully (triangles)", triangles.vboId[0]);
 
     // Upload and link quads vertex buffers
     if (vaoSupported)
@@ -4053,116 +5289,81 @@ static void LoadBuffersDefault(void)
         glBindVertexArray(quads.vaoId);
     }
 
-    // Quads - Vertex buffers binding and attributes enable
-    // Vertex position buffer (shader-location = 0)
-    glGenBuffers(1, &quads.vboId[0]);
-    glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*MAX_QUADS_BATCH, quads.vertices, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
-    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-
-    // Vertex texcoord buffer (shader-location = 1)
-    glGenBuffers(1, &quads.vboId[1]);
-    glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[1]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*MAX_QUADS_BATCH, quads.texcoords, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_TEXCOORD01]);
-    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-
-    // Vertex color buffer (shader-location = 3)
-    glGenBuffers(1, &quads.vboId[2]);
-    glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[2]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(unsigned char)*4*4*MAX_QUADS_BATCH, quads.colors, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
-    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+    // Quads - Vertex buffer binding and attributes enable (interleaved vertex data)
+    quads.vboId[0] = LoadBufferSegments(sizeof(DynamicVertex)*quads.vCapacity, quads.vertices, &quads.mapped);
+    SetVertexAttribsDefault(quads.vboId[0]);
 
     // Fill index buffer
-    glGenBuffers(1, &quads.vboId[3]);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quads.vboId[3]);
+    glGenBuffers(1, &quads.vboId[1]);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quads.vboId[1]);
 #if defined(GRAPHICS_API_OPENGL_33)
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int)*6*MAX_QUADS_BATCH, quads.indices, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int)*6*quadsCount, quads.indices, GL_STATIC_DRAW);
 #elif defined(GRAPHICS_API_OPENGL_ES2)
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(short)*6*MAX_QUADS_BATCH, quads.indices, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(short)*6*quadsCount, quads.indices, GL_STATIC_DRAW);
 #endif
 
     if (vaoSupported) TraceLog(LOG_INFO, "[VAO ID %i] Default buffers VAO initialized successfully (quads)", quads.vaoId);
-    else TraceLog(LOG_INFO, "[VBO ID %i][VBO ID %i][VBO ID %i][VBO ID %i] Default buffers VBOs initialized successfully (quads)", quads.vboId[0], quads.vboId[1], quads.vboId[2], quads.vboId[3]);
+    else TraceLog(LOG_INFO, "[VBO ID %i][VBO ID %i] Default buffers VBOs initialized successfully (quads)", quads.vboId[0], quads.vboId[1]);
 
     // Unbind the current VAO
     if (vaoSupported) glBindVertexArray(0);
+
+    // Persistent streaming: vertex data is written directly into mapped buffers, CPU arrays not required
+    if (streamMode == STREAM_MODE_PERSISTENT)
+    {
+        free(lines.vertices);
+        free(triangles.vertices);
+        free(quads.vertices);
+
+        SetBuffersDefaultSegment(0);
+    }
+
+    if (streamMode == STREAM_MODE_PERSISTENT) TraceLog(LOG_INFO, "[GPU] Default buffers streaming: persistent mapped ring buffer (%i segments)", DEFAULT_BUFFERS_SEGMENTS);
+    else if (streamMode == STREAM_MODE_UNSYNCHRONIZED) TraceLog(LOG_INFO, "[GPU] Default buffers streaming: unsynchronized mapping ring buffer (%i segments)", DEFAULT_BUFFERS_SEGMENTS);
     //--------------------------------------------------------------------------------------------
+#endif
 }
 
+#if !defined(GRAPHICS_API_SOFTWARE)
 // Update default internal buffers (VAOs/VBOs) with vertex array data
 // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
 // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (change flag required)
 static void UpdateBuffersDefault(void)
 {
+    // NOTE: On persistent streaming, vertex data is considered uploaded when written into mapped buffers
+    stats.bytesUploaded += sizeof(DynamicVertex)*(lines.vCounter + triangles.vCounter + quads.vCounter);
+
+    // Persistent mapped buffers already contain vertex data (coherent mapping)
+    if (streamMode == STREAM_MODE_PERSISTENT) return;
+
     // Update lines vertex buffers
     if (lines.vCounter > 0)
     {
-        // Activate Lines VAO
-        if (vaoSupported) glBindVertexArray(lines.vaoId);
-
-        // Lines - vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, lines.vboId[0]);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*2*MAX_LINES_BATCH, lines.vertices, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float)*3*lines.vCounter, lines.vertices);    // target - offset (in bytes) - size (in bytes) - data pointer
-
-        // Lines - colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, lines.vboId[1]);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*2*MAX_LINES_BATCH, lines.colors, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(unsigned char)*4*lines.cCounter, lines.colors);
+        // Lines - vertex data buffer (single upload)
+        // NOTE: GL_ARRAY_BUFFER binding is not VAO state, no VAO binding required
+        UpdateBufferSegment(lines.vboId[0], sizeof(DynamicVertex)*lines.vCapacity, sizeof(DynamicVertex)*lines.vCounter, lines.vertices);
     }
 
     // Update triangles vertex buffers
     if (triangles.vCounter > 0)
     {
-        // Activate Triangles VAO
-        if (vaoSupported) glBindVertexArray(triangles.vaoId);
-
-        // Triangles - vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, triangles.vboId[0]);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*3*MAX_TRIANGLES_BATCH, triangles.vertices, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float)*3*triangles.vCounter, triangles.vertices);
-
-        // Triangles - colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, triangles.vboId[1]);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*3*MAX_TRIANGLES_BATCH, triangles.colors, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(unsigned char)*4*triangles.cCounter, triangles.colors);
+        // Triangles - vertex data buffer (single upload)
+        // NOTE: GL_ARRAY_BUFFER binding is not VAO state, no VAO binding required
+        UpdateBufferSegment(triangles.vboId[0], sizeof(DynamicVertex)*triangles.vCapacity, sizeof(DynamicVertex)*triangles.vCounter, triangles.vertices);
     }
 
     // Update quads vertex buffers
     if (quads.vCounter > 0)
     {
-        // Activate Quads VAO
-        if (vaoSupported) glBindVertexArray(quads.vaoId);
-
-        // Quads - vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[0]);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*MAX_QUADS_BATCH, quads.vertices, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float)*3*quads.vCounter, quads.vertices);
-
-        // Quads - texture coordinates buffer
-        glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[1]);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*MAX_QUADS_BATCH, quads.texcoords, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float)*2*quads.vCounter, quads.texcoords);
-
-        // Quads - colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[2]);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*MAX_QUADS_BATCH, quads.colors, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(unsigned char)*4*quads.vCounter, quads.colors);
-
-        // Another option would be using buffer mapping...
-        //quads.vertices = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
-        // Now we can modify vertices
-        //glUnmapBuffer(GL_ARRAY_BUFFER);
+        // Quads - vertex data buffer (single upload)
+        // NOTE: GL_ARRAY_BUFFER binding is not VAO state, no VAO binding required
+        UpdateBufferSegment(quads.vboId[0], sizeof(DynamicVertex)*quads.vCapacity, sizeof(DynamicVertex)*quads.vCounter, quads.vertices);
     }
     //--------------------------------------------------------------
-
-    // Unbind the current VAO
-    if (vaoSupported) glBindVertexArray(0);
 }
 
+#endif
+
 // Draw default internal buffers vertex data
 // NOTE: We draw in this order: lines, triangles, quads
 static void DrawBuffersDefault(void)
@@ -4181,17 +5382,23 @@ static void DrawBuffersDefault(void)
         if (eyesCount == 2) SetStereoView(eye, matProjection, matModelView);
         #endif
 
+#if defined(GRAPHICS_API_SOFTWARE)
+        // NOTE: Vertex data is rasterized directly from CPU arrays, no upload required
+        SwDrawBuffersDefault(MatrixMultiply(modelview, projection));
+#else
         // Set current shader and upload current MVP matrix
         if ((lines.vCounter > 0) || (triangles.vCounter > 0) || (quads.vCounter > 0))
         {
-            glUseProgram(currentShader.id);
+            // NOTE: Shader program and uniform values are only changed if required (state cache)
+            SetProgram(currentShader.id);
 
             // Create modelview-projection matrix
             Matrix matMVP = MatrixMultiply(modelview, projection);
 
-            glUniformMatrix4fv(currentShader.locs[LOC_MATRIX_MVP], 1, false, MatrixToFloat(matMVP));
-            glUniform4f(currentShader.locs[LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
-            glUniform1i(currentShader.locs[LOC_MAP_DIFFUSE], 0);
+            SetUniformMatrix(currentShader.locs[LOC_MATRIX_MVP], matMVP);
+            SetUniform4f(currentShader.locs[LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
+            SetUniform1i(currentShader.locs[LOC_MAP_DIFFUSE], 0);
+            if (currentShader.id == defaultShader.id) SetUniform1i(defaultAlphaTestLoc, alphaTest);
 
             // NOTE: Additional map textures not considered for default buffers drawing
         }
@@ -4199,59 +5406,25 @@ static void DrawBuffersDefault(void)
         // Draw lines buffers
         if (lines.vCounter > 0)
         {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, whiteTexture);
-
-            if (vaoSupported)
-            {
-                glBindVertexArray(lines.vaoId);
-            }
-            else
-            {
-                // Bind vertex attrib: position (shader-location = 0)
-                glBindBuffer(GL_ARRAY_BUFFER, lines.vboId[0]);
-                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
-
-                // Bind vertex attrib: color (shader-location = 3)
-                glBindBuffer(GL_ARRAY_BUFFER, lines.vboId[1]);
-                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
-                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
-            }
+            SetTexture(0, whiteTexture);
 
-            glDrawArrays(GL_LINES, 0, lines.vCounter);
+            if (vaoSupported) SetVertexArray(lines.vaoId);
+            else SetVertexAttribsDefault(lines.vboId[0]);     // Bind vertex attribs: position, texcoord, color
 
-            if (!vaoSupported) glBindBuffer(GL_ARRAY_BUFFER, 0);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            glDrawArrays(GL_LINES, lines.vCapacity*streamSegment, lines.vCounter);
+            stats.drawCalls++;
         }
 
         // Draw triangles buffers
         if (triangles.vCounter > 0)
         {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, whiteTexture);
-
-            if (vaoSupported)
-            {
-                glBindVertexArray(triangles.vaoId);
-            }
-            else
-            {
-                // Bind vertex attrib: position (shader-location = 0)
-                glBindBuffer(GL_ARRAY_BUFFER, triangles.vboId[0]);
-                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
-
-                // Bind vertex attrib: color (shader-location = 3)
-                glBindBuffer(GL_ARRAY_BUFFER, triangles.vboId[1]);
-                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
-                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
-            }
+            SetTexture(0, whiteTexture);
 
-            glDrawArrays(GL_TRIANGLES, 0, triangles.vCounter);
+            if (vaoSupported) SetVertexArray(triangles.vaoId);
+            else SetVertexAttribsDefault(triangles.vboId[0]);     // Bind vertex attribs: position, texcoord, color
 
-            if (!vaoSupported) glBindBuffer(GL_ARRAY_BUFFER, 0);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            glDrawArrays(GL_TRIANGLES, triangles.vCapacity*streamSegment, triangles.vCounter);
+            stats.drawCalls++;
         }
 
         // Draw quads buffers
@@ -4259,67 +5432,60 @@ static void DrawBuffersDefault(void)
         {
             int quadsCount = 0;
             int numIndicesToProcess = 0;
-            int indicesOffset = 0;
+            int indicesOffset = 0;      // NOTE: Draw calls vertex data could be out of order (sorted draw calls)
 
-            if (vaoSupported)
-            {
-                glBindVertexArray(quads.vaoId);
-            }
+            if (vaoSupported) SetVertexArray(quads.vaoId);
             else
             {
-                // Bind vertex attrib: position (shader-location = 0)
-                glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[0]);
-                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
-
-                // Bind vertex attrib: texcoord (shader-location = 1)
-                glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[1]);
-                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_TEXCOORD01]);
-
-                // Bind vertex attrib: color (shader-location = 3)
-                glBindBuffer(GL_ARRAY_BUFFER, quads.vboId[2]);
-                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
-                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
-
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quads.vboId[3]);
+                SetVertexAttribsDefault(quads.vboId[0]);     // Bind vertex attribs: position, texcoord, color
+                SetBuffer(GL_ELEMENT_ARRAY_BUFFER, quads.vboId[1]);
             }
 
             for (int i = 0; i < drawsCounter; i++)
             {
+                if (draws[i].vertexCount == 0) continue;    // Empty draw (texture enabled but nothing drawn)
+
                 quadsCount = draws[i].vertexCount/4;
                 numIndicesToProcess = quadsCount*6;  // Get number of Quads*6 index by Quad
 
                 //TraceLog(LOG_DEBUG, "Quads to render: %i - Vertex Count: %i", quadsCount, draws[i].vertexCount);
 
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, draws[i].textureId);
+                SetTexture(0, draws[i].textureId);
+
+                indicesOffset = draws[i].vertexOffset/4*6;
 
                 // NOTE: The final parameter tells the GPU the offset in bytes from the start of the index buffer to the location of the first index to process
     #if defined(GRAPHICS_API_OPENGL_33)
-                glDrawElements(GL_TRIANGLES, numIndicesToProcess, GL_UNSIGNED_INT, (GLvoid *)(sizeof(GLuint)*indicesOffset));
+                // NOTE: Streaming ring buffer segment vertex data is offset with base vertex
+                if (streamMode != STREAM_MODE_SUBDATA) glDrawElementsBaseVertex(GL_TRIANGLES, numIndicesToProcess, GL_UNSIGNED_INT, (GLvoid *)(sizeof(GLuint)*indicesOffset), quads.vCapacity*streamSegment);
+                else glDrawElements(GL_TRIANGLES, numIndicesToProcess, GL_UNSIGNED_INT, (GLvoid *)(sizeof(GLuint)*indicesOffset));
     #elif defined(GRAPHICS_API_OPENGL_ES2)
                 glDrawElements(GL_TRIANGLES, numIndicesToProcess, GL_UNSIGNED_SHORT, (GLvoid *)(sizeof(GLushort)*indicesOffset));
     #endif
                 //GLenum err;
                 //if ((err = glGetError()) != GL_NO_ERROR) TraceLog(LOG_INFO, "OpenGL error: %i", (int)err);    //GL_INVALID_ENUM!
 
-                indicesOffset += draws[i].vertexCount/4*6;
+                stats.drawCalls++;
             }
+        }
 
-            if (!vaoSupported)
-            {
-                glBindBuffer(GL_ARRAY_BUFFER, 0);
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-            }
+        // NOTE: Shader program, textures and VAO are not unbound,
+        // next flush only changes the ones required (state cache)
+#endif
+    }
 
-            glBindTexture(GL_TEXTURE_2D, 0);    // Unbind textures
-        }
+    // Streaming: next vertex data goes to next ring buffer segment
+    if (streamMode != STREAM_MODE_SUBDATA) SetBuffersDefaultSegment((streamSegment + 1)%DEFAULT_BUFFERS_SEGMENTS);
 
-        if (vaoSupported) glBindVertexArray(0); // Unbind VAO
+    // Update rendering statistics (vertex drawn by primitive type)
+    stats.linesVertex += lines.vCounter;
+    stats.trianglesVertex += triangles.vCounter;
+    stats.quadsVertex += quads.vCounter;
 
-        glUseProgram(0);    // Unbind shader program
-    }
+    // Update buffers high-water mark (batch size statistic)
+    if (lines.vCounter > lines.vCounterMax) lines.vCounterMax = lines.vCounter;
+    if (triangles.vCounter > triangles.vCounterMax) triangles.vCounterMax = triangles.vCounter;
+    if (quads.vCounter > quads.vCounterMax) quads.vCounterMax = quads.vCounter;
 
     // Reset vertex counters for next frame
     lines.vCounter = 0;
@@ -4330,22 +5496,49 @@ static void DrawBuffersDefault(void)
     quads.tcCounter = 0;
     quads.cCounter = 0;
 
-    // Reset depth for next draw
-    currentDepth = -1.0f;
-
     // Restore projection/modelview matrices
     projection = matProjection;
     modelview = matModelView;
 
-    // Reset draws counter
+    // Reset draws counter, current texture is kept for next batch (draw could be forced anywhere)
+    draws[0].textureId = draws[drawsCounter - 1].textureId;
     drawsCounter = 1;
-    draws[0].textureId = whiteTexture;
+    draws[0].shaderId = currentShader.id;
+    draws[0].layer = currentLayer;
     draws[0].vertexCount = 0;
 }
 
+// Sort, update and draw default internal buffers
+// NOTE: Used on forced draws (buffers limit, state changes), recording state is kept: depth, current
+// texture and matrix stack, so batch can be drawn anywhere without visual changes
+static void FlushBuffersDefault(int reason)
+{
+    stats.flushes++;
+
+    switch (reason)
+    {
+        case FLUSH_EXPLICIT: stats.flushesExplicit++; break;
+        case FLUSH_CAPACITY: stats.flushesCapacity++; break;
+        case FLUSH_DRAWS_LIMIT: stats.flushesDrawsLimit++; break;
+        case FLUSH_STATE: stats.flushesState++; break;
+        default: break;
+    }
+
+    SortDrawCalls();            // NOTE: Only on deferred submission (draw calls sorting mode)
+#if !defined(GRAPHICS_API_SOFTWARE)
+    UpdateBuffersDefault();
+#endif
+    DrawBuffersDefault();       // NOTE: Stereo rendering is checked inside
+}
+
 // Unload default internal buffers vertex data from CPU and GPU
 static void UnloadBuffersDefault(void)
 {
+    TraceLog(LOG_INFO, "[BATCH] Lines buffer: %i vertex capacity, %i vertex high-water mark", lines.vCapacity, lines.vCounterMax);
+    TraceLog(LOG_INFO, "[BATCH] Triangles buffer: %i vertex capacity, %i vertex high-water mark", triangles.vCapacity, triangles.vCounterMax);
+    TraceLog(LOG_INFO, "[BATCH] Quads buffer: %i vertex capacity, %i vertex high-water mark", quads.vCapacity, quads.vCounterMax);
+
+#if !defined(GRAPHICS_API_SOFTWARE)
     // Unbind everything
     if (vaoSupported) glBindVertexArray(0);
     glDisableVertexAttribArray(0);
@@ -4357,13 +5550,9 @@ static void UnloadBuffersDefault(void)
 
     // Delete VBOs from GPU (VRAM)
     glDeleteBuffers(1, &lines.vboId[0]);
-    glDeleteBuffers(1, &lines.vboId[1]);
     glDeleteBuffers(1, &triangles.vboId[0]);
-    glDeleteBuffers(1, &triangles.vboId[1]);
     glDeleteBuffers(1, &quads.vboId[0]);
     glDeleteBuffers(1, &quads.vboId[1]);
-    glDeleteBuffers(1, &quads.vboId[2]);
-    glDeleteBuffers(1, &quads.vboId[3]);
 
     if (vaoSupported)
     {
@@ -4373,403 +5562,1965 @@ static void UnloadBuffersDefault(void)
         glDeleteVertexArrays(1, &quads.vaoId);
     }
 
-    // Free vertex arrays memory from CPU (RAM)
-    free(lines.vertices);
-    free(lines.colors);
+#if defined(GRAPHICS_API_OPENGL_33)
+    // Delete streaming segments fences
+    for (int i = 0; i < DEFAULT_BUFFERS_SEGMENTS; i++)
+    {
+        if (streamFences[i] != NULL) glDeleteSync(streamFences[i]);
+        streamFences[i] = NULL;
+    }
+#endif
+#endif  // !defined(GRAPHICS_API_SOFTWARE)
 
-    free(triangles.vertices);
-    free(triangles.colors);
+    // Free vertex arrays memory from CPU (RAM)
+    // NOTE: On persistent streaming vertex arrays are mapped memory, released with buffers
+    if (streamMode != STREAM_MODE_PERSISTENT)
+    {
+        free(lines.vertices);
+        free(triangles.vertices);
+        free(quads.vertices);
+    }
 
-    free(quads.vertices);
-    free(quads.texcoords);
-    free(quads.colors);
     free(quads.indices);
 }
 
-// Renders a 1x1 XY quad in NDC
-static void GenDrawQuad(void)
+// Start a new quads draw call with texture and current layer and shader
+// NOTE: Current draw call is reused if it has no vertex data, draws array grows when required
+static void PushDrawCall(unsigned int textureId)
 {
-    unsigned int quadVAO = 0;
-    unsigned int quadVBO = 0;
+    if (draws[drawsCounter - 1].vertexCount > 0)
+    {
+        if (drawsCounter >= drawsCapacity)
+        {
+            DrawCall *newDraws = (DrawCall *)realloc(draws, sizeof(DrawCall)*2*drawsCapacity);
 
-    float vertices[] = {
-        // Positions        // Texture Coords
-        -1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-        -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-        1.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-        1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-    };
+            if (newDraws != NULL)
+            {
+                draws = newDraws;
+                drawsCapacity *= 2;
+            }
+            else FlushBuffersDefault(FLUSH_DRAWS_LIMIT);
+        }
 
-    // Set up plane VAO
-    glGenVertexArrays(1, &quadVAO);
-    glGenBuffers(1, &quadVBO);
-    glBindVertexArray(quadVAO);
+        if (draws[drawsCounter - 1].vertexCount > 0) drawsCounter++;
+    }
 
-    // Fill buffer
-    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
+    draws[drawsCounter - 1].textureId = textureId;
+    draws[drawsCounter - 1].shaderId = currentShader.id;
+    draws[drawsCounter - 1].layer = currentLayer;
+    draws[drawsCounter - 1].vertexCount = 0;
+}
 
-    // Link vertex attributes
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void *)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void *)(3*sizeof(float)));
+// Sort quads draw calls by key (layer, texture) and merge adjacent draws sharing texture
+// NOTE: Shader is not a sort key, shader changes flush the batch (uniforms values are set
+// immediately), so all draw calls in a batch use the same shader
+// NOTE: Sort is stable (recording order is the last key), quads vertex data is reordered
+// to keep every merged draw call vertex data contiguous (single indexed draw)
+// NOTE: Draw calls vertex offsets are always set (recording order), required by DrawBuffersDefault()
+static void SortDrawCalls(void)
+{
+    int offset = 0;
 
-    // Draw quad
-    glBindVertexArray(quadVAO);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
+    for (int i = 0; i < drawsCounter; i++)
+    {
+        draws[i].vertexOffset = offset;
+        offset += draws[i].vertexCount;
+    }
 
-    glDeleteBuffers(1, &quadVBO);
-    glDeleteVertexArrays(1, &quadVAO);
-}
+    if ((drawSortMode == RL_SORT_NONE) || (drawsCounter < 2) || (quads.vCounter == 0)) return;
 
-// Renders a 1x1 3D cube in NDC
-static void GenDrawCube(void)
-{
-    unsigned int cubeVAO = 0;
-    unsigned int cubeVBO = 0;
+    qsort(draws, drawsCounter, sizeof(DrawCall), CompareDrawCalls);
 
-    float vertices[] = {
-        -1.0f, -1.0f, -1.0f,  0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
-        1.0f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
-        1.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f,
-        1.0f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
-        -1.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
-        -1.0f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f,
-        -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-        1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f,
-        1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
-        1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
-        -1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f,
-        -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-        -1.0f, 1.0f, 1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        -1.0f, 1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-        -1.0f, -1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-        -1.0f, -1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-        -1.0f, -1.0f, 1.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-        -1.0f, 1.0f, 1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-        1.0f, 1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-        1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-        1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        1.0f, -1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-        -1.0f, -1.0f, -1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f,
-        1.0f, -1.0f, -1.0f, 0.0f, -1.0f, 0.0f, 1.0f, 1.0f,
-        1.0f, -1.0f, 1.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-        1.0f, -1.0f, 1.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-        -1.0f, -1.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-        -1.0f, -1.0f, -1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f,
-        -1.0f, 1.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-        1.0f, 1.0f , 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f,
-        1.0f, 1.0f, -1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-        1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f,
-        -1.0f, 1.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-        -1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f
-    };
+    // Persistent streaming: quads vertex data is written directly into mapped memory (write-combined),
+    // reading it back for reordering is slow, vertex data is kept in place (only sorted draws submission)
+    bool reorder = (streamMode != STREAM_MODE_PERSISTENT);
 
-    // Set up cube VAO
-    glGenVertexArrays(1, &cubeVAO);
-    glGenBuffers(1, &cubeVBO);
+    if (reorder && (sortVerticesCapacity < quads.vCounter))
+    {
+        free(sortVertices);
+        sortVertices = (DynamicVertex *)malloc(sizeof(DynamicVertex)*quads.vCapacity);
+        sortVerticesCapacity = (sortVertices != NULL)? quads.vCapacity : 0;
+        reorder = (sortVertices != NULL);
+    }
 
-    // Fill buffer
-    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    // Copy vertex data in sorted order, merging draws with same texture and contiguous vertex data
+    int count = 0;
+    offset = 0;
 
-    // Link vertex attributes
-    glBindVertexArray(cubeVAO);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void *)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void *)(3*sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void *)(6*sizeof(float)));
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    for (int i = 0; i < drawsCounter; i++)
+    {
+        if (draws[i].vertexCount == 0) continue;
 
-    // Draw cube
-    glBindVertexArray(cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+        if (reorder)
+        {
+            memcpy(sortVertices + offset, quads.vertices + draws[i].vertexOffset, sizeof(DynamicVertex)*draws[i].vertexCount);
+            draws[i].vertexOffset = offset;
+            offset += draws[i].vertexCount;
+        }
 
-    glDeleteBuffers(1, &cubeVBO);
-    glDeleteVertexArrays(1, &cubeVAO);
+        if ((count > 0) && (draws[count - 1].textureId == draws[i].textureId) &&
+            ((draws[count - 1].vertexOffset + draws[count - 1].vertexCount) == draws[i].vertexOffset))
+        {
+            draws[count - 1].vertexCount += draws[i].vertexCount;
+        }
+        else draws[count++] = draws[i];
+    }
+
+    if (reorder) memcpy(quads.vertices, sortVertices, sizeof(DynamicVertex)*offset);
+
+    drawsCounter = (count > 0)? count : 1;
 }
 
-#if defined(SUPPORT_VR_SIMULATOR)
-// Configure stereo rendering (including distortion shader) with HMD device parameters
-// NOTE: It modifies the global variable: VrStereoConfig vrConfig
-static void SetStereoConfig(VrDeviceInfo hmd)
+// Compare draw calls sort keys: layer and texture (RL_SORT_STATE), recording order
+static int CompareDrawCalls(const void *a, const void *b)
 {
-    // Compute aspect ratio
-    float aspect = ((float)hmd.hResolution*0.5f)/(float)hmd.vResolution;
+    const DrawCall *drawA = (const DrawCall *)a;
+    const DrawCall *drawB = (const DrawCall *)b;
 
-    // Compute lens parameters
-    float lensShift = (hmd.hScreenSize*0.25f - hmd.lensSeparationDistance*0.5f)/hmd.hScreenSize;
-    float leftLensCenter[2] = { 0.25f + lensShift, 0.5f };
-    float rightLensCenter[2] = { 0.75f - lensShift, 0.5f };
-    float leftScreenCenter[2] = { 0.25f, 0.5f };
-    float rightScreenCenter[2] = { 0.75f, 0.5f };
+    if (drawA->layer != drawB->layer) return (drawA->layer < drawB->layer)? -1 : 1;
 
-    // Compute distortion scale parameters
-    // NOTE: To get lens max radius, lensShift must be normalized to [-1..1]
-    float lensRadius = (float)fabs(-1.0f - 4.0f*lensShift);
-    float lensRadiusSq = lensRadius*lensRadius;
-    float distortionScale = hmd.lensDistortionValues[0] +
-                            hmd.lensDistortionValues[1]*lensRadiusSq +
-                            hmd.lensDistortionValues[2]*lensRadiusSq*lensRadiusSq +
-                            hmd.lensDistortionValues[3]*lensRadiusSq*lensRadiusSq*lensRadiusSq;
+    if (drawSortMode == RL_SORT_STATE)
+    {
+        if (drawA->textureId != drawB->textureId) return (drawA->textureId < drawB->textureId)? -1 : 1;
+    }
 
-    TraceLog(LOG_DEBUG, "VR: Distortion Scale: %f", distortionScale);
+    return (drawA->vertexOffset < drawB->vertexOffset)? -1 : (drawA->vertexOffset > drawB->vertexOffset);
+}
 
-    float normScreenWidth = 0.5f;
-    float normScreenHeight = 1.0f;
-    float scaleIn[2] = { 2.0f/normScreenWidth, 2.0f/normScreenHeight/aspect };
-    float scale[2] = { normScreenWidth*0.5f/distortionScale, normScreenHeight*0.5f*aspect/distortionScale };
+// Grow default internal buffer capacity to fit vertex count (geometric growth)
+// NOTE: Current batch vertex data is kept, GPU vertex buffer is recreated with new capacity
+// (on streaming modes GPU could be reading old buffer, it's released by driver once not in use)
+static bool GrowBufferDefault(DynamicBuffer *buffer, int vertexCount)
+{
+    if (vertexCount <= buffer->vCapacity) return true;
+    if (vertexCount > MAX_BATCH_VERTEX) return false;
 
-    TraceLog(LOG_DEBUG, "VR: Distortion Shader: LeftLensCenter = { %f, %f }", leftLensCenter[0], leftLensCenter[1]);
-    TraceLog(LOG_DEBUG, "VR: Distortion Shader: RightLensCenter = { %f, %f }", rightLensCenter[0], rightLensCenter[1]);
-    TraceLog(LOG_DEBUG, "VR: Distortion Shader: Scale = { %f, %f }", scale[0], scale[1]);
-    TraceLog(LOG_DEBUG, "VR: Distortion Shader: ScaleIn = { %f, %f }", scaleIn[0], scaleIn[1]);
+    int capacity = buffer->vCapacity;
+    while (capacity < vertexCount) capacity *= 2;
+    if (capacity > MAX_BATCH_VERTEX) capacity = MAX_BATCH_VERTEX;
 
-#if defined(SUPPORT_DISTORTION_SHADER)
-    // Update distortion shader with lens and distortion-scale parameters
-    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "leftLensCenter"), leftLensCenter, 2);
-    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "rightLensCenter"), rightLensCenter, 2);
-    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "leftScreenCenter"), leftScreenCenter, 2);
-    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "rightScreenCenter"), rightScreenCenter, 2);
+    // Vertex data to keep (color could be defined before vertex)
+    int count = buffer->vCounter;
+    if (buffer->cCounter > count) count = buffer->cCounter;
+    if (buffer->tcCounter > count) count = buffer->tcCounter;
 
-    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "scale"), scale, 2);
-    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "scaleIn"), scaleIn, 2);
-    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "hmdWarpParam"), hmd.lensDistortionValues, 4);
-    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "chromaAbParam"), hmd.chromaAbCorrection, 4);
-#endif
+#if !defined(GRAPHICS_API_SOFTWARE)
+    unsigned int vboId = buffer->vboId[0];
 
-    // Fovy is normally computed with: 2*atan2(hmd.vScreenSize, 2*hmd.eyeToScreenDistance)
-    // ...but with lens distortion it is increased (see Oculus SDK Documentation)
-    //float fovy = 2.0f*atan2(hmd.vScreenSize*0.5f*distortionScale, hmd.eyeToScreenDistance);     // Really need distortionScale?
-    float fovy = 2.0f*(float)atan2(hmd.vScreenSize*0.5f, hmd.eyeToScreenDistance);
+    if (vaoSupported) glBindVertexArray(buffer->vaoId);
 
-    // Compute camera projection matrices
-    float projOffset = 4.0f*lensShift;      // Scaled to projection space coordinates [-1..1]
-    Matrix proj = MatrixPerspective(fovy, aspect, 0.01, 1000.0);
-    vrConfig.eyesProjection[0] = MatrixMultiply(proj, MatrixTranslate(projOffset, 0.0f, 0.0f));
-    vrConfig.eyesProjection[1] = MatrixMultiply(proj, MatrixTranslate(-projOffset, 0.0f, 0.0f));
+    if (streamMode == STREAM_MODE_PERSISTENT)
+    {
+        // Copy current batch vertex data from old mapped segment to new mapped segment
+        DynamicVertex *vertices = buffer->vertices;
+        void *mapped = buffer->mapped;
 
-    // Compute camera transformation matrices
-    // NOTE: Camera movement might seem more natural if we model the head.
-    // Our axis of rotation is the base of our head, so we might want to add
-    // some y (base of head to eye level) and -z (center of head to eye protrusion) to the camera positions.
-    vrConfig.eyesViewOffset[0] = MatrixTranslate(-hmd.interpupillaryDistance*0.5f, 0.075f, 0.045f);
-    vrConfig.eyesViewOffset[1] = MatrixTranslate(hmd.interpupillaryDistance*0.5f, 0.075f, 0.045f);
+        buffer->vboId[0] = LoadBufferSegments(sizeof(DynamicVertex)*capacity, NULL, &buffer->mapped);
 
-    // Compute eyes Viewports
-    vrConfig.eyesViewport[0] = (Rectangle){ 0.0f, 0.0f, (float)hmd.hResolution/2, (float)hmd.vResolution };
-    vrConfig.eyesViewport[1] = (Rectangle){ hmd.hResolution/2.0f, 0.0f, (float)hmd.hResolution/2, (float) hmd.vResolution };
+        if (buffer->mapped == NULL)
+        {
+            TraceLog(LOG_WARNING, "[VBO ID %i] Default buffer could not grow (%i vertex)", vboId, capacity);
+            glDeleteBuffers(1, &buffer->vboId[0]);
+            buffer->vboId[0] = vboId;
+            buffer->mapped = mapped;
+            if (vaoSupported) glBindVertexArray(0);
+            ResetStateCache();
+            return false;
+        }
+
+        buffer->vertices = (DynamicVertex *)buffer->mapped + capacity*streamSegment;
+        memcpy(buffer->vertices, vertices, sizeof(DynamicVertex)*count);
+    }
+    else
+#endif
+    {
+        DynamicVertex *vertices = (DynamicVertex *)realloc(buffer->vertices, sizeof(DynamicVertex)*capacity);
+
+        if (vertices == NULL)
+        {
+            TraceLog(LOG_WARNING, "Default buffer could not grow (%i vertex)", capacity);
+#if !defined(GRAPHICS_API_SOFTWARE)
+            if (vaoSupported) glBindVertexArray(0);
+            ResetStateCache();
+#endif
+            return false;
+        }
+
+        memset(vertices + buffer->vCapacity, 0, sizeof(DynamicVertex)*(capacity - buffer->vCapacity));
+        buffer->vertices = vertices;
+#if !defined(GRAPHICS_API_SOFTWARE)
+        buffer->vboId[0] = LoadBufferSegments(sizeof(DynamicVertex)*capacity, buffer->vertices, &buffer->mapped);
+#endif
+    }
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+    glDeleteBuffers(1, &vboId);     // Old vertex buffer (unmapped on deletion)
+
+    if (vaoSupported) SetVertexAttribsDefault(buffer->vboId[0]);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+
+    // Quads indices are static, extended to new capacity
+    if (buffer->indices != NULL)
+    {
+        int quadsCount = capacity/4;
+        int k = buffer->vCapacity/4;
+
+    #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_SOFTWARE)
+        buffer->indices = (unsigned int *)realloc(buffer->indices, sizeof(unsigned int)*6*quadsCount);
+    #elif defined(GRAPHICS_API_OPENGL_ES2)
+        buffer->indices = (unsigned short *)realloc(buffer->indices, sizeof(unsigned short)*6*quadsCount);
+    #endif
+
+        for (int i = 6*k; i < (6*quadsCount); i+=6)
+        {
+            buffer->indices[i] = 4*k;
+            buffer->indices[i+1] = 4*k+1;
+            buffer->indices[i+2] = 4*k+2;
+            buffer->indices[i+3] = 4*k;
+            buffer->indices[i+4] = 4*k+2;
+            buffer->indices[i+5] = 4*k+3;
+
+            k++;
+        }
+
+    #if !defined(GRAPHICS_API_SOFTWARE)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer->vboId[1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(buffer->indices[0])*6*quadsCount, buffer->indices, GL_STATIC_DRAW);
+        if (!vaoSupported) glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    #endif
+    }
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+    if (vaoSupported) glBindVertexArray(0);
+    ResetStateCache();          // Bindings changed out of state cache
+#endif
+
+    TraceLog(LOG_INFO, "[VBO ID %i] Default buffer grown: %i -> %i vertex", buffer->vboId[0], buffer->vCapacity, capacity);
+
+    buffer->vCapacity = capacity;
+
+    return true;
+}
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+// Load vertex buffer for default buffers data
+// NOTE: On streaming modes buffer contains DEFAULT_BUFFERS_SEGMENTS segments (ring buffer),
+// on persistent mode buffer is mapped once and mapped memory is returned
+static unsigned int LoadBufferSegments(int segmentSize, const void *data, void **mapped)
+{
+    unsigned int vboId = 0;
+
+    glGenBuffers(1, &vboId);
+    glBindBuffer(GL_ARRAY_BUFFER, vboId);
+
+    *mapped = NULL;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (streamMode == STREAM_MODE_PERSISTENT)
+    {
+        // NOTE: Read access is required, rlEnd() copies previous vertex colors/texcoords
+        GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage(GL_ARRAY_BUFFER, segmentSize*DEFAULT_BUFFERS_SEGMENTS, NULL, flags);
+        *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, segmentSize*DEFAULT_BUFFERS_SEGMENTS, flags);
+
+        // Unused vertex data (lines/triangles texcoords) is never written, initialized to 0
+        if (*mapped != NULL) memset(*mapped, 0, segmentSize*DEFAULT_BUFFERS_SEGMENTS);
+
+        return vboId;
+    }
+    else if (streamMode == STREAM_MODE_UNSYNCHRONIZED)
+    {
+        glBufferData(GL_ARRAY_BUFFER, segmentSize*DEFAULT_BUFFERS_SEGMENTS, NULL, GL_STREAM_DRAW);
+        return vboId;
+    }
+#endif
+
+    glBufferData(GL_ARRAY_BUFFER, segmentSize, data, GL_DYNAMIC_DRAW);
+
+    return vboId;
+}
+
+// Update vertex buffer current segment with vertex data
+// NOTE: Unsynchronized mapping does not wait for GPU, segment is not in use (checked with fences)
+static void UpdateBufferSegment(unsigned int vboId, int segmentSize, int size, const void *data)
+{
+    SetBuffer(GL_ARRAY_BUFFER, vboId);
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (streamMode == STREAM_MODE_UNSYNCHRONIZED)
+    {
+        void *buffer = glMapBufferRange(GL_ARRAY_BUFFER, segmentSize*streamSegment, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+        if (buffer != NULL)
+        {
+            memcpy(buffer, data, size);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+
+        return;
+    }
+#endif
+
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);    // target - offset (in bytes) - size (in bytes) - data pointer
+}
+
+#endif  // !defined(GRAPHICS_API_SOFTWARE)
+
+// Set default buffers current segment
+// NOTE: Segment just drawn gets a fence, new segment fence is waited (GPU finished reading it),
+// on persistent mode vertex arrays point to new segment mapped memory
+static void SetBuffersDefaultSegment(int segment)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (segment != streamSegment) streamFences[streamSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    if (streamFences[segment] != NULL)
+    {
+        while (glClientWaitSync(streamFences[segment], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) { }
+
+        glDeleteSync(streamFences[segment]);
+        streamFences[segment] = NULL;
+    }
+#endif
+
+    streamSegment = segment;
+
+    if (streamMode == STREAM_MODE_PERSISTENT)
+    {
+        lines.vertices = (DynamicVertex *)lines.mapped + lines.vCapacity*segment;
+        triangles.vertices = (DynamicVertex *)triangles.mapped + triangles.vCapacity*segment;
+        quads.vertices = (DynamicVertex *)quads.mapped + quads.vCapacity*segment;
+    }
+}
+
+#if defined(GRAPHICS_API_OPENGL_33)
+// Get free readback buffer with required size
+// NOTE: If all readback buffers are in flight, oldest readback is completed (waits for GPU)
+static ReadbackBuffer *GetReadbackBuffer(unsigned int size)
+{
+    ReadbackBuffer *readback = NULL;
+
+    for (int i = 0; i < READBACK_BUFFERS; i++)
+    {
+        if (!readbacks[i].pending)
+        {
+            readback = &readbacks[i];
+            break;
+        }
+    }
+
+    if (readback == NULL)
+    {
+        readback = GetOldestReadback();
+        CompleteReadback(readback);
+    }
+
+    if (readback->pboId == 0) glGenBuffers(1, &readback->pboId);
+
+    if (readback->size < size)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pboId);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        readback->size = size;
+    }
+
+    return readback;
+}
+
+// Get oldest pending readback (NULL if none)
+static ReadbackBuffer *GetOldestReadback(void)
+{
+    ReadbackBuffer *oldest = NULL;
+
+    for (int i = 0; i < READBACK_BUFFERS; i++)
+    {
+        if (readbacks[i].pending && ((oldest == NULL) || (readbacks[i].sequence < oldest->sequence))) oldest = &readbacks[i];
+    }
+
+    return oldest;
+}
+
+// Fence read pixels (already issued into readback buffer) and set readback pending
+static void SubmitReadback(ReadbackBuffer *readback, int width, int height, int stride, ReadbackCallback callback, void *userData)
+{
+    readback->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback->pending = true;
+    readback->frame = readbackFrame;
+    readback->sequence = readbackSequence++;
+    readback->width = width;
+    readback->height = height;
+    readback->stride = stride;
+    readback->callback = callback;
+    readback->userData = userData;
+}
+
+// Wait readback fence, map pixels and hand them to readback callback (no copy)
+// NOTE: Fence is usually signaled already (read issued frames ago), wait only happens if GPU is late
+static void CompleteReadback(ReadbackBuffer *readback)
+{
+    while (glClientWaitSync(readback->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) { }
+
+    glDeleteSync(readback->fence);
+    readback->fence = NULL;
+    readback->pending = false;
+
+    int rowSize = (readback->stride < 0)? -readback->stride : readback->stride;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pboId);
+    const unsigned char *pixels = (const unsigned char *)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, rowSize*readback->height, GL_MAP_READ_BIT);
+
+    if (pixels != NULL)
+    {
+        // Bottom-up rows: first row handed is the last one stored
+        if (readback->stride < 0) pixels += (readback->height - 1)*rowSize;
+
+        if (readback->callback != NULL) readback->callback(pixels, readback->width, readback->height, readback->stride, readback->userData);
+
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    else TraceLog(LOG_WARNING, "[PBO ID %i] Readback pixels could not be mapped", readback->pboId);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+#endif
+
+// Transform vertices by matrix, output is vertex position (texcoords and colors not modified)
+// NOTE: SSE version transforms every vertex as a 4 floats vector (matrix columns combination),
+// only 3 floats are stored (XY pair and Z)
+static void TransformVertices(const Vector3 *input, DynamicVertex *output, int count, Matrix mat)
+{
+#if defined(RLGL_SIMD_SSE)
+    __m128 col0 = _mm_setr_ps(mat.m0, mat.m1, mat.m2, 0.0f);
+    __m128 col1 = _mm_setr_ps(mat.m4, mat.m5, mat.m6, 0.0f);
+    __m128 col2 = _mm_setr_ps(mat.m8, mat.m9, mat.m10, 0.0f);
+    __m128 col3 = _mm_setr_ps(mat.m12, mat.m13, mat.m14, 0.0f);
+
+    for (int i = 0; i < count; i++)
+    {
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, _mm_set1_ps(input[i].x)), _mm_mul_ps(col1, _mm_set1_ps(input[i].y))),
+                                   _mm_add_ps(_mm_mul_ps(col2, _mm_set1_ps(input[i].z)), col3));
+
+        _mm_storel_pi((__m64 *)output[i].position, result);
+        _mm_store_ss(&output[i].position[2], _mm_movehl_ps(result, result));
+    }
+#else
+    for (int i = 0; i < count; i++)
+    {
+        Vector3 result = Vector3Transform(input[i], mat);
+
+        output[i].position[0] = result.x;
+        output[i].position[1] = result.y;
+        output[i].position[2] = result.z;
+    }
+#endif
+}
+
+// Transform temp buffer vertices by matrix stack transform into current draw mode buffer
+// NOTE: Transformed vertices are written directly into dynamic buffer vertex array (no per-vertex
+// rlVertex3f() call), vertex colors and texcoords were already written by rlColor*() and rlTexCoord*()
+static void TransformTempBuffer(void)
+{
+    DynamicBuffer *buffer = NULL;
+
+    switch (currentDrawMode)
+    {
+        case RL_LINES: buffer = &lines; break;
+        case RL_TRIANGLES: buffer = &triangles; break;
+        case RL_QUADS: buffer = &quads; break;
+        default: break;
+    }
+
+    if (buffer != NULL)
+    {
+        int count = tempBufferCount;
+
+        if (!GrowBufferDefault(buffer, buffer->vCounter + count))
+        {
+            count = buffer->vCapacity - buffer->vCounter;
+            TraceLog(LOG_ERROR, "Vertex batch overflow (%i vertex discarded)", tempBufferCount - count);
+        }
+
+        // NOTE: transformMatrix is already transposed because transposing has been applied
+        // independently to translation-scale-rotation matrices -> t(M1 x M2) = t(M2) x t(M1)
+        // This way, rlTranslatef(), rlRotatef()... behaviour is the same than OpenGL 1.1
+        TransformVertices(tempBuffer, buffer->vertices + buffer->vCounter, count, transformMatrix);
+
+        buffer->vCounter += count;
+
+        if (currentDrawMode == RL_QUADS) draws[drawsCounter - 1].vertexCount += count;
+    }
+
+    tempBufferCount = 0;
+}
+
+// Get current matrix to be transformed by matrix functions (rlTranslatef(), rlRotatef()...)
+// NOTE: When calling thread is recording into a command buffer, its transform is used
+static Matrix *GetCurrentMatrix(void)
+{
+    if (currentCommandBuffer == NULL) return currentMatrix;
+
+    currentCommandBuffer->transformRequired = true;
+
+    return &currentCommandBuffer->transform;
+}
+
+// Grow command buffer vertex data capacity to fit vertex count (geometric growth)
+static bool GrowCommandBuffer(CommandBuffer *buffer, int vertexCount)
+{
+    if (vertexCount <= buffer->vertexCapacity) return true;
+
+    int capacity = buffer->vertexCapacity;
+    while (capacity < vertexCount) capacity *= 2;
+
+    DynamicVertex *vertices = (DynamicVertex *)realloc(buffer->vertices, sizeof(DynamicVertex)*capacity);
+
+    if (vertices == NULL)
+    {
+        TraceLog(LOG_WARNING, "Command buffer could not grow (%i vertex)", capacity);
+        return false;
+    }
+
+    buffer->vertices = vertices;
+    buffer->vertexCapacity = capacity;
+
+    return true;
+}
+
+// Record one vertex into command buffer with current texture coordinates and color
+// NOTE: Consecutive vertex sharing primitive type, texture and depth mode are recorded in the same command
+static void RecordVertex(CommandBuffer *buffer, int mode, Vector3 position, bool relativeDepth)
+{
+    if ((mode != RL_LINES) && (mode != RL_TRIANGLES) && (mode != RL_QUADS)) return;
+
+    if (!GrowCommandBuffer(buffer, buffer->vertexCount + 1))
+    {
+        TraceLog(LOG_ERROR, "Command buffer overflow (vertex discarded)");
+        return;
+    }
+
+    RecordCommand *command = (buffer->commandsCount > 0)? &buffer->commands[buffer->commandsCount - 1] : NULL;
+
+    if ((command == NULL) || (command->mode != mode) || (command->relativeDepth != relativeDepth) ||
+        ((mode == RL_QUADS) && (command->textureId != buffer->textureId)))
+    {
+        if (buffer->commandsCount >= buffer->commandsCapacity)
+        {
+            RecordCommand *commands = (RecordCommand *)realloc(buffer->commands, sizeof(RecordCommand)*2*buffer->commandsCapacity);
+
+            if (commands == NULL)
+            {
+                TraceLog(LOG_ERROR, "Command buffer overflow (vertex discarded)");
+                return;
+            }
+
+            buffer->commands = commands;
+            buffer->commandsCapacity *= 2;
+        }
+
+        command = &buffer->commands[buffer->commandsCount];
+        command->mode = mode;
+        command->textureId = (mode == RL_QUADS)? buffer->textureId : 0;
+        command->relativeDepth = relativeDepth;
+        command->vertexOffset = buffer->vertexCount;
+        command->vertexCount = 0;
+
+        buffer->commandsCount++;
+    }
+
+    DynamicVertex *vertex = &buffer->vertices[buffer->vertexCount];
+
+    vertex->position[0] = position.x;
+    vertex->position[1] = position.y;
+    vertex->position[2] = position.z;
+    vertex->texcoord[0] = (mode == RL_QUADS)? buffer->texcoord[0] : 0.0f;
+    vertex->texcoord[1] = (mode == RL_QUADS)? buffer->texcoord[1] : 0.0f;
+    vertex->color[0] = buffer->color[0];
+    vertex->color[1] = buffer->color[1];
+    vertex->color[2] = buffer->color[2];
+    vertex->color[3] = buffer->color[3];
+
+    buffer->vertexCount++;
+    command->vertexCount++;
+}
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+// Set default buffers vertex attributes for interleaved vertex data: position, texcoord and color
+// NOTE: Vertex buffer is bound, attributes are stored in VAO if bound
+static void SetVertexAttribsDefault(unsigned int vboId)
+{
+    SetBuffer(GL_ARRAY_BUFFER, vboId);
+
+    // Vertex position (shader-location = 0)
+    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, sizeof(DynamicVertex), (void *)offsetof(DynamicVertex, position));
+    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
+
+    // Vertex texcoord (shader-location = 1)
+    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, sizeof(DynamicVertex), (void *)offsetof(DynamicVertex, texcoord));
+    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_TEXCOORD01]);
+
+    // Vertex color (shader-location = 3)
+    glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DynamicVertex), (void *)offsetof(DynamicVertex, color));
+    glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
+}
+
+// Set current shader program, uniform values cache is selected for the program
+static void SetProgram(unsigned int id)
+{
+    if (state.program == id)
+    {
+        stats.stateFiltered++;
+        return;
+    }
+
+    glUseProgram(id);
+    state.program = id;
+    stats.shaderSwitches++;
+
+    // Select program uniforms cache (replacing older one if required)
+    state.currentUniforms = NULL;
+
+    if (id == 0) return;
+
+    for (int i = 0; i < STATE_UNIFORM_PROGRAMS; i++)
+    {
+        if (state.uniforms[i].programId == id)
+        {
+            state.currentUniforms = &state.uniforms[i];
+            return;
+        }
+    }
+
+    state.currentUniforms = &state.uniforms[state.nextUniforms];
+    state.nextUniforms = (state.nextUniforms + 1)%STATE_UNIFORM_PROGRAMS;
+
+    memset(state.currentUniforms, 0, sizeof(UniformCache));
+    state.currentUniforms->programId = id;
+}
+
+#endif  // !defined(GRAPHICS_API_SOFTWARE)
+
+// Set active texture unit
+static void SetActiveTexture(int unit)
+{
+    if (state.activeTexture == unit)
+    {
+        stats.stateFiltered++;
+        return;
+    }
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+    glActiveTexture(GL_TEXTURE0 + unit);
+#endif
+    state.activeTexture = unit;
+}
+
+// Bind 2D texture to texture unit (active texture unit only changed if texture binding changes)
+static void SetTexture(int unit, unsigned int id)
+{
+    if ((unit < STATE_TEXTURE_UNITS) && (state.textures[unit] == id))
+    {
+        stats.stateFiltered++;
+        return;
+    }
+
+    SetActiveTexture(unit);
+#if !defined(GRAPHICS_API_SOFTWARE)
+    glBindTexture(GL_TEXTURE_2D, id);
+#endif
+    if (unit < STATE_TEXTURE_UNITS) state.textures[unit] = id;
+    stats.textureBinds++;
+}
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+// Bind VAO, index buffer binding is VAO state
+static void SetVertexArray(unsigned int id)
+{
+    if (state.vertexArray == id)
+    {
+        stats.stateFiltered++;
+        return;
+    }
+
+    glBindVertexArray(id);
+    state.vertexArray = id;
+    state.elementBuffer = STATE_UNKNOWN;
+}
+
+// Bind vertex buffer (GL_ARRAY_BUFFER) or index buffer (GL_ELEMENT_ARRAY_BUFFER)
+static void SetBuffer(GLenum target, unsigned int id)
+{
+    unsigned int *current = (target == GL_ARRAY_BUFFER)? &state.arrayBuffer : &state.elementBuffer;
+
+    if (*current == id)
+    {
+        stats.stateFiltered++;
+        return;
+    }
+
+    glBindBuffer(target, id);
+    *current = id;
+}
+
+#endif  // !defined(GRAPHICS_API_SOFTWARE)
+
+// Enable/disable OpenGL capability, only GL_BLEND, GL_DEPTH_TEST and GL_CULL_FACE are tracked
+static void SetCapability(GLenum cap, bool enabled)
+{
+    int *current = NULL;
+
+    switch (cap)
+    {
+        case GL_BLEND: current = &state.blend; break;
+        case GL_DEPTH_TEST: current = &state.depthTest; break;
+        case GL_CULL_FACE: current = &state.cullFace; break;
+        default: break;
+    }
+
+    if ((current != NULL) && (*current == (int)enabled))
+    {
+        stats.stateFiltered++;
+        return;
+    }
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+    if (enabled) glEnable(cap);
+    else glDisable(cap);
+#endif
+
+    if (current != NULL) *current = (int)enabled;
+}
+
+// Set blending function
+static void SetBlendFunc(GLenum src, GLenum dst)
+{
+    if ((state.blendSrc == src) && (state.blendDst == dst))
+    {
+        stats.stateFiltered++;
+        return;
+    }
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+    glBlendFunc(src, dst);
+#endif
+    state.blendSrc = src;
+    state.blendDst = dst;
+}
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+// Check uniform value against current program uniforms cache, cached value is updated
+// NOTE: Returns true if value is already set (redundant upload), size is the number of 32 bit words
+static bool CheckUniformCache(int location, const void *value, int size)
+{
+    UniformCache *cache = state.currentUniforms;
+
+    if ((cache == NULL) || (location < 0) || (location >= STATE_UNIFORM_LOCATIONS)) return false;
+
+    if (size > 16)
+    {
+        cache->size[location] = 0;
+        return false;
+    }
+
+    if ((cache->size[location] == size) && (memcmp(cache->value[location], value, sizeof(unsigned int)*size) == 0))
+    {
+        stats.stateFiltered++;
+        return true;
+    }
+
+    memcpy(cache->value[location], value, sizeof(unsigned int)*size);
+    cache->size[location] = (unsigned char)size;
+
+    return false;
+}
+
+// Invalidate current program cached uniform values (i.e. uniform arrays, one location per element)
+static void InvalidateUniforms(int location, int count)
+{
+    if (state.currentUniforms == NULL) return;
+
+    for (int i = location; i < location + count; i++)
+    {
+        if ((i >= 0) && (i < STATE_UNIFORM_LOCATIONS)) state.currentUniforms->size[i] = 0;
+    }
+}
+
+// Set current program uniform value: mat4
+static void SetUniformMatrix(int location, Matrix mat)
+{
+    if (location < 0) return;
+
+    float *value = MatrixToFloat(mat);
+
+    if (!CheckUniformCache(location, value, 16)) glUniformMatrix4fv(location, 1, false, value);
+}
+
+// Set current program uniform value: vec4
+static void SetUniform4f(int location, float x, float y, float z, float w)
+{
+    if (location < 0) return;
+
+    float value[4] = { x, y, z, w };
+
+    if (!CheckUniformCache(location, value, 4)) glUniform4f(location, x, y, z, w);
+}
+
+// Set current program uniform value: int (sampler)
+static void SetUniform1i(int location, int value)
+{
+    if (location < 0) return;
+
+    if (!CheckUniformCache(location, &value, 1)) glUniform1i(location, value);
+}
+
+// Renders a 1x1 XY quad in NDC
+static void GenDrawQuad(void)
+{
+    unsigned int quadVAO = 0;
+    unsigned int quadVBO = 0;
+
+    float vertices[] = {
+        // Positions        // Texture Coords
+        -1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+        1.0f, 1.0f, 0.0f, 1.0f, 1.0f,
+        1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+    };
+
+    // Set up plane VAO
+    glGenVertexArrays(1, &quadVAO);
+    glGenBuffers(1, &quadVBO);
+    glBindVertexArray(quadVAO);
+
+    // Fill buffer
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
+
+    // Link vertex attributes
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void *)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void *)(3*sizeof(float)));
+
+    // Draw quad
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+
+    glDeleteBuffers(1, &quadVBO);
+    glDeleteVertexArrays(1, &quadVAO);
+}
+
+// Renders a 1x1 3D cube in NDC
+static void GenDrawCube(void)
+{
+    unsigned int cubeVAO = 0;
+    unsigned int cubeVBO = 0;
+
+    float vertices[] = {
+        -1.0f, -1.0f, -1.0f,  0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
+        1.0f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
+        1.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f,
+        1.0f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
+        -1.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
+        -1.0f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+        1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f,
+        1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
+        1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
+        -1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+        -1.0f, 1.0f, 1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+        -1.0f, 1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
+        -1.0f, -1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, 1.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+        -1.0f, 1.0f, 1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+        1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+        1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+        1.0f, 1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
+        1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+        1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+        1.0f, -1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+        -1.0f, -1.0f, -1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f,
+        1.0f, -1.0f, -1.0f, 0.0f, -1.0f, 0.0f, 1.0f, 1.0f,
+        1.0f, -1.0f, 1.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+        1.0f, -1.0f, 1.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+        -1.0f, -1.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+        -1.0f, -1.0f, -1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f,
+        -1.0f, 1.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+        1.0f, 1.0f , 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f,
+        1.0f, 1.0f, -1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
+        1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f,
+        -1.0f, 1.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+        -1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f
+    };
+
+    // Set up cube VAO
+    glGenVertexArrays(1, &cubeVAO);
+    glGenBuffers(1, &cubeVBO);
+
+    // Fill buffer
+    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    // Link vertex attributes
+    glBindVertexArray(cubeVAO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void *)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void *)(3*sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void *)(6*sizeof(float)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // Draw cube
+    glBindVertexArray(cubeVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 36);
+    glBindVertexArray(0);
+
+    glDeleteBuffers(1, &cubeVBO);
+    glDeleteVertexArrays(1, &cubeVAO);
+}
+
+#if defined(SUPPORT_VR_SIMULATOR)
+// Configure stereo rendering (including distortion shader) with HMD device parameters
+// NOTE: It modifies the global variable: VrStereoConfig vrConfig
+static void SetStereoConfig(VrDeviceInfo hmd)
+{
+    // Compute aspect ratio
+    float aspect = ((float)hmd.hResolution*0.5f)/(float)hmd.vResolution;
+
+    // Compute lens parameters
+    float lensShift = (hmd.hScreenSize*0.25f - hmd.lensSeparationDistance*0.5f)/hmd.hScreenSize;
+    float leftLensCenter[2] = { 0.25f + lensShift, 0.5f };
+    float rightLensCenter[2] = { 0.75f - lensShift, 0.5f };
+    float leftScreenCenter[2] = { 0.25f, 0.5f };
+    float rightScreenCenter[2] = { 0.75f, 0.5f };
+
+    // Compute distortion scale parameters
+    // NOTE: To get lens max radius, lensShift must be normalized to [-1..1]
+    float lensRadius = (float)fabs(-1.0f - 4.0f*lensShift);
+    float lensRadiusSq = lensRadius*lensRadius;
+    float distortionScale = hmd.lensDistortionValues[0] +
+                            hmd.lensDistortionValues[1]*lensRadiusSq +
+                            hmd.lensDistortionValues[2]*lensRadiusSq*lensRadiusSq +
+                            hmd.lensDistortionValues[3]*lensRadiusSq*lensRadiusSq*lensRadiusSq;
+
+    TraceLog(LOG_DEBUG, "VR: Distortion Scale: %f", distortionScale);
+
+    float normScreenWidth = 0.5f;
+    float normScreenHeight = 1.0f;
+    float scaleIn[2] = { 2.0f/normScreenWidth, 2.0f/normScreenHeight/aspect };
+    float scale[2] = { normScreenWidth*0.5f/distortionScale, normScreenHeight*0.5f*aspect/distortionScale };
+
+    TraceLog(LOG_DEBUG, "VR: Distortion Shader: LeftLensCenter = { %f, %f }", leftLensCenter[0], leftLensCenter[1]);
+    TraceLog(LOG_DEBUG, "VR: Distortion Shader: RightLensCenter = { %f, %f }", rightLensCenter[0], rightLensCenter[1]);
+    TraceLog(LOG_DEBUG, "VR: Distortion Shader: Scale = { %f, %f }", scale[0], scale[1]);
+    TraceLog(LOG_DEBUG, "VR: Distortion Shader: ScaleIn = { %f, %f }", scaleIn[0], scaleIn[1]);
+
+#if defined(SUPPORT_DISTORTION_SHADER)
+    // Update distortion shader with lens and distortion-scale parameters
+    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "leftLensCenter"), leftLensCenter, 2);
+    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "rightLensCenter"), rightLensCenter, 2);
+    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "leftScreenCenter"), leftScreenCenter, 2);
+    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "rightScreenCenter"), rightScreenCenter, 2);
+
+    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "scale"), scale, 2);
+    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "scaleIn"), scaleIn, 2);
+    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "hmdWarpParam"), hmd.lensDistortionValues, 4);
+    SetShaderValue(vrConfig.distortionShader, GetShaderLocation(vrConfig.distortionShader, "chromaAbParam"), hmd.chromaAbCorrection, 4);
+#endif
+
+    // Fovy is normally computed with: 2*atan2(hmd.vScreenSize, 2*hmd.eyeToScreenDistance)
+    // ...but with lens distortion it is increased (see Oculus SDK Documentation)
+    //float fovy = 2.0f*atan2(hmd.vScreenSize*0.5f*distortionScale, hmd.eyeToScreenDistance);     // Really need distortionScale?
+    float fovy = 2.0f*(float)atan2(hmd.vScreenSize*0.5f, hmd.eyeToScreenDistance);
+
+    // Compute camera projection matrices
+    float projOffset = 4.0f*lensShift;      // Scaled to projection space coordinates [-1..1]
+    Matrix proj = MatrixPerspective(fovy, aspect, 0.01, 1000.0);
+    vrConfig.eyesProjection[0] = MatrixMultiply(proj, MatrixTranslate(projOffset, 0.0f, 0.0f));
+    vrConfig.eyesProjection[1] = MatrixMultiply(proj, MatrixTranslate(-projOffset, 0.0f, 0.0f));
+
+    // Compute camera transformation matrices
+    // NOTE: Camera movement might seem more natural if we model the head.
+    // Our axis of rotation is the base of our head, so we might want to add
+    // some y (base of head to eye level) and -z (center of head to eye protrusion) to the camera positions.
+    vrConfig.eyesViewOffset[0] = MatrixTranslate(-hmd.interpupillaryDistance*0.5f, 0.075f, 0.045f);
+    vrConfig.eyesViewOffset[1] = MatrixTranslate(hmd.interpupillaryDistance*0.5f, 0.075f, 0.045f);
+
+    // Compute eyes Viewports
+    vrConfig.eyesViewport[0] = (Rectangle){ 0.0f, 0.0f, (float)hmd.hResolution/2, (float)hmd.vResolution };
+    vrConfig.eyesViewport[1] = (Rectangle){ hmd.hResolution/2.0f, 0.0f, (float)hmd.hResolution/2, (float) hmd.vResolution };
+}
+
+// Set internal projection and modelview matrix depending on eyes tracking data
+static void SetStereoView(int eye, Matrix matProjection, Matrix matModelView)
+{
+    Matrix eyeProjection = matProjection;
+    Matrix eyeModelView = matModelView;
+
+    // Setup viewport and projection/modelview matrices using tracking data
+    rlViewport(eye*screenWidth/2, 0, screenWidth/2, screenHeight);
+
+    // Apply view offset to modelview matrix
+    eyeModelView = MatrixMultiply(matModelView, vrConfig.eyesViewOffset[eye]);
+
+    // Set current eye projection matrix
+    eyeProjection = vrConfig.eyesProjection[eye];
+
+    SetMatrixModelview(eyeModelView);
+    SetMatrixProjection(eyeProjection);
+}
+#endif      // defined(SUPPORT_VR_SIMULATOR)
+
+#endif  // !defined(GRAPHICS_API_SOFTWARE)
+#endif //defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_SOFTWARE)
+
+// Reset OpenGL state cache bindings and capabilities, next state changes are not filtered
+// NOTE: Called after resources loading/unloading, bindings are changed without state cache
+static void ResetStateCache(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    state.program = STATE_UNKNOWN;
+    state.currentUniforms = NULL;
+    state.activeTexture = -1;
+    for (int i = 0; i < STATE_TEXTURE_UNITS; i++) state.textures[i] = STATE_UNKNOWN;
+    state.vertexArray = STATE_UNKNOWN;
+    state.arrayBuffer = STATE_UNKNOWN;
+    state.elementBuffer = STATE_UNKNOWN;
+    state.blend = -1;
+    state.depthTest = -1;
+    state.cullFace = -1;
+    state.blendSrc = STATE_UNKNOWN;
+    state.blendDst = STATE_UNKNOWN;
+#endif
+}
+
+#if !defined(GRAPHICS_API_SOFTWARE)
+// Get OpenGL internal formats and data type from raylib PixelFormat
+static void GetGlFormats(int format, int *glInternalFormat, int *glFormat, int *glType)
+{
+    *glInternalFormat = -1;
+    *glFormat = -1;
+    *glType = -1;
+
+    switch (format)
+    {
+    #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_21) || defined(GRAPHICS_API_OPENGL_ES2)
+        // NOTE: on OpenGL ES 2.0 (WebGL), internalFormat must match format and options allowed are: GL_LUMINANCE, GL_RGB, GL_RGBA
+        case UNCOMPRESSED_GRAYSCALE: *glInternalFormat = GL_LUMINANCE; *glFormat = GL_LUMINANCE; *glType = GL_UNSIGNED_BYTE; break;
+        case UNCOMPRESSED_GRAY_ALPHA: *glInternalFormat = GL_LUMINANCE_ALPHA; *glFormat = GL_LUMINANCE_ALPHA; *glType = GL_UNSIGNED_BYTE; break;
+        case UNCOMPRESSED_R5G6B5: *glInternalFormat = GL_RGB; *glFormat = GL_RGB; *glType = GL_UNSIGNED_SHORT_5_6_5; break;
+        case UNCOMPRESSED_R8G8B8: *glInternalFormat = GL_RGB; *glFormat = GL_RGB; *glType = GL_UNSIGNED_BYTE; break;
+        case UNCOMPRESSED_R5G5B5A1: *glInternalFormat = GL_RGBA; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_SHORT_5_5_5_1; break;
+        case UNCOMPRESSED_R4G4B4A4: *glInternalFormat = GL_RGBA; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_SHORT_4_4_4_4; break;
+        case UNCOMPRESSED_R8G8B8A8: *glInternalFormat = GL_RGBA; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_BYTE; break;
+        #if !defined(GRAPHICS_API_OPENGL_11)
+        case UNCOMPRESSED_R32: if (texFloatSupported) *glInternalFormat = GL_LUMINANCE; *glFormat = GL_LUMINANCE; *glType = GL_FLOAT; break;   // NOTE: Requires extension OES_texture_float
+        case UNCOMPRESSED_R32G32B32: if (texFloatSupported) *glInternalFormat = GL_RGB; *glFormat = GL_RGB; *glType = GL_FLOAT; break;         // NOTE: Requires extension OES_texture_float
+        case UNCOMPRESSED_R32G32B32A32: if (texFloatSupported) *glInternalFormat = GL_RGBA; *glFormat = GL_RGBA; *glType = GL_FLOAT; break;    // NOTE: Requires extension OES_texture_float
+        #endif
+    #elif defined(GRAPHICS_API_OPENGL_33)
+        case UNCOMPRESSED_GRAYSCALE: *glInternalFormat = GL_R8; *glFormat = GL_RED; *glType = GL_UNSIGNED_BYTE; break;
+        case UNCOMPRESSED_GRAY_ALPHA: *glInternalFormat = GL_RG8; *glFormat = GL_RG; *glType = GL_UNSIGNED_BYTE; break;
+        case UNCOMPRESSED_R5G6B5: *glInternalFormat = GL_RGB565; *glFormat = GL_RGB; *glType = GL_UNSIGNED_SHORT_5_6_5; break;
+        case UNCOMPRESSED_R8G8B8: *glInternalFormat = GL_RGB8; *glFormat = GL_RGB; *glType = GL_UNSIGNED_BYTE; break;
+        case UNCOMPRESSED_R5G5B5A1: *glInternalFormat = GL_RGB5_A1; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_SHORT_5_5_5_1; break;
+        case UNCOMPRESSED_R4G4B4A4: *glInternalFormat = GL_RGBA4; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_SHORT_4_4_4_4; break;
+        case UNCOMPRESSED_R8G8B8A8: *glInternalFormat = GL_RGBA8; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_BYTE; break;
+        case UNCOMPRESSED_R32: if (texFloatSupported) *glInternalFormat = GL_R32F; *glFormat = GL_RED; *glType = GL_FLOAT; break;
+        case UNCOMPRESSED_R32G32B32: if (texFloatSupported) *glInternalFormat = GL_RGB32F; *glFormat = GL_RGB; *glType = GL_FLOAT; break;
+        case UNCOMPRESSED_R32G32B32A32: if (texFloatSupported) *glInternalFormat = GL_RGBA32F; *glFormat = GL_RGBA; *glType = GL_FLOAT; break;
+    #endif
+        #if !defined(GRAPHICS_API_OPENGL_11)
+        case COMPRESSED_DXT1_RGB: if (texCompDXTSupported) *glInternalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+        case COMPRESSED_DXT1_RGBA: if (texCompDXTSupported) *glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+        case COMPRESSED_DXT3_RGBA: if (texCompDXTSupported) *glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; break;
+        case COMPRESSED_DXT5_RGBA: if (texCompDXTSupported) *glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+        case COMPRESSED_ETC1_RGB: if (texCompETC1Supported) *glInternalFormat = GL_ETC1_RGB8_OES; break;                      // NOTE: Requires OpenGL ES 2.0 or OpenGL 4.3
+        case COMPRESSED_ETC2_RGB: if (texCompETC2Supported) *glInternalFormat = GL_COMPRESSED_RGB8_ETC2; break;               // NOTE: Requires OpenGL ES 3.0 or OpenGL 4.3
+        case COMPRESSED_ETC2_EAC_RGBA: if (texCompETC2Supported) *glInternalFormat = GL_COMPRESSED_RGBA8_ETC2_EAC; break;     // NOTE: Requires OpenGL ES 3.0 or OpenGL 4.3
+        case COMPRESSED_PVRT_RGB: if (texCompPVRTSupported) *glInternalFormat = GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG; break;    // NOTE: Requires PowerVR GPU
+        case COMPRESSED_PVRT_RGBA: if (texCompPVRTSupported) *glInternalFormat = GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG; break;  // NOTE: Requires PowerVR GPU
+        case COMPRESSED_ASTC_4x4_RGBA: if (texCompASTCSupported) *glInternalFormat = GL_COMPRESSED_RGBA_ASTC_4x4_KHR; break;  // NOTE: Requires OpenGL ES 3.1 or OpenGL 4.3
+        case COMPRESSED_ASTC_8x8_RGBA: if (texCompASTCSupported) *glInternalFormat = GL_COMPRESSED_RGBA_ASTC_8x8_KHR; break;  // NOTE: Requires OpenGL ES 3.1 or OpenGL 4.3
+        #endif
+        default: TraceLog(LOG_WARNING, "Texture format not supported"); break;
+    }
+}
+#endif
+
+#if defined(GRAPHICS_API_OPENGL_11)
+// Mipmaps data is generated after image data
+// NOTE: Only works with RGBA (4 bytes) data!
+static int GenerateMipmaps(unsigned char *data, int baseWidth, int baseHeight)
+{
+    int mipmapCount = 1;                // Required mipmap levels count (including base level)
+    int width = baseWidth;
+    int height = baseHeight;
+    int size = baseWidth*baseHeight*4;  // Size in bytes (will include mipmaps...), RGBA only
+
+    // Count mipmap levels required
+    while ((width != 1) && (height != 1))
+    {
+        if (width != 1) width /= 2;
+        if (height != 1) height /= 2;
+
+        TraceLog(LOG_DEBUG, "Next mipmap size: %i x %i", width, height);
+
+        mipmapCount++;
+
+        size += (width*height*4);       // Add mipmap size (in bytes)
+    }
+
+    TraceLog(LOG_DEBUG, "Total mipmaps required: %i", mipmapCount);
+    TraceLog(LOG_DEBUG, "Total size of data required: %i", size);
+
+    unsigned char *temp = realloc(data, size);
+
+    if (temp != NULL) data = temp;
+    else TraceLog(LOG_WARNING, "Mipmaps required memory could not be allocated");
+
+    width = baseWidth;
+    height = baseHeight;
+    size = (width*height*4);
+
+    // Generate mipmaps
+    // NOTE: Every mipmap data is stored after data
+    Color *image = (Color *)malloc(width*height*sizeof(Color));
+    Color *mipmap = NULL;
+    int offset = 0;
+    int j = 0;
+
+    for (int i = 0; i < size; i += 4)
+    {
+        image[j].r = data[i];
+        image[j].g = data[i + 1];
+        image[j].b = data[i + 2];
+        image[j].a = data[i + 3];
+        j++;
+    }
+
+    TraceLog(LOG_DEBUG, "Mipmap base (%ix%i)", width, height);
+
+    for (int mip = 1; mip < mipmapCount; mip++)
+    {
+        mipmap = GenNextMipmap(image, width, height);
+
+        offset += (width*height*4); // Size of last mipmap
+        j = 0;
+
+        width /= 2;
+        height /= 2;
+        size = (width*height*4);    // Mipmap size to store after offset
+
+        // Add mipmap to data
+        for (int i = 0; i < size; i += 4)
+        {
+            data[offset + i] = mipmap[j].r;
+            data[offset + i + 1] = mipmap[j].g;
+            data[offset + i + 2] = mipmap[j].b;
+            data[offset + i + 3] = mipmap[j].a;
+            j++;
+        }
+
+        free(image);
+
+        image = mipmap;
+        mipmap = NULL;
+    }
+
+    free(mipmap);       // free mipmap data
+
+    return mipmapCount;
+}
+
+// Manual mipmap generation (basic scaling algorithm)
+static Color *GenNextMipmap(Color *srcData, int srcWidth, int srcHeight)
+{
+    int x2, y2;
+    Color prow, pcol;
+
+    int width = srcWidth/2;
+    int height = srcHeight/2;
+
+    Color *mipmap = (Color *)malloc(width*height*sizeof(Color));
+
+    // Scaling algorithm works perfectly (box-filter)
+    for (int y = 0; y < height; y++)
+    {
+        y2 = 2*y;
+
+        for (int x = 0; x < width; x++)
+        {
+            x2 = 2*x;
+
+            prow.r = (srcData[y2*srcWidth + x2].r + srcData[y2*srcWidth + x2 + 1].r)/2;
+            prow.g = (srcData[y2*srcWidth + x2].g + srcData[y2*srcWidth + x2 + 1].g)/2;
+            prow.b = (srcData[y2*srcWidth + x2].b + srcData[y2*srcWidth + x2 + 1].b)/2;
+            prow.a = (srcData[y2*srcWidth + x2].a + srcData[y2*srcWidth + x2 + 1].a)/2;
+
+            pcol.r = (srcData[(y2+1)*srcWidth + x2].r + srcData[(y2+1)*srcWidth + x2 + 1].r)/2;
+            pcol.g = (srcData[(y2+1)*srcWidth + x2].g + srcData[(y2+1)*srcWidth + x2 + 1].g)/2;
+            pcol.b = (srcData[(y2+1)*srcWidth + x2].b + srcData[(y2+1)*srcWidth + x2 + 1].b)/2;
+            pcol.a = (srcData[(y2+1)*srcWidth + x2].a + srcData[(y2+1)*srcWidth + x2 + 1].a)/2;
+
+            mipmap[y*width + x].r = (prow.r + pcol.r)/2;
+            mipmap[y*width + x].g = (prow.g + pcol.g)/2;
+            mipmap[y*width + x].b = (prow.b + pcol.b)/2;
+            mipmap[y*width + x].a = (prow.a + pcol.a)/2;
+        }
+    }
+
+    TraceLog(LOG_DEBUG, "Mipmap generated successfully (%ix%i)", width, height);
+
+    return mipmap;
+}
+#endif
+
+#if defined(GRAPHICS_API_SOFTWARE)
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition - Software rasterizer
+//----------------------------------------------------------------------------------
+
+// Init software rasterizer: framebuffer, tiles and worker threads
+// NOTE: Triangles are queued and binned into tiles, tiles are rasterized in parallel on resolve
+static void SwInit(int width, int height)
+{
+    sw.width = width;
+    sw.height = height;
+    sw.color = (Color *)malloc(width*height*sizeof(Color));
+    sw.depth = (float *)malloc(width*height*sizeof(float));
+
+    sw.viewport[0] = 0;
+    sw.viewport[1] = 0;
+    sw.viewport[2] = width;
+    sw.viewport[3] = height;
+
+    sw.triangles = (SwTriangle *)malloc(SW_MAX_TRIANGLES*sizeof(SwTriangle));
+    sw.trianglesCount = 0;
+
+    sw.tilesX = (width + SW_TILE_SIZE - 1)/SW_TILE_SIZE;
+    sw.tilesY = (height + SW_TILE_SIZE - 1)/SW_TILE_SIZE;
+    sw.tiles = (SwTile *)calloc(sw.tilesX*sw.tilesY, sizeof(SwTile));
+
+#if (RLGL_SW_THREADS > 1)
+    pthread_mutex_init(&sw.mutex, NULL);
+    pthread_cond_init(&sw.start, NULL);
+    pthread_cond_init(&sw.done, NULL);
+
+    // NOTE: Calling thread rasterizes tiles too (thread 0)
+    for (int i = 0; i < (RLGL_SW_THREADS - 1); i++) pthread_create(&sw.threads[i], NULL, SwWorkerThread, (void *)(size_t)(i + 1));
+#endif
+}
+
+// Close software rasterizer: worker threads, textures and framebuffer
+static void SwClose(void)
+{
+#if (RLGL_SW_THREADS > 1)
+    pthread_mutex_lock(&sw.mutex);
+    sw.quit = true;
+    pthread_cond_broadcast(&sw.start);
+    pthread_mutex_unlock(&sw.mutex);
+
+    for (int i = 0; i < (RLGL_SW_THREADS - 1); i++) pthread_join(sw.threads[i], NULL);
+
+    pthread_cond_destroy(&sw.done);
+    pthread_cond_destroy(&sw.start);
+    pthread_mutex_destroy(&sw.mutex);
+#endif
+
+    for (int i = 0; i < sw.texturesCount; i++) free(sw.textures[i].data);
+    for (int i = 0; i < sw.tilesX*sw.tilesY; i++) free(sw.tiles[i].triangles);
+
+    free(sw.textures);
+    free(sw.tiles);
+    free(sw.triangles);
+    free(sw.color);
+    free(sw.depth);
+
+    sw = (SwContext){ 0 };
+}
+
+// Clear framebuffer color and depth
+// NOTE: Queued triangles would be fully overwritten, they are discarded
+static void SwClear(void)
+{
+    for (int i = 0; i < sw.tilesX*sw.tilesY; i++) sw.tiles[i].count = 0;
+    sw.trianglesCount = 0;
+
+    for (int i = 0; i < sw.width*sw.height; i++)
+    {
+        sw.color[i] = sw.clearColor;
+        sw.depth[i] = 1.0f;
+    }
+}
+
+// Rasterize queued triangles into framebuffer
+// NOTE: Called when framebuffer or textures are read/modified and when triangles queue is full
+static void SwResolve(void)
+{
+    if (sw.trianglesCount == 0) return;
+
+#if (RLGL_SW_THREADS > 1)
+    pthread_mutex_lock(&sw.mutex);
+    sw.generation++;
+    sw.pending = RLGL_SW_THREADS - 1;
+    pthread_cond_broadcast(&sw.start);
+    pthread_mutex_unlock(&sw.mutex);
+#endif
+
+    SwRasterizeTiles(0);
+
+#if (RLGL_SW_THREADS > 1)
+    pthread_mutex_lock(&sw.mutex);
+    while (sw.pending > 0) pthread_cond_wait(&sw.done, &sw.mutex);
+    pthread_mutex_unlock(&sw.mutex);
+#endif
+
+    for (int i = 0; i < sw.tilesX*sw.tilesY; i++) sw.tiles[i].count = 0;
+    sw.trianglesCount = 0;
+}
+
+// Read framebuffer pixels, bottom rows as glReadPixels() (alpha set to 255)
+// NOTE: Requested area out of framebuffer (size bigger than framebuffer) is left blank
+static unsigned char *SwReadPixels(int width, int height)
+{
+    SwResolve();
+
+    unsigned char *pixels = (unsigned char *)calloc(width*height, sizeof(Color));
+
+    int rowWidth = (width < sw.width)? width : sw.width;
+    int rowsCount = (height < sw.height)? height : sw.height;
+
+    for (int y = 0; y < rowsCount; y++)
+    {
+        Color *row = (Color *)pixels + (height - rowsCount + y)*width;
+
+        memcpy(row, sw.color + (sw.height - rowsCount + y)*sw.width, rowWidth*sizeof(Color));
+        for (int x = 0; x < rowWidth; x++) row[x].a = 255;
+    }
+
+    return pixels;
+}
+
+// Load texture, first unused texture slot is reused
+// NOTE: Only base level is loaded, mipmaps are not used (nearest sampling)
+static unsigned int SwLoadTexture(const void *data, int width, int height, int format)
+{
+    Color *texels = (Color *)calloc(width*height, sizeof(Color));
+
+    if ((data != NULL) && !SwConvertPixels(data, width*height, format, texels))
+    {
+        TraceLog(LOG_WARNING, "Texture format not supported");
+        free(texels);
+        return 0;
+    }
+
+    int slot = 0;
+    while ((slot < sw.texturesCount) && (sw.textures[slot].data != NULL)) slot++;
+
+    if (slot == sw.texturesCount)
+    {
+        SwTexture *textures = (SwTexture *)realloc(sw.textures, (sw.texturesCount + 1)*sizeof(SwTexture));
+
+        if (textures == NULL)
+        {
+            TraceLog(LOG_WARNING, "Texture could not be created");
+            free(texels);
+            return 0;
+        }
+
+        sw.textures = textures;
+        sw.texturesCount++;
+    }
+
+    sw.textures[slot] = (SwTexture){ width, height, false, false, texels };
+
+    TraceLog(LOG_INFO, "[TEX ID %i] Texture created successfully (%ix%i - 1 mipmaps)", slot + 1, width, height);
+
+    return slot + 1;
+}
+
+// Update texture texels (from top-left corner)
+static void SwUpdateTexture(unsigned int id, int width, int height, int format, const void *data)
+{
+    SwTexture *texture = SwGetTexture(id);
+
+    if ((texture == NULL) || (width > texture->width) || (height > texture->height)) return;
+
+    Color *texels = (Color *)malloc(width*height*sizeof(Color));
+
+    if (SwConvertPixels(data, width*height, format, texels))
+    {
+        SwResolve();        // Queued triangles sample previous texels
+
+        for (int y = 0; y < height; y++) memcpy(texture->data + y*texture->width, texels + y*width, width*sizeof(Color));
+    }
+    else TraceLog(LOG_WARNING, "Texture format updating not supported");
+
+    free(texels);
+}
+
+// Unload texture, texture slot can be reused
+static void SwUnloadTexture(unsigned int id)
+{
+    SwTexture *texture = SwGetTexture(id);
+
+    if (texture != NULL)
+    {
+        SwResolve();        // Queued triangles could sample texture
+
+        free(texture->data);
+        texture->data = NULL;
+    }
+}
+
+// Get texture by id
+static SwTexture *SwGetTexture(unsigned int id)
+{
+    if ((id == 0) || (id > (unsigned int)sw.texturesCount) || (sw.textures[id - 1].data == NULL)) return NULL;
+
+    return &sw.textures[id - 1];
+}
+
+// Convert pixels data to R8G8B8A8
+// NOTE: Only uncompressed 8 bit per channel formats are supported
+static bool SwConvertPixels(const void *data, int count, int format, Color *output)
+{
+    const unsigned char *pixels = (const unsigned char *)data;
+
+    switch (format)
+    {
+        case UNCOMPRESSED_GRAYSCALE: for (int i = 0; i < count; i++) output[i] = (Color){ pixels[i], pixels[i], pixels[i], 255 }; break;
+        case UNCOMPRESSED_GRAY_ALPHA: for (int i = 0; i < count; i++) output[i] = (Color){ pixels[2*i], pixels[2*i], pixels[2*i], pixels[2*i + 1] }; break;
+        case UNCOMPRESSED_R8G8B8: for (int i = 0; i < count; i++) output[i] = (Color){ pixels[3*i], pixels[3*i + 1], pixels[3*i + 2], 255 }; break;
+        case UNCOMPRESSED_R8G8B8A8: memcpy(output, pixels, count*sizeof(Color)); break;
+        default: return false;
+    }
+
+    return true;
+}
+
+// Submit default internal buffers vertex data triangles (lines, triangles, quads)
+static void SwDrawBuffersDefault(Matrix mvp)
+{
+    SwVertex v[4] = { 0 };
+    float color[4] = { 0 };
+    bool visible = true;
+
+    // Lines are expanded to 1 pixel wide quads
+    if (lines.vCounter > 0)
+    {
+        SetTexture(0, whiteTexture);
+
+        for (int i = 0; (i + 1) < lines.vCounter; i += 2)
+        {
+            visible = true;
+
+            for (int k = 0; k < 2; k++)
+            {
+                DynamicVertex *vertex = &lines.vertices[i + k];
+                for (int c = 0; c < 4; c++) color[c] = (float)vertex->color[c]/255.0f;
+
+                visible = SwProjectVertex(mvp, vertex->position, vertex->texcoord, color, &v[k]) && visible;
+            }
+
+            if (visible) SwPushLine(&v[0], &v[1]);
+        }
+
+        stats.drawCalls++;
+    }
+
+    if (triangles.vCounter > 0)
+    {
+        SetTexture(0, whiteTexture);
+
+        for (int i = 0; (i + 2) < triangles.vCounter; i += 3)
+        {
+            visible = true;
+
+            for (int k = 0; k < 3; k++)
+            {
+                DynamicVertex *vertex = &triangles.vertices[i + k];
+                for (int c = 0; c < 4; c++) color[c] = (float)vertex->color[c]/255.0f;
+
+                visible = SwProjectVertex(mvp, vertex->position, vertex->texcoord, color, &v[k]) && visible;
+            }
+
+            if (visible) SwPushTriangle(&v[0], &v[1], &v[2], whiteTexture, (state.cullFace == 1));
+        }
+
+        stats.drawCalls++;
+    }
+
+    // NOTE: Quads draw calls vertex data offsets are set on SortDrawCalls()
+    if (quads.vCounter > 0)
+    {
+        for (int i = 0; i < drawsCounter; i++)
+        {
+            if (draws[i].vertexCount == 0) continue;    // Empty draw (texture enabled but nothing drawn)
+
+            SetTexture(0, draws[i].textureId);
+
+            for (int q = 0; q < draws[i].vertexCount/4; q++)
+            {
+                visible = true;
+
+                for (int k = 0; k < 4; k++)
+                {
+                    DynamicVertex *vertex = &quads.vertices[draws[i].vertexOffset + 4*q + k];
+                    for (int c = 0; c < 4; c++) color[c] = (float)vertex->color[c]/255.0f;
+
+                    visible = SwProjectVertex(mvp, vertex->position, vertex->texcoord, color, &v[k]) && visible;
+                }
+
+                // Quad indices: 0, 1, 2, 0, 2, 3 (same as quads index buffer)
+                if (visible)
+                {
+                    SwPushTriangle(&v[0], &v[1], &v[2], draws[i].textureId, (state.cullFace == 1));
+                    SwPushTriangle(&v[0], &v[2], &v[3], draws[i].textureId, (state.cullFace == 1));
+                }
+            }
+
+            stats.drawCalls++;
+        }
+    }
 }
 
-// Set internal projection and modelview matrix depending on eyes tracking data
-static void SetStereoView(int eye, Matrix matProjection, Matrix matModelView)
+// Submit mesh triangles, diffuse map texture and color are used (no lighting)
+static void SwDrawMesh(Mesh mesh, Material material, Matrix transform)
 {
-    Matrix eyeProjection = matProjection;
-    Matrix eyeModelView = matModelView;
+    // NOTE: Inside rlPushMatrix()/rlPopMatrix() matrix stack transform is also combined
+    Matrix matModel = transform;
+    if (transformRequired) matModel = MatrixMultiply(transform, transformMatrix);
 
-    // Setup viewport and projection/modelview matrices using tracking data
-    rlViewport(eye*screenWidth/2, 0, screenWidth/2, screenHeight);
+    Matrix matMVP = MatrixMultiply(MatrixMultiply(matModel, modelview), projection);
 
-    // Apply view offset to modelview matrix
-    eyeModelView = MatrixMultiply(matModelView, vrConfig.eyesViewOffset[eye]);
+    unsigned int textureId = material.maps[MAP_DIFFUSE].texture.id;
+    if (textureId == 0) textureId = whiteTexture;
 
-    // Set current eye projection matrix
-    eyeProjection = vrConfig.eyesProjection[eye];
+    Color tint = material.maps[MAP_DIFFUSE].color;
 
-    SetMatrixModelview(eyeModelView);
-    SetMatrixProjection(eyeProjection);
-}
-#endif      // defined(SUPPORT_VR_SIMULATOR)
+    SetTexture(0, textureId);
 
-#endif //defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    int vertexCount = (mesh.indices != NULL)? mesh.triangleCount*3 : mesh.vertexCount;
 
-// Get OpenGL internal formats and data type from raylib PixelFormat
-static void GetGlFormats(int format, int *glInternalFormat, int *glFormat, int *glType)
-{
-    *glInternalFormat = -1;
-    *glFormat = -1;
-    *glType = -1;
+    SwVertex v[3] = { 0 };
+    float texcoord[2] = { 0 };
+    float color[4] = { 0 };
 
-    switch (format)
+    for (int i = 0; (i + 2) < vertexCount; i += 3)
     {
-    #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_21) || defined(GRAPHICS_API_OPENGL_ES2)
-        // NOTE: on OpenGL ES 2.0 (WebGL), internalFormat must match format and options allowed are: GL_LUMINANCE, GL_RGB, GL_RGBA
-        case UNCOMPRESSED_GRAYSCALE: *glInternalFormat = GL_LUMINANCE; *glFormat = GL_LUMINANCE; *glType = GL_UNSIGNED_BYTE; break;
-        case UNCOMPRESSED_GRAY_ALPHA: *glInternalFormat = GL_LUMINANCE_ALPHA; *glFormat = GL_LUMINANCE_ALPHA; *glType = GL_UNSIGNED_BYTE; break;
-        case UNCOMPRESSED_R5G6B5: *glInternalFormat = GL_RGB; *glFormat = GL_RGB; *glType = GL_UNSIGNED_SHORT_5_6_5; break;
-        case UNCOMPRESSED_R8G8B8: *glInternalFormat = GL_RGB; *glFormat = GL_RGB; *glType = GL_UNSIGNED_BYTE; break;
-        case UNCOMPRESSED_R5G5B5A1: *glInternalFormat = GL_RGBA; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_SHORT_5_5_5_1; break;
-        case UNCOMPRESSED_R4G4B4A4: *glInternalFormat = GL_RGBA; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_SHORT_4_4_4_4; break;
-        case UNCOMPRESSED_R8G8B8A8: *glInternalFormat = GL_RGBA; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_BYTE; break;
-        #if !defined(GRAPHICS_API_OPENGL_11)
-        case UNCOMPRESSED_R32: if (texFloatSupported) *glInternalFormat = GL_LUMINANCE; *glFormat = GL_LUMINANCE; *glType = GL_FLOAT; break;   // NOTE: Requires extension OES_texture_float
-        case UNCOMPRESSED_R32G32B32: if (texFloatSupported) *glInternalFormat = GL_RGB; *glFormat = GL_RGB; *glType = GL_FLOAT; break;         // NOTE: Requires extension OES_texture_float
-        case UNCOMPRESSED_R32G32B32A32: if (texFloatSupported) *glInternalFormat = GL_RGBA; *glFormat = GL_RGBA; *glType = GL_FLOAT; break;    // NOTE: Requires extension OES_texture_float
-        #endif
-    #elif defined(GRAPHICS_API_OPENGL_33)
-        case UNCOMPRESSED_GRAYSCALE: *glInternalFormat = GL_R8; *glFormat = GL_RED; *glType = GL_UNSIGNED_BYTE; break;
-        case UNCOMPRESSED_GRAY_ALPHA: *glInternalFormat = GL_RG8; *glFormat = GL_RG; *glType = GL_UNSIGNED_BYTE; break;
-        case UNCOMPRESSED_R5G6B5: *glInternalFormat = GL_RGB565; *glFormat = GL_RGB; *glType = GL_UNSIGNED_SHORT_5_6_5; break;
-        case UNCOMPRESSED_R8G8B8: *glInternalFormat = GL_RGB8; *glFormat = GL_RGB; *glType = GL_UNSIGNED_BYTE; break;
-        case UNCOMPRESSED_R5G5B5A1: *glInternalFormat = GL_RGB5_A1; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_SHORT_5_5_5_1; break;
-        case UNCOMPRESSED_R4G4B4A4: *glInternalFormat = GL_RGBA4; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_SHORT_4_4_4_4; break;
-        case UNCOMPRESSED_R8G8B8A8: *glInternalFormat = GL_RGBA8; *glFormat = GL_RGBA; *glType = GL_UNSIGNED_BYTE; break;
-        case UNCOMPRESSED_R32: if (texFloatSupported) *glInternalFormat = GL_R32F; *glFormat = GL_RED; *glType = GL_FLOAT; break;
-        case UNCOMPRESSED_R32G32B32: if (texFloatSupported) *glInternalFormat = GL_RGB32F; *glFormat = GL_RGB; *glType = GL_FLOAT; break;
-        case UNCOMPRESSED_R32G32B32A32: if (texFloatSupported) *glInternalFormat = GL_RGBA32F; *glFormat = GL_RGBA; *glType = GL_FLOAT; break;
-    #endif
-        #if !defined(GRAPHICS_API_OPENGL_11)
-        case COMPRESSED_DXT1_RGB: if (texCompDXTSupported) *glInternalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
-        case COMPRESSED_DXT1_RGBA: if (texCompDXTSupported) *glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
-        case COMPRESSED_DXT3_RGBA: if (texCompDXTSupported) *glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; break;
-        case COMPRESSED_DXT5_RGBA: if (texCompDXTSupported) *glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
-        case COMPRESSED_ETC1_RGB: if (texCompETC1Supported) *glInternalFormat = GL_ETC1_RGB8_OES; break;                      // NOTE: Requires OpenGL ES 2.0 or OpenGL 4.3
-        case COMPRESSED_ETC2_RGB: if (texCompETC2Supported) *glInternalFormat = GL_COMPRESSED_RGB8_ETC2; break;               // NOTE: Requires OpenGL ES 3.0 or OpenGL 4.3
-        case COMPRESSED_ETC2_EAC_RGBA: if (texCompETC2Supported) *glInternalFormat = GL_COMPRESSED_RGBA8_ETC2_EAC; break;     // NOTE: Requires OpenGL ES 3.0 or OpenGL 4.3
-        case COMPRESSED_PVRT_RGB: if (texCompPVRTSupported) *glInternalFormat = GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG; break;    // NOTE: Requires PowerVR GPU
-        case COMPRESSED_PVRT_RGBA: if (texCompPVRTSupported) *glInternalFormat = GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG; break;  // NOTE: Requires PowerVR GPU
-        case COMPRESSED_ASTC_4x4_RGBA: if (texCompASTCSupported) *glInternalFormat = GL_COMPRESSED_RGBA_ASTC_4x4_KHR; break;  // NOTE: Requires OpenGL ES 3.1 or OpenGL 4.3
-        case COMPRESSED_ASTC_8x8_RGBA: if (texCompASTCSupported) *glInternalFormat = GL_COMPRESSED_RGBA_ASTC_8x8_KHR; break;  // NOTE: Requires OpenGL ES 3.1 or OpenGL 4.3
-        #endif
-        default: TraceLog(LOG_WARNING, "Texture format not supported"); break;
+        bool visible = true;
+
+        for (int k = 0; k < 3; k++)
+        {
+            int index = (mesh.indices != NULL)? mesh.indices[i + k] : (i + k);
+
+            if (mesh.texcoords != NULL)
+            {
+                texcoord[0] = mesh.texcoords[2*index];
+                texcoord[1] = mesh.texcoords[2*index + 1];
+            }
+
+            color[0] = (float)tint.r/255.0f;
+            color[1] = (float)tint.g/255.0f;
+            color[2] = (float)tint.b/255.0f;
+            color[3] = (float)tint.a/255.0f;
+
+            if (mesh.colors != NULL) for (int c = 0; c < 4; c++) color[c] *= (float)mesh.colors[4*index + c]/255.0f;
+
+            visible = SwProjectVertex(matMVP, &mesh.vertices[3*index], texcoord, color, &v[k]) && visible;
+        }
+
+        if (visible) SwPushTriangle(&v[0], &v[1], &v[2], textureId, (state.cullFace == 1));
     }
+
+    stats.drawCalls++;
 }
 
-#if defined(GRAPHICS_API_OPENGL_11)
-// Mipmaps data is generated after image data
-// NOTE: Only works with RGBA (4 bytes) data!
-static int GenerateMipmaps(unsigned char *data, int baseWidth, int baseHeight)
+// Project vertex to screen space: clip space, perspective division and viewport transform
+// NOTE: Vertex behind camera (w <= 0) is not clipped, triangle is discarded
+static bool SwProjectVertex(Matrix mvp, const float *position, const float *texcoord, const float *color, SwVertex *vertex)
 {
-    int mipmapCount = 1;                // Required mipmap levels count (including base level)
-    int width = baseWidth;
-    int height = baseHeight;
-    int size = baseWidth*baseHeight*4;  // Size in bytes (will include mipmaps...), RGBA only
+    float x = mvp.m0*position[0] + mvp.m4*position[1] + mvp.m8*position[2] + mvp.m12;
+    float y = mvp.m1*position[0] + mvp.m5*position[1] + mvp.m9*position[2] + mvp.m13;
+    float z = mvp.m2*position[0] + mvp.m6*position[1] + mvp.m10*position[2] + mvp.m14;
+    float w = mvp.m3*position[0] + mvp.m7*position[1] + mvp.m11*position[2] + mvp.m15;
 
-    // Count mipmap levels required
-    while ((width != 1) && (height != 1))
+    if (!(w > 0.0f)) return false;
+
+    float invW = 1.0f/w;
+
+    // NOTE: Viewport origin is bottom-left (OpenGL), framebuffer rows are top-down
+    vertex->x = (float)sw.viewport[0] + (x*invW + 1.0f)*0.5f*(float)sw.viewport[2];
+    vertex->y = (float)sw.height - ((float)sw.viewport[1] + (y*invW + 1.0f)*0.5f*(float)sw.viewport[3]);
+
+    // Snap position to subpixel grid (as GPUs fixed point), adjacent primitives share exactly the same edges
+    vertex->x = floorf(vertex->x*SW_SUBPIXEL_STEPS + 0.5f)/SW_SUBPIXEL_STEPS;
+    vertex->y = floorf(vertex->y*SW_SUBPIXEL_STEPS + 0.5f)/SW_SUBPIXEL_STEPS;
+    vertex->z = z*invW*0.5f + 0.5f;
+    vertex->invW = invW;
+
+    vertex->u = texcoord[0]*invW;
+    vertex->v = texcoord[1]*invW;
+    for (int c = 0; c < 4; c++) vertex->color[c] = color[c]*invW;
+
+    return true;
+}
+
+// Queue triangle with current pipeline state (texture, depth test, blending), binned into tiles
+static void SwPushTriangle(const SwVertex *v0, const SwVertex *v1, const SwVertex *v2, unsigned int textureId, bool cull)
+{
+    float area = (v1->x - v0->x)*(v2->y - v0->y) - (v1->y - v0->y)*(v2->x - v0->x);
+
+    // NOTE: Counter-clockwise front faces (OpenGL default) get negative area on top-down screen space,
+    // front faces vertex order is swapped so edge functions are positive inside triangle
+    if (area < 0.0f)
     {
-        if (width != 1) width /= 2;
-        if (height != 1) height /= 2;
+        const SwVertex *temp = v1;
+        v1 = v2;
+        v2 = temp;
+        area = -area;
+    }
+    else if (cull) return;          // Back face (or degenerate)
+
+    if (!(area > 0.0f)) return;     // Degenerate triangle (or NaN)
+
+    // Bounding box clipped to viewport (and framebuffer)
+    int vpMinX = (sw.viewport[0] > 0)? sw.viewport[0] : 0;
+    int vpMaxX = ((sw.viewport[0] + sw.viewport[2]) < sw.width)? (sw.viewport[0] + sw.viewport[2] - 1) : (sw.width - 1);
+    int vpMinY = ((sw.height - sw.viewport[1] - sw.viewport[3]) > 0)? (sw.height - sw.viewport[1] - sw.viewport[3]) : 0;
+    int vpMaxY = (sw.viewport[1] > 0)? (sw.height - sw.viewport[1] - 1) : (sw.height - 1);
+
+    float minX = floorf(fminf(fminf(v0->x, v1->x), v2->x));
+    float maxX = floorf(fmaxf(fmaxf(v0->x, v1->x), v2->x));
+    float minY = floorf(fminf(fminf(v0->y, v1->y), v2->y));
+    float maxY = floorf(fmaxf(fmaxf(v0->y, v1->y), v2->y));
+
+    if ((maxX < (float)vpMinX) || (minX > (float)vpMaxX) || (maxY < (float)vpMinY) || (minY > (float)vpMaxY)) return;
+
+    if (sw.trianglesCount == SW_MAX_TRIANGLES) SwResolve();
+
+    SwTriangle *triangle = &sw.triangles[sw.trianglesCount];
+
+    triangle->v[0] = *v0;
+    triangle->v[1] = *v1;
+    triangle->v[2] = *v2;
+    triangle->edges[0] = SwSetupEdge(v1, v2);
+    triangle->edges[1] = SwSetupEdge(v2, v0);
+    triangle->edges[2] = SwSetupEdge(v0, v1);
+    triangle->area = area;
+    triangle->minX = (minX < (float)vpMinX)? vpMinX : (int)minX;
+    triangle->maxX = (maxX > (float)vpMaxX)? vpMaxX : (int)maxX;
+    triangle->minY = (minY < (float)vpMinY)? vpMinY : (int)minY;
+    triangle->maxY = (maxY > (float)vpMaxY)? vpMaxY : (int)maxY;
+    triangle->textureId = textureId;
+    triangle->depthTest = (state.depthTest == 1);
+    triangle->alphaTest = alphaTest;
+    triangle->blend = (state.blend == 1);
+    triangle->blendSrc = state.blendSrc;
+    triangle->blendDst = state.blendDst;
+
+    // Grow overlapped tiles bins first, triangle is dropped if any bin can not grow (no partial binning)
+    for (int ty = triangle->minY/SW_TILE_SIZE; ty <= triangle->maxY/SW_TILE_SIZE; ty++)
+    {
+        for (int tx = triangle->minX/SW_TILE_SIZE; tx <= triangle->maxX/SW_TILE_SIZE; tx++)
+        {
+            SwTile *tile = &sw.tiles[ty*sw.tilesX + tx];
 
-        TraceLog(LOG_DEBUG, "Next mipmap size: %i x %i", width, height);
+            if (tile->count == tile->capacity)
+            {
+                int capacity = (tile->capacity == 0)? 256 : tile->capacity*2;
+                int *triangles = (int *)realloc(tile->triangles, capacity*sizeof(int));
 
-        mipmapCount++;
+                if (triangles == NULL)
+                {
+                    TraceLog(LOG_WARNING, "Software renderer tile bin could not grow (%i triangles), triangle dropped", capacity);
+                    return;
+                }
 
-        size += (width*height*4);       // Add mipmap size (in bytes)
+                tile->triangles = triangles;
+                tile->capacity = capacity;
+            }
+        }
     }
 
-    TraceLog(LOG_DEBUG, "Total mipmaps required: %i", mipmapCount);
-    TraceLog(LOG_DEBUG, "Total size of data required: %i", size);
+    // Bin triangle into overlapped tiles
+    for (int ty = triangle->minY/SW_TILE_SIZE; ty <= triangle->maxY/SW_TILE_SIZE; ty++)
+    {
+        for (int tx = triangle->minX/SW_TILE_SIZE; tx <= triangle->maxX/SW_TILE_SIZE; tx++)
+        {
+            SwTile *tile = &sw.tiles[ty*sw.tilesX + tx];
+            tile->triangles[tile->count++] = sw.trianglesCount;
+        }
+    }
 
-    unsigned char *temp = realloc(data, size);
+    sw.trianglesCount++;
+}
 
-    if (temp != NULL) data = temp;
-    else TraceLog(LOG_WARNING, "Mipmaps required memory could not be allocated");
+// Queue line as 1 pixel wide quad (not culled)
+static void SwPushLine(const SwVertex *v0, const SwVertex *v1)
+{
+    float dx = v1->x - v0->x;
+    float dy = v1->y - v0->y;
+    float length = sqrtf(dx*dx + dy*dy);
 
-    width = baseWidth;
-    height = baseHeight;
-    size = (width*height*4);
+    if (!(length > 0.0f)) return;
 
-    // Generate mipmaps
-    // NOTE: Every mipmap data is stored after data
-    Color *image = (Color *)malloc(width*height*sizeof(Color));
-    Color *mipmap = NULL;
-    int offset = 0;
-    int j = 0;
+    // Half pixel offset along line normal
+    float nx = -dy/length*0.5f;
+    float ny = dx/length*0.5f;
 
-    for (int i = 0; i < size; i += 4)
+    SwVertex v[4] = { *v0, *v1, *v1, *v0 };
+
+    v[0].x += nx; v[0].y += ny;
+    v[1].x += nx; v[1].y += ny;
+    v[2].x -= nx; v[2].y -= ny;
+    v[3].x -= nx; v[3].y -= ny;
+
+    SwPushTriangle(&v[0], &v[1], &v[2], whiteTexture, false);
+    SwPushTriangle(&v[0], &v[2], &v[3], whiteTexture, false);
+}
+
+// Setup edge function from a to b, positive inside triangle
+// NOTE: Top-left fill rule: pixels on left edges (going up) and top edges (going right) are covered
+static SwEdge SwSetupEdge(const SwVertex *a, const SwVertex *b)
+{
+    SwEdge edge = { 0 };
+
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+
+    edge.inclusive = (dy < 0.0f) || ((dy == 0.0f) && (dx > 0.0f));
+
+    if ((a->y < b->y) || ((a->y == b->y) && (a->x < b->x)))
     {
-        image[j].r = data[i];
-        image[j].g = data[i + 1];
-        image[j].b = data[i + 2];
-        image[j].a = data[i + 3];
-        j++;
+        edge.x = a->x;
+        edge.y = a->y;
+        edge.dx = dx;
+        edge.dy = dy;
+        edge.sign = 1.0f;
+    }
+    else
+    {
+        edge.x = b->x;
+        edge.y = b->y;
+        edge.dx = a->x - b->x;
+        edge.dy = a->y - b->y;
+        edge.sign = -1.0f;
     }
 
-    TraceLog(LOG_DEBUG, "Mipmap base (%ix%i)", width, height);
+    return edge;
+}
 
-    for (int mip = 1; mip < mipmapCount; mip++)
+// Rasterize queued triangles on thread tiles (interleaved tiles for load balancing)
+// NOTE: Tiles triangles are rasterized in submission order, blending and depth test are ordered per pixel
+static void SwRasterizeTiles(int thread)
+{
+    for (int t = thread; t < sw.tilesX*sw.tilesY; t += RLGL_SW_THREADS)
     {
-        mipmap = GenNextMipmap(image, width, height);
+        SwTile *tile = &sw.tiles[t];
 
-        offset += (width*height*4); // Size of last mipmap
-        j = 0;
+        int minX = (t%sw.tilesX)*SW_TILE_SIZE;
+        int minY = (t/sw.tilesX)*SW_TILE_SIZE;
 
-        width /= 2;
-        height /= 2;
-        size = (width*height*4);    // Mipmap size to store after offset
+        for (int i = 0; i < tile->count; i++)
+        {
+            SwRasterizeTriangle(&sw.triangles[tile->triangles[i]], minX, minY, minX + SW_TILE_SIZE - 1, minY + SW_TILE_SIZE - 1);
+        }
+    }
+}
 
-        // Add mipmap to data
-        for (int i = 0; i < size; i += 4)
+// Rasterize triangle inside tile bounds, edge functions evaluated at pixel centers
+// NOTE: SSE version evaluates 4 pixels coverage per step (same operations order as scalar version)
+static void SwRasterizeTriangle(const SwTriangle *triangle, int minX, int minY, int maxX, int maxY)
+{
+    if (triangle->minX > minX) minX = triangle->minX;
+    if (triangle->minY > minY) minY = triangle->minY;
+    if (triangle->maxX < maxX) maxX = triangle->maxX;
+    if (triangle->maxY < maxY) maxY = triangle->maxY;
+
+    const SwEdge *edges = triangle->edges;
+    float invArea = 1.0f/triangle->area;
+    float rows[3] = { 0 };
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        float py = (float)y + 0.5f;
+        for (int i = 0; i < 3; i++) rows[i] = edges[i].dx*(py - edges[i].y);
+
+        int x = minX;
+
+#if defined(RLGL_SIMD_SSE)
+        float weights[3][4];
+
+        for (; (x + 3) <= maxX; x += 4)
         {
-            data[offset + i] = mipmap[j].r;
-            data[offset + i + 1] = mipmap[j].g;
-            data[offset + i + 2] = mipmap[j].b;
-            data[offset + i + 3] = mipmap[j].a;
-            j++;
+            __m128 px = _mm_set_ps((float)(x + 3) + 0.5f, (float)(x + 2) + 0.5f, (float)(x + 1) + 0.5f, (float)x + 0.5f);
+            int mask = 0xF;
+
+            for (int i = 0; i < 3; i++)
+            {
+                __m128 e = _mm_mul_ps(_mm_set1_ps(edges[i].dy), _mm_sub_ps(px, _mm_set1_ps(edges[i].x)));
+                e = _mm_mul_ps(_mm_set1_ps(edges[i].sign), _mm_sub_ps(_mm_set1_ps(rows[i]), e));
+
+                if (edges[i].inclusive) mask &= _mm_movemask_ps(_mm_cmpge_ps(e, _mm_setzero_ps()));
+                else mask &= _mm_movemask_ps(_mm_cmpgt_ps(e, _mm_setzero_ps()));
+
+                _mm_storeu_ps(weights[i], e);
+            }
+
+            for (int k = 0; (k < 4) && (mask != 0); k++, mask >>= 1)
+            {
+                if (mask & 1) SwShadePixel(triangle, x + k, y, weights[1][k]*invArea, weights[2][k]*invArea);
+            }
         }
+#endif
+        for (; x <= maxX; x++)
+        {
+            float px = (float)x + 0.5f;
+            float e[3] = { 0 };
+            bool covered = true;
 
-        free(image);
+            for (int i = 0; i < 3; i++)
+            {
+                e[i] = edges[i].sign*(rows[i] - edges[i].dy*(px - edges[i].x));
+                covered = covered && (edges[i].inclusive? (e[i] >= 0.0f) : (e[i] > 0.0f));
+            }
 
-        image = mipmap;
-        mipmap = NULL;
+            if (covered) SwShadePixel(triangle, x, y, e[1]*invArea, e[2]*invArea);
+        }
     }
+}
 
-    free(mipmap);       // free mipmap data
+// Shade pixel (fixed pipeline: texture * color), depth test and blending
+// NOTE: Fully transparent fragments are only discarded (no depth write) with alpha test enabled, as OpenGL default shader
+static void SwShadePixel(const SwTriangle *triangle, int x, int y, float w1, float w2)
+{
+    const SwVertex *v = triangle->v;
+    int index = y*sw.width + x;
 
-    return mipmapCount;
+    // NOTE: Attributes are interpolated relative to first vertex, values constant along an edge
+    // are kept exact (texture coordinates on tiles borders do not sample neighbour texels)
+
+    // Depth is interpolated linearly on screen space, clipped per pixel (near/far planes)
+    float z = v[0].z + w1*(v[1].z - v[0].z) + w2*(v[2].z - v[0].z);
+
+    if ((z < 0.0f) || (z > 1.0f)) return;
+    if (triangle->depthTest && (z > sw.depth[index])) return;
+
+    // Perspective correct attributes interpolation
+    float w = 1.0f/(v[0].invW + w1*(v[1].invW - v[0].invW) + w2*(v[2].invW - v[0].invW));
+    float u = (v[0].u + w1*(v[1].u - v[0].u) + w2*(v[2].u - v[0].u))*w;
+    float tv = (v[0].v + w1*(v[1].v - v[0].v) + w2*(v[2].v - v[0].v))*w;
+
+    float src[4] = { 0 };
+    for (int c = 0; c < 4; c++) src[c] = (v[0].color[c] + w1*(v[1].color[c] - v[0].color[c]) + w2*(v[2].color[c] - v[0].color[c]))*w;
+
+    // Texture sampling (nearest filter)
+    SwTexture *texture = SwGetTexture(triangle->textureId);
+
+    if (texture != NULL)
+    {
+        if (!texture->clampU) u -= floorf(u);
+        if (!texture->clampV) tv -= floorf(tv);
+
+        float fx = u*(float)texture->width;
+        float fy = tv*(float)texture->height;
+
+        int tx = (fx < 0.0f)? 0 : ((fx >= (float)texture->width)? (texture->width - 1) : (int)fx);
+        int ty = (fy < 0.0f)? 0 : ((fy >= (float)texture->height)? (texture->height - 1) : (int)fy);
+
+        Color texel = texture->data[ty*texture->width + tx];
+
+        src[0] *= (float)texel.r/255.0f;
+        src[1] *= (float)texel.g/255.0f;
+        src[2] *= (float)texel.b/255.0f;
+        src[3] *= (float)texel.a/255.0f;
+    }
+
+    if (triangle->alphaTest && (src[3] <= 0.0f)) return;
+
+    Color *pixel = &sw.color[index];
+    float result[4] = { src[0], src[1], src[2], src[3] };
+
+    if (triangle->blend)
+    {
+        float dst[4] = { (float)pixel->r/255.0f, (float)pixel->g/255.0f, (float)pixel->b/255.0f, (float)pixel->a/255.0f };
+        float srcFactor[4] = { 0 };
+        float dstFactor[4] = { 0 };
+
+        SwBlendFactor(triangle->blendSrc, src, dst, srcFactor);
+        SwBlendFactor(triangle->blendDst, src, dst, dstFactor);
+
+        for (int c = 0; c < 4; c++) result[c] = src[c]*srcFactor[c] + dst[c]*dstFactor[c];
+    }
+
+    for (int c = 0; c < 4; c++) result[c] = (result[c] < 0.0f)? 0.0f : ((result[c] > 1.0f)? 1.0f : result[c]);
+
+    pixel->r = (unsigned char)(result[0]*255.0f + 0.5f);
+    pixel->g = (unsigned char)(result[1]*255.0f + 0.5f);
+    pixel->b = (unsigned char)(result[2]*255.0f + 0.5f);
+    pixel->a = (unsigned char)(result[3]*255.0f + 0.5f);
+
+    if (triangle->depthTest) sw.depth[index] = z;
 }
 
-// Manual mipmap generation (basic scaling algorithm)
-static Color *GenNextMipmap(Color *srcData, int srcWidth, int srcHeight)
+// Get blending factor (blending functions used by BeginBlendMode())
+static void SwBlendFactor(GLenum factor, const float *src, const float *dst, float *result)
 {
-    int x2, y2;
-    Color prow, pcol;
+    for (int c = 0; c < 4; c++)
+    {
+        switch (factor)
+        {
+            case GL_ONE: result[c] = 1.0f; break;
+            case GL_SRC_ALPHA: result[c] = src[3]; break;
+            case GL_ONE_MINUS_SRC_ALPHA: result[c] = 1.0f - src[3]; break;
+            case GL_DST_COLOR: result[c] = dst[c]; break;
+            default: result[c] = 0.0f; break;
+        }
+    }
+}
 
-    int width = srcWidth/2;
-    int height = srcHeight/2;
+#if (RLGL_SW_THREADS > 1)
+// Software rasterizer worker thread, rasterizes its tiles on every resolve
+static void *SwWorkerThread(void *arg)
+{
+    int thread = (int)(size_t)arg;
+    int generation = 0;
 
-    Color *mipmap = (Color *)malloc(width*height*sizeof(Color));
+    pthread_mutex_lock(&sw.mutex);
 
-    // Scaling algorithm works perfectly (box-filter)
-    for (int y = 0; y < height; y++)
+    while (true)
     {
-        y2 = 2*y;
+        while (!sw.quit && (sw.generation == generation)) pthread_cond_wait(&sw.start, &sw.mutex);
 
-        for (int x = 0; x < width; x++)
-        {
-            x2 = 2*x;
+        if (sw.quit) break;
 
-            prow.r = (srcData[y2*srcWidth + x2].r + srcData[y2*srcWidth + x2 + 1].r)/2;
-            prow.g = (srcData[y2*srcWidth + x2].g + srcData[y2*srcWidth + x2 + 1].g)/2;
-            prow.b = (srcData[y2*srcWidth + x2].b + srcData[y2*srcWidth + x2 + 1].b)/2;
-            prow.a = (srcData[y2*srcWidth + x2].a + srcData[y2*srcWidth + x2 + 1].a)/2;
+        generation = sw.generation;
+        pthread_mutex_unlock(&sw.mutex);
 
-            pcol.r = (srcData[(y2+1)*srcWidth + x2].r + srcData[(y2+1)*srcWidth + x2 + 1].r)/2;
-            pcol.g = (srcData[(y2+1)*srcWidth + x2].g + srcData[(y2+1)*srcWidth + x2 + 1].g)/2;
-            pcol.b = (srcData[(y2+1)*srcWidth + x2].b + srcData[(y2+1)*srcWidth + x2 + 1].b)/2;
-            pcol.a = (srcData[(y2+1)*srcWidth + x2].a + srcData[(y2+1)*srcWidth + x2 + 1].a)/2;
+        SwRasterizeTiles(thread);
 
-            mipmap[y*width + x].r = (prow.r + pcol.r)/2;
-            mipmap[y*width + x].g = (prow.g + pcol.g)/2;
-            mipmap[y*width + x].b = (prow.b + pcol.b)/2;
-            mipmap[y*width + x].a = (prow.a + pcol.a)/2;
-        }
+        pthread_mutex_lock(&sw.mutex);
+        sw.pending--;
+        if (sw.pending == 0) pthread_cond_signal(&sw.done);
     }
 
-    TraceLog(LOG_DEBUG, "Mipmap generated successfully (%ix%i)", width, height);
+    pthread_mutex_unlock(&sw.mutex);
 
-    return mipmap;
+    return NULL;
 }
 #endif
+#endif  // GRAPHICS_API_SOFTWARE
 
 #if defined(RLGL_STANDALONE)
 // Show trace log messages (LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_DEBUG)
@@ -16,6 +16,8 @@
 *       gcc -o $(NAME_PART).exe $(FILE_NAME) -Iexternal -Iexternal/glfw/include \
 *           rglfw.o -lopengl32 -lgdi32 -Wall -std=c99
 *
+*   Capture OpenGL calls (maze.gltrace, replay with tools/glreplay) compiling with -DGL_CAPTURE
+*
 *   Copyright (c) 2017-2018 Ramon Santamaria (@raysan5)
 *
 ********************************************************************************************/
@@ -23,6 +25,13 @@
 #define GLAD_IMPLEMENTATION
 #include "glad.h"               // GLAD extensions loading library
                                 // NOTE: Includes required OpenGL headers
+
+#if defined(GL_CAPTURE)
+    #define GLCAPTURE_IMPLEMENTATION
+    #include "glcapture.h"      // OpenGL calls capture into binary trace (offline replay)
+
+    #define GL_CAPTURE_FRAMES   300     // Frames to capture (resources loading included on first frame)
+#endif
                                 
 #include <GLFW/glfw3.h>         // Windows/Context and inputs management
 
@@ -153,6 +162,23 @@ typedef enum {
     MOVE_DOWN 
 } CameraMove;
 
+// GL state cache, used to filter redundant state changes
+// NOTE: Uniform values are cached for current shader program, model/view matrix changes every draw (not cached)
+typedef struct StateCache {
+    unsigned int program;       // Current shader program
+    unsigned int texture;       // Current texture bound to texture unit 0
+    unsigned int vaoId;         // Current VAO
+    int depthTest;              // GL_DEPTH_TEST enabled (-1: unknown)
+    int blend;                  // GL_BLEND enabled (-1: unknown)
+    int cullFace;               // GL_CULL_FACE enabled (-1: unknown)
+    
+    unsigned int uniformsProgram;   // Shader program cached uniform values belong to
+    float color[4];             // Shader colorLoc uniform value
+    int mapTexture;             // Shader mapTextureLoc uniform value (-1: unknown)
+
+    int filteredCalls;          // Redundant GL calls filtered (not issued)
+} StateCache;
+
 //----------------------------------------------------------------------------------
 // Global Variables Declaration
 //----------------------------------------------------------------------------------
@@ -179,6 +205,9 @@ static unsigned int quadId;                 // Quad VAO id to be used on texture
 // LESSON 06: Camera system management
 static Vector2 cameraAngle = { 0.0f, 0.0f };
 
+// GL state cache (redundant state changes filtering)
+static StateCache state = { 0 };
+
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
@@ -243,6 +272,16 @@ static void UpdateCamera(Camera *camera);                   // Update camera for
 //----------------------------------------------------------------------------------
 static bool CheckCollisionCircleRec(Vector2 center, float radius, Rectangle rec);   // Check collision between circle and rectangle
 
+// GL state cache: redundant state changes filtering
+//----------------------------------------------------------------------------------
+static void ResetStateCache(void);                          // Reset GL state cache (state changed out of cache)
+static void SetProgram(unsigned int id);                    // Set current shader program (if not already set)
+static void SetTexture(unsigned int id);                    // Bind texture to texture unit 0 (if not already bound)
+static void SetVertexArray(unsigned int id);                // Bind VAO (if not already bound)
+static void SetCapability(GLenum cap, bool enabled);        // Enable/disable GL capability (if not already set)
+static void SetUniformColor(int location, float r, float g, float b, float a);  // Set current shader color uniform (if changed)
+static void SetUniformMapTexture(int location, int unit);   // Set current shader map texture uniform (if changed)
+
 //----------------------------------------------------------------------------------
 // Main Entry point
 //----------------------------------------------------------------------------------
@@ -366,6 +405,9 @@ int main(void)
         DrawModel(modelMap, position, 1.0f, WHITE);
         DrawModel(modelTower, (Vector3){ 3, 0, 3 }, 0.1f, WHITE);
         
+#if defined(GL_CAPTURE)
+        UpdateGlCapture();                  // Mark captured frame end (capture closed after last frame)
+#endif
         glfwSwapBuffers(window);            // Swap buffers: show back buffer into front
         PollInputEvents();                  // Register input events (keyboard, mouse)
         SyncFrame();                        // Wait required time to target framerate
@@ -480,6 +522,11 @@ static void InitGraphicsDevice(int width, int height)
     // Load OpenGL 3.3 supported extensions
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) TraceLog(LOG_WARNING, "GLAD: Cannot load OpenGL extensions");
     else TraceLog(LOG_INFO, "GLAD: OpenGL extensions loaded successfully");
+
+#if defined(GL_CAPTURE)
+    // Capture must start before any OpenGL resource is created
+    InitGlCapture("maze.gltrace", GL_CAPTURE_FRAMES);
+#endif
     
     // Print current OpenGL and GLSL version
     TraceLog(LOG_INFO, "GPU: Vendor:   %s", glGetString(GL_VENDOR));
@@ -489,20 +536,21 @@ static void InitGraphicsDevice(int width, int height)
 
     // Initialize OpenGL context (states and resources)
     //----------------------------------------------------------
+    ResetStateCache();                                      // Current GL state unknown
     
     // Init state: Depth test
     glDepthFunc(GL_LEQUAL);                                 // Type of depth testing to apply
-    glEnable(GL_DEPTH_TEST);                                // Enable depth testing for 3D
+    SetCapability(GL_DEPTH_TEST, true);                     // Enable depth testing for 3D
 
     // Init state: Blending mode
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);      // Color blending function (how colors are mixed)
-    glEnable(GL_BLEND);                                     // Enable color blending (required to work with transparencies)
+    SetCapability(GL_BLEND, true);                          // Enable color blending (required to work with transparencies)
 
     // Init state: Culling
     // NOTE: All shapes/models triangles are drawn CCW
     glCullFace(GL_BACK);                                    // Cull the back face (default)
     glFrontFace(GL_CCW);                                    // Front face are defined counter clockwise (default)
-    glEnable(GL_CULL_FACE);                                 // Enable backface culling
+    SetCapability(GL_CULL_FACE, true);                      // Enable backface culling
 
     // Init state: Color/Depth buffers clear
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);                   // Set clear color (black)
@@ -522,10 +570,16 @@ static void InitGraphicsDevice(int width, int height)
 // Close window and free resources
 static void CloseWindow(void)
 {
+    TraceLog(LOG_INFO, "GL state cache: %i redundant calls filtered", state.filteredCalls);
+
     // LESSON 03: Unload default shader
     glUseProgram(0);
     glDeleteProgram(shdrDefault.id);
 
+#if defined(GL_CAPTURE)
+    CloseGlCapture();               // Complete trace file (if closed before all frames captured)
+#endif
+
     glfwDestroyWindow(window);      // Close window
     glfwTerminate();                // Free GLFW3 resources
 }
@@ -912,6 +966,7 @@ static Texture2D LoadTexture(unsigned char *data, int width, int height, int for
     
     // Unbind current texture
     glBindTexture(GL_TEXTURE_2D, 0);
+    ResetStateCache();              // Texture binding changed out of cache
 
     if (texture.id > 0) TraceLog(LOG_INFO, "[TEX ID %i] Texture created successfully (%ix%i)", texture.id, width, height);
     else TraceLog(LOG_WARNING, "Texture could not be created");
@@ -923,12 +978,13 @@ static Texture2D LoadTexture(unsigned char *data, int width, int height, int for
 static void UnloadTexture(Texture2D texture)
 {
     if (texture.id > 0) glDeleteTextures(1, &texture.id);
+    ResetStateCache();              // Deleted texture could be bound (binding reverts to 0)
 }
 
 // Draw texture in screen position coordinates
 static void DrawTexture(Texture2D texture, Vector2 position, Color tint)
 {
-    glUseProgram(shdrDefault.id);
+    SetProgram(shdrDefault.id);
 
     // Define translation matrix to translate quad to screen center
     matModelview = MatrixTranslate(position.x, position.y, 0);
@@ -937,18 +993,16 @@ static void DrawTexture(Texture2D texture, Vector2 position, Color tint)
     Matrix matMVP = MatrixMultiply(matModelview, matProjection);
 
     glUniformMatrix4fv(shdrDefault.mvpLoc, 1, false, MatrixToFloat(matMVP));
-    glUniform4f(shdrDefault.colorLoc, 1.0f, 1.0f, 1.0f, 1.0f);
-    glUniform1i(shdrDefault.mapTextureLoc, 0);
+    SetUniformColor(shdrDefault.colorLoc, 1.0f, 1.0f, 1.0f, 1.0f);
+    SetUniformMapTexture(shdrDefault.mapTextureLoc, 0);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture.id);
-    glBindVertexArray(quadId);
+    SetTexture(texture.id);
+    SetVertexArray(quadId);
                 
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            
-    glBindTexture(GL_TEXTURE_2D, 0);    // Unbind textures
-    glBindVertexArray(0);               // Unbind VAO
-    glUseProgram(0);                    // Unbind shader program
+    
+    // NOTE: Shader program, texture and VAO are kept bound,
+    // next draw only changes the ones required (state cache)
 }
 
 // Load a quad to draw a texture
@@ -980,6 +1034,8 @@ static unsigned int LoadQuad(float width, float height)
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void *)0);
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void *)(3*sizeof(float)));
+    
+    state.vaoId = quadVAO;          // VAO left bound
 
     return quadVAO;
 }
@@ -1281,6 +1337,7 @@ static void UploadMeshData(Mesh *mesh)
     mesh->vboId[2] = vboId[2];     // Normals VBO
 
     mesh->vaoId = vaoId;
+    state.vaoId = vaoId;            // VAO left bound
     
     TraceLog(LOG_INFO, "[VAO ID %i] Mesh uploaded successfully to VRAM (GPU)", mesh->vaoId);
 }
@@ -1317,6 +1374,8 @@ static void UnloadModel(Model model)
     // Unload material texture
     // NOTE: Default shader is unloaded on CloseWindow()
     if (model.material.texDiffuse.id > 0) glDeleteTextures(1, &model.material.texDiffuse.id);
+    
+    ResetStateCache();              // Deleted VAO/texture could be bound (binding reverts to 0)
 }
 
 static void DrawModel(Model model, Vector3 position, float scale, Color tint)
@@ -1339,34 +1398,32 @@ static void DrawModel(Model model, Vector3 position, float scale, Color tint)
 
     model.material.colDiffuse = tint;           // Assign tint as diffuse color
 
-    glUseProgram(model.material.shader.id);     // Bind material shader
+    // NOTE: Shader program, textures, VAO and uniform values are only changed if required (state cache)
+    SetProgram(model.material.shader.id);       // Bind material shader
 
     // Upload to shader material.colDiffuse
-    glUniform4f(model.material.shader.colorLoc, 
-                (float)model.material.colDiffuse.r/255, 
-                (float)model.material.colDiffuse.g/255, 
-                (float)model.material.colDiffuse.b/255, 
-                (float)model.material.colDiffuse.a/255);
+    SetUniformColor(model.material.shader.colorLoc, 
+                    (float)model.material.colDiffuse.r/255, 
+                    (float)model.material.colDiffuse.g/255, 
+                    (float)model.material.colDiffuse.b/255, 
+                    (float)model.material.colDiffuse.a/255);
 
     // Set shader textures (diffuse, normal, specular)
-    // NOTE: Diffuse texture fits in active texture unit 0
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, model.material.texDiffuse.id);
-    glUniform1i(model.material.shader.mapTextureLoc, 0);
+    // NOTE: Diffuse texture fits in active texture unit 0 (only texture unit used)
+    SetTexture(model.material.texDiffuse.id);
+    SetUniformMapTexture(model.material.shader.mapTextureLoc, 0);
 
     // Bind mesh VAO (vertex array objects)
-    glBindVertexArray(model.mesh.vaoId);
+    SetVertexArray(model.mesh.vaoId);
     
     // Send combined model-view-matProjection matrix to shader
     glUniformMatrix4fv(model.material.shader.mvpLoc, 1, false, MatrixToFloat(matMVP));
 
     // Draw call!
     glDrawArrays(GL_TRIANGLES, 0, model.mesh.vertexCount);
-
-    glActiveTexture(GL_TEXTURE0);       // Set shader active texture to default 0
-    glBindTexture(GL_TEXTURE_2D, 0);    // Unbind textures
-    glBindVertexArray(0);               // Unbind VAO
-    glUseProgram(0);                    // Unbind shader program
+    
+    // NOTE: Shader program, texture and VAO are kept bound,
+    // next draw only changes the ones required (state cache)
 }
 
 // LESSON 05: Cubicmap generation, loading and drawing
@@ -1837,3 +1894,94 @@ static bool CheckCollisionCircleRec(Vector2 center, float radius, Rectangle rec)
     return (cornerDistanceSq <= (radius*radius));
 }
 
+// GL state cache: redundant state changes filtering
+//----------------------------------------------------------------------------------
+// Reset GL state cache, next state changes are always issued
+// NOTE: Required after any GL state change done without the cache (i.e. resources loading)
+static void ResetStateCache(void)
+{
+    state.program = 0xFFFFFFFF;
+    state.texture = 0xFFFFFFFF;
+    state.vaoId = 0xFFFFFFFF;
+    state.depthTest = -1;
+    state.blend = -1;
+    state.cullFace = -1;
+    
+    state.uniformsProgram = 0;
+    state.mapTexture = -1;
+}
+
+// Set current shader program (if not already set)
+static void SetProgram(unsigned int id)
+{
+    if (state.program == id) { state.filteredCalls++; return; }
+    
+    glUseProgram(id);
+    state.program = id;
+    
+    // Cached uniform values belong to previous program
+    if (state.uniformsProgram != id)
+    {
+        state.uniformsProgram = id;
+        state.color[0] = -1.0f;     // Not a valid color value, next color is always uploaded
+        state.mapTexture = -1;
+    }
+}
+
+// Bind texture to texture unit 0 (if not already bound)
+// NOTE: Texture unit 0 is the active texture unit by default (no glActiveTexture() required)
+static void SetTexture(unsigned int id)
+{
+    if (state.texture == id) { state.filteredCalls++; return; }
+    
+    glBindTexture(GL_TEXTURE_2D, id);
+    state.texture = id;
+}
+
+// Bind VAO (if not already bound)
+static void SetVertexArray(unsigned int id)
+{
+    if (state.vaoId == id) { state.filteredCalls++; return; }
+    
+    glBindVertexArray(id);
+    state.vaoId = id;
+}
+
+// Enable/disable GL capability (if not already set)
+// NOTE: Only GL_DEPTH_TEST, GL_BLEND and GL_CULL_FACE are tracked
+static void SetCapability(GLenum cap, bool enabled)
+{
+    int *current = NULL;
+    
+    if (cap == GL_DEPTH_TEST) current = &state.depthTest;
+    else if (cap == GL_BLEND) current = &state.blend;
+    else if (cap == GL_CULL_FACE) current = &state.cullFace;
+    
+    if ((current != NULL) && (*current == (int)enabled)) { state.filteredCalls++; return; }
+    
+    if (enabled) glEnable(cap);
+    else glDisable(cap);
+    
+    if (current != NULL) *current = (int)enabled;
+}
+
+// Set current shader color uniform (if changed)
+static void SetUniformColor(int location, float r, float g, float b, float a)
+{
+    if ((state.color[0] == r) && (state.color[1] == g) && (state.color[2] == b) && (state.color[3] == a)) { state.filteredCalls++; return; }
+    
+    glUniform4f(location, r, g, b, a);
+    state.color[0] = r;
+    state.color[1] = g;
+    state.color[2] = b;
+    state.color[3] = a;
+}
+
+// Set current shader map texture uniform (if changed)
+static void SetUniformMapTexture(int location, int unit)
+{
+    if (state.mapTexture == unit) { state.filteredCalls++; return; }
+    
+    glUniform1i(location, unit);
+    state.mapTexture = unit;
+}
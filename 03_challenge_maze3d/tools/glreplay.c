@@ -0,0 +1,239 @@
+/*******************************************************************************************
+*
+*   Challenge 03:   MAZE GAME
+*   Tool:           glreplay
+*   Description:    OpenGL trace replay for offline rendering benchmarks
+*
+*   Replays a trace captured with glcapture.h (maze: -DGL_CAPTURE, dungeon rlgl: -DRLGL_CAPTURE)
+*   against current OpenGL 3.3 driver, measuring time per frame and per OpenGL function.
+*   No game logic, inputs or assets loading involved: same calls and data on every run.
+*
+*   NOTE: Timings are measured on CPU side, a glFinish() is issued at every frame end to include
+*   GPU work on frame time. Use --sync to glFinish() after every call (per call GPU time, slower).
+*
+*   Usage:
+*       glreplay <trace.gltrace> [--sync] [--dump frame.ppm]
+*
+*   Software rendering (Mesa llvmpipe) on Linux:
+*       LIBGL_ALWAYS_SOFTWARE=1 ./glreplay maze.gltrace
+*
+*   Compile rglfw module using:
+*       gcc -c ../lessons/external/rglfw.c -Wall -std=c99 -DPLATFORM_DESKTOP -DGRAPHICS_API_OPENGL_33
+*
+*   Compile tool using:
+*       gcc -o glreplay.exe glreplay.c -I../lessons/external -I../lessons/external/glfw/include \
+*           rglfw.o -lopengl32 -lgdi32 -Wall -std=c99
+*
+*   Copyright (c) 2019 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#define GLAD_IMPLEMENTATION
+#include "glad.h"               // GLAD extensions loading library
+
+#define GLCAPTURE_IMPLEMENTATION
+#include "glcapture.h"          // OpenGL calls capture and replay
+
+#include <GLFW/glfw3.h>         // Windows/Context and inputs management
+
+#include <stdio.h>              // Required for: printf(), fopen(), fprintf(), fwrite()
+#include <stdlib.h>             // Required for: malloc(), calloc(), free(), qsort()
+#include <string.h>             // Required for: strcmp()
+#include <stdbool.h>            // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Replay timing per OpenGL function
+typedef struct CallStats {
+    int call;                   // Call id
+    int count;                  // Times called
+    double time;                // Total time (seconds)
+} CallStats;
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Declaration
+//----------------------------------------------------------------------------------
+static int CompareCallStats(const void *a, const void *b);  // Compare calls stats by total time (descending)
+static void DumpFrame(const char *fileName, int width, int height);  // Save default framebuffer to PPM file
+
+//----------------------------------------------------------------------------------
+// Main Entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const char *fileName = NULL;
+    const char *dumpFileName = NULL;
+    bool syncCalls = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--sync") == 0) syncCalls = true;
+        else if ((strcmp(argv[i], "--dump") == 0) && (i + 1 < argc)) dumpFileName = argv[++i];
+        else fileName = argv[i];
+    }
+
+    if (fileName == NULL)
+    {
+        printf("Usage: glreplay <trace.gltrace> [--sync] [--dump frame.ppm]\n");
+        return 1;
+    }
+
+    GlTrace trace = LoadGlTrace(fileName);
+    if (trace.data == NULL) return 1;
+
+    // Hidden window, just required for the OpenGL 3.3 context
+    if (!glfwInit()) return 1;
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    GLFWwindow *window = glfwCreateWindow(trace.width, trace.height, "GL TRACE REPLAY", NULL, NULL);
+
+    if (!window)
+    {
+        glfwTerminate();
+        UnloadGlTrace(trace);
+        return 1;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);        // No vsync, frames replayed as fast as possible
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) printf("WARNING: GLAD: Cannot load OpenGL extensions\n");
+
+    printf("INFO: GPU: Renderer: %s\n", glGetString(GL_RENDERER));
+    printf("INFO: GPU: Version:  %s\n", glGetString(GL_VERSION));
+
+    CallStats stats[GLCALL_COUNT] = { 0 };
+    for (int i = 0; i < GLCALL_COUNT; i++) stats[i].call = i;
+
+    double *frameTimes = (double *)calloc(trace.framesCount + 1, sizeof(double));
+    double frameStart = glfwGetTime();
+    //--------------------------------------------------------------------------------------
+
+    // Replay loop
+    while (!glfwWindowShouldClose(window))
+    {
+        double time = glfwGetTime();
+        int call = ReplayGlCall(&trace);
+
+        if (call < 0) break;
+        else if (call == GLCALL_FRAME)
+        {
+            // NOTE: GPU work is waited on frame end, included on frame time
+            glFinish();
+
+            double frameEnd = glfwGetTime();
+            stats[call].count++;
+            stats[call].time += frameEnd - time;
+            if (trace.frame <= trace.framesCount) frameTimes[trace.frame - 1] = frameEnd - frameStart;
+
+            if ((dumpFileName != NULL) && (trace.frame == trace.framesCount)) DumpFrame(dumpFileName, trace.width, trace.height);
+
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+            frameStart = glfwGetTime();
+        }
+        else
+        {
+            if (syncCalls) glFinish();
+
+            stats[call].count++;
+            stats[call].time += glfwGetTime() - time;
+        }
+    }
+
+    // Replay report
+    //--------------------------------------------------------------------------------------
+    int framesCount = (trace.frame < trace.framesCount)? trace.frame : trace.framesCount;
+
+    if (framesCount > 0)
+    {
+        printf("\nFrame 1 (resources loading): %.3f ms\n", frameTimes[0]*1000.0);
+
+        if (framesCount > 1)
+        {
+            double minTime = frameTimes[1], maxTime = frameTimes[1], totalTime = 0.0;
+
+            for (int i = 1; i < framesCount; i++)
+            {
+                if (frameTimes[i] < minTime) minTime = frameTimes[i];
+                if (frameTimes[i] > maxTime) maxTime = frameTimes[i];
+                totalTime += frameTimes[i];
+            }
+
+            printf("Frames 2-%i: min %.3f ms, avg %.3f ms, max %.3f ms\n", framesCount, minTime*1000.0, totalTime*1000.0/(framesCount - 1), maxTime*1000.0);
+        }
+    }
+
+    qsort(stats, GLCALL_COUNT, sizeof(CallStats), CompareCallStats);
+
+    printf("\n%-32s %10s %12s %12s\n", "Function", "Calls", "Total (ms)", "Avg (us)");
+
+    for (int i = 0; i < GLCALL_COUNT; i++)
+    {
+        if (stats[i].count == 0) continue;
+
+        printf("%-32s %10i %12.3f %12.3f\n", (stats[i].call == GLCALL_FRAME)? "Frame end (glFinish)" : GetGlCallName(stats[i].call),
+               stats[i].count, stats[i].time*1000.0, stats[i].time*1000000.0/stats[i].count);
+    }
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    free(frameTimes);
+    UnloadGlTrace(trace);
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition
+//----------------------------------------------------------------------------------
+
+// Compare calls stats by total time (descending)
+static int CompareCallStats(const void *a, const void *b)
+{
+    double timeA = ((const CallStats *)a)->time;
+    double timeB = ((const CallStats *)b)->time;
+
+    return (timeA < timeB) - (timeA > timeB);
+}
+
+// Save default framebuffer to PPM file
+static void DumpFrame(const char *fileName, int width, int height)
+{
+    unsigned char *pixels = (unsigned char *)malloc(width*height*4);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    FILE *file = fopen(fileName, "wb");
+
+    if (file != NULL)
+    {
+        fprintf(file, "P6\n%i %i\n255\n", width, height);
+
+        // NOTE: OpenGL framebuffer origin is bottom-left, rows are flipped
+        for (int y = height - 1; y >= 0; y--)
+        {
+            for (int x = 0; x < width; x++) fwrite(pixels + (y*width + x)*4, 1, 3, file);
+        }
+
+        fclose(file);
+        printf("INFO: [%s] Last frame saved\n", fileName);
+    }
+
+    free(pixels);
+}